@@ -32,6 +32,7 @@ SET(EMBREE_STAT_COUNTERS @EMBREE_STAT_COUNTERS@)
 SET(EMBREE_BACKFACE_CULLING @EMBREE_BACKFACE_CULLING@)
 SET(EMBREE_FILTER_FUNCTION @EMBREE_FILTER_FUNCTION@)
 SET(EMBREE_IGNORE_INVALID_RAYS @EMBREE_IGNORE_INVALID_RAYS@)
+SET(EMBREE_COMPRESSED_TRAVERSAL_STACK @EMBREE_COMPRESSED_TRAVERSAL_STACK@)
 SET(EMBREE_TASKING_SYSTEM @EMBREE_TASKING_SYSTEM@)
 SET(EMBREE_COMPACT_POLYS @EMBREE_COMPACT_POLYS@)
 
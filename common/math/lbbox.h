@@ -147,6 +147,44 @@ namespace embree
       bounds1 = b1;
     }
 
+    /*! calculates the linear bounds of a primitive for the specified time range, taking
+     *  geometry time range and non-uniform geometry time steps into account */
+    template<typename BoundsFunc>
+    __forceinline LBBox(const BoundsFunc& bounds, const BBox1f& time_range_in, const BBox1f& geom_time_range, const float* geom_time_steps, int geom_time_segments)
+    {
+      /* normalize global time_range_in to local geom_time_range */
+      const BBox1f time_range((time_range_in.lower-geom_time_range.lower)/geom_time_range.size(),
+                              (time_range_in.upper-geom_time_range.lower)/geom_time_range.size());
+
+      /* bounds at some local time, the geometry does not move outside its time range */
+      auto boundsAt = [&] (float t) -> BBox<T>
+      {
+        if (t <= 0.0f) return bounds(0);
+        if (t >= 1.0f) return bounds(geom_time_segments);
+        int i = 0; while (i < geom_time_segments-1 && geom_time_steps[i+1] <= t) i++;
+        return lerp(bounds(i), bounds(i+1), (t-geom_time_steps[i])/(geom_time_steps[i+1]-geom_time_steps[i]));
+      };
+
+      BBox<T> b0 = boundsAt(time_range.lower);
+      BBox<T> b1 = boundsAt(time_range.upper);
+
+      /* enlarge bounds to contain the time steps inside the time range */
+      for (int i = 0; i <= geom_time_segments; i++)
+      {
+        if (geom_time_steps[i] <= time_range.lower || geom_time_steps[i] >= time_range.upper) continue;
+        const float f = (geom_time_steps[i] - time_range.lower) / time_range.size();
+        const BBox<T> bt = lerp(b0, b1, f);
+        const BBox<T> bi = bounds(i);
+        const T dlower = min(bi.lower-bt.lower, T(zero));
+        const T dupper = max(bi.upper-bt.upper, T(zero));
+        b0.lower += dlower; b1.lower += dlower;
+        b0.upper += dupper; b1.upper += dupper;
+      }
+
+      bounds0 = b0;
+      bounds1 = b1;
+    }
+
     /*! calculates the linear bounds of a primitive for the specified time range */
     template<typename BoundsFunc>
     __forceinline LBBox(const BoundsFunc& bounds, const range<int>& time_range, int numTimeSegments)
@@ -162,6 +162,41 @@ namespace embree
   void os_advise(void *ptr, size_t bytes)
   {
   }
+
+  void* os_malloc_file(size_t bytes, const char* dir)
+  {
+    if (bytes == 0)
+      return nullptr;
+
+    char fileName[MAX_PATH];
+    if (GetTempFileNameA(dir,"emb",0,fileName) == 0)
+      throw std::bad_alloc();
+
+    /* the file gets deleted by the OS once the mapping is released */
+    HANDLE file = CreateFileA(fileName,GENERIC_READ|GENERIC_WRITE,0,nullptr,CREATE_ALWAYS,FILE_ATTRIBUTE_TEMPORARY|FILE_FLAG_DELETE_ON_CLOSE,nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+      throw std::bad_alloc();
+
+    HANDLE mapping = CreateFileMappingA(file,nullptr,PAGE_READWRITE,DWORD(uint64_t(bytes) >> 32),DWORD(bytes),nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr)
+      throw std::bad_alloc();
+
+    void* ptr = MapViewOfFile(mapping,FILE_MAP_ALL_ACCESS,0,0,bytes);
+    CloseHandle(mapping);
+    if (ptr == nullptr)
+      throw std::bad_alloc();
+    return ptr;
+  }
+
+  void os_free_file(void* ptr, size_t bytes)
+  {
+    if (bytes == 0)
+      return;
+
+    if (!UnmapViewOfFile(ptr))
+      throw std::bad_alloc();
+  }
 }
 
 #endif
@@ -173,6 +208,7 @@ namespace embree
 #if defined(__UNIX__)
 
 #include <sys/mman.h>
+#include <unistd.h>
 #include <errno.h>
 #include <stdlib.h>
 #include <string.h>
@@ -301,6 +337,37 @@ namespace embree
     madvise(pptr,bytes,MADV_HUGEPAGE); 
 #endif
   }
+
+  void* os_malloc_file(size_t bytes, const char* dir)
+  {
+    if (bytes == 0)
+      return nullptr;
+
+    std::string fileName = std::string(dir) + "/embree_XXXXXX";
+    int fd = mkstemp(&fileName[0]);
+    if (fd == -1) throw std::bad_alloc();
+
+    /* the file gets deleted by the OS once the mapping is released */
+    unlink(fileName.c_str());
+    if (ftruncate(fd,bytes) == -1) {
+      close(fd);
+      throw std::bad_alloc();
+    }
+
+    void* ptr = mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED) throw std::bad_alloc();
+    return ptr;
+  }
+
+  void os_free_file(void* ptr, size_t bytes)
+  {
+    if (bytes == 0)
+      return;
+
+    if (munmap(ptr,bytes) == -1)
+      throw std::bad_alloc();
+  }
 }
 
 #endif
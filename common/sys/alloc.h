@@ -61,6 +61,10 @@ namespace embree
   void  os_free   (void* ptr, size_t bytes, bool hugepages);
   void  os_advise (void* ptr, size_t bytes);
 
+  /*! allocates pages backed by a temporary file in the specified directory */
+  void* os_malloc_file (size_t bytes, const char* dir);
+  void  os_free_file   (void* ptr, size_t bytes);
+
   /*! allocator that performs OS allocations */
   template<typename T>
     struct os_allocator
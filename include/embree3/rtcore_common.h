@@ -47,6 +47,9 @@ typedef int ssize_t;
 /* Maximum number of time steps */
 #define RTC_MAX_TIME_STEP_COUNT 129
 
+/* Maximum number of hits gathered by multi-hit queries */
+#define RTC_MAX_HIT_COUNT 16
+
 /* Formats of buffers and other data structures */
 enum RTCFormat
 {
@@ -189,11 +192,23 @@ struct RTCFilterFunctionNArguments
 /* Filter callback function */
 typedef void (*RTCFilterFunctionN)(const struct RTCFilterFunctionNArguments* args);
 
+/* Traversal statistics gathered by intersect/occluded calls */
+struct RTCTraversalStatistics
+{
+  unsigned int nodeCount;      // number of traversed inner nodes
+  unsigned int leafCount;      // number of traversed leaf nodes
+  unsigned int primitiveCount; // number of intersected primitive blocks
+  unsigned int instanceCount;  // number of entered instances
+  unsigned int filterCount;    // number of invoked filter functions
+};
+
 /* Intersection context passed to intersect/occluded calls */
 struct RTCIntersectContext
 {
   enum RTCIntersectContextFlags flags;               // intersection flags
   RTCFilterFunctionN filter;                         // filter function to execute
+  struct RTCTraversalStatistics* stats;              // traversal statistics to gather, NULL to disable
+  const float* orgLow;                               // low-order part of the world space ray origin, NULL to disable
   
 #if RTC_MAX_INSTANCE_LEVEL_COUNT > 1
   unsigned int instStackSize;                        // Number of instances currently on the stack.
@@ -211,6 +226,8 @@ RTC_FORCEINLINE void rtcInitIntersectContext(struct RTCIntersectContext* context
   unsigned l = 0;
   context->flags = RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT;
   context->filter = NULL;
+  context->stats = NULL;
+  context->orgLow = NULL;
   
 #if RTC_MAX_INSTANCE_LEVEL_COUNT > 1
   context->instStackSize = 0;
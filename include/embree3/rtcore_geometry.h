@@ -48,7 +48,8 @@ enum RTCGeometryType
   RTC_GEOMETRY_TYPE_NORMAL_ORIENTED_CATMULL_ROM_CURVE  = 60, // flat normal-oriented Catmull-Rom curves
 
   RTC_GEOMETRY_TYPE_USER     = 120, // user-defined geometry
-  RTC_GEOMETRY_TYPE_INSTANCE = 121  // scene instance
+  RTC_GEOMETRY_TYPE_INSTANCE = 121, // scene instance
+  RTC_GEOMETRY_TYPE_LAZY     = 122  // lazily created scene instance
 };
 
 /* Interpolation modes for subdivision surfaces */
@@ -110,6 +111,27 @@ struct RTCOccludedFunctionNArguments
 /* Occlusion callback function */
 typedef void (*RTCOccludedFunctionN)(const struct RTCOccludedFunctionNArguments* args);
 
+/* Arguments for RTCLazyCreateFunction */
+struct RTCLazyCreateFunctionArguments
+{
+  void* geometryUserPtr;
+  RTCGeometry geometry;
+  RTCScene scene;
+};
+
+/* Lazy create callback function */
+typedef void (*RTCLazyCreateFunction)(const struct RTCLazyCreateFunctionArguments* args);
+
+/* Arguments for RTCLazyEvictFunction */
+struct RTCLazyEvictFunctionArguments
+{
+  void* geometryUserPtr;
+  RTCGeometry geometry;
+};
+
+/* Lazy evict callback function */
+typedef void (*RTCLazyEvictFunction)(const struct RTCLazyEvictFunctionArguments* args);
+
 /* Arguments for RTCDisplacementFunctionN */
 struct RTCDisplacementFunctionNArguments
 {
@@ -156,6 +178,9 @@ RTC_API void rtcSetGeometryTimeStepCount(RTCGeometry geometry, unsigned int time
 
 /* Sets the motion blur time range of the geometry. */
 RTC_API void rtcSetGeometryTimeRange(RTCGeometry geometry, float startTime, float endTime);
+
+/* Sets non-uniform times of the time steps of the geometry relative to the time range. */
+RTC_API void rtcSetGeometryTimeSteps(RTCGeometry geometry, const float* times, unsigned int timeStepCount);
   
 /* Sets the number of vertex attributes of the geometry. */
 RTC_API void rtcSetGeometryVertexAttributeCount(RTCGeometry geometry, unsigned int vertexAttributeCount);
@@ -163,6 +188,9 @@ RTC_API void rtcSetGeometryVertexAttributeCount(RTCGeometry geometry, unsigned i
 /* Sets the ray mask of the geometry. */
 RTC_API void rtcSetGeometryMask(RTCGeometry geometry, unsigned int mask);
 
+/* Sets the bounds that 16 bit quantized vertex positions of the geometry are relative to. */
+RTC_API void rtcSetGeometryVertexQuantizationBounds(RTCGeometry geometry, const struct RTCBounds* bounds);
+
 /* Sets the build quality of the geometry. */
 RTC_API void rtcSetGeometryBuildQuality(RTCGeometry geometry, enum RTCBuildQuality quality);
 
@@ -220,6 +248,12 @@ RTC_API void rtcFilterIntersection(const struct RTCIntersectFunctionNArguments*
 RTC_API void rtcFilterOcclusion(const struct RTCOccludedFunctionNArguments* args, const struct RTCFilterFunctionNArguments* filterArgs);
 
 
+/* Sets the create callback function of a lazy geometry. */
+RTC_API void rtcSetGeometryLazyCreateFunction(RTCGeometry geometry, RTCLazyCreateFunction create);
+
+/* Sets the evict callback function of a lazy geometry. */
+RTC_API void rtcSetGeometryLazyEvictFunction(RTCGeometry geometry, RTCLazyEvictFunction evict);
+
 /* Sets the instanced scene of an instance geometry. */
 RTC_API void rtcSetGeometryInstancedScene(RTCGeometry geometry, RTCScene scene);
 
@@ -229,6 +263,9 @@ RTC_API void rtcSetGeometryTransform(RTCGeometry geometry, unsigned int timeStep
 /* Sets the transformation quaternion of an instance for the specified time step. */
 RTC_API void rtcSetGeometryTransformQuaternion(RTCGeometry geometry, unsigned int timeStep, const struct RTCQuaternionDecomposition* qd);
 
+/* Sets a double precision offset that is added to the transformation of an instance. */
+RTC_API void rtcSetGeometryTransformOffset(RTCGeometry geometry, const double* offset);
+
 /* Returns the interpolated transformation of an instance for the specified time. */
 RTC_API void rtcGetGeometryTransform(RTCGeometry geometry, float time, enum RTCFormat format, void* xfm);
 
@@ -370,6 +407,30 @@ struct RTCInterpolateNArguments
 /* Interpolates vertex data to an array of u/v locations. */
 RTC_API void rtcInterpolateN(const struct RTCInterpolateNArguments* args);
 
+/* Arguments for rtcInterpolateBatch */
+struct RTCInterpolateBatchArguments
+{
+  RTCScene scene;
+  const void* valid;
+  const unsigned int* geomIDs;
+  const unsigned int* primIDs;
+  const float* u;
+  const float* v;
+  unsigned int N;
+  enum RTCBufferType bufferType;
+  unsigned int bufferSlot;
+  float* P;
+  float* dPdu;
+  float* dPdv;
+  float* ddPdudu;
+  float* ddPdvdv;
+  float* ddPdudv;
+  unsigned int valueCount;
+};
+
+/* Interpolates vertex data of different geometries of a scene to an array of u/v locations. */
+RTC_API void rtcInterpolateBatch(const struct RTCInterpolateBatchArguments* args);
+
 /* RTCGrid primitive for grid mesh */
 struct RTCGrid
 {
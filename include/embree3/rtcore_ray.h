@@ -48,6 +48,25 @@ struct RTCRayHit
   struct RTCHit hit;
 };
 
+/* Multi-hit query modes */
+enum RTCMultiHitMode
+{
+  RTC_MULTI_HIT_MODE_CLOSEST = 0, // gathers the closest maxHitCount hits
+  RTC_MULTI_HIT_MODE_ALL     = 1  // gathers all hits inside [tnear,tfar]
+};
+
+/* Combined ray/multi-hit structure for a single ray */
+struct RTCRayMultiHit
+{
+  struct RTCRay ray;
+  enum RTCMultiHitMode mode;   // multi-hit query mode
+  unsigned int maxHitCount;    // maximal number of hits to store (at most RTC_MAX_HIT_COUNT)
+  unsigned int hitCount;       // number of stored hits
+  unsigned int totalHitCount;  // number of hits found during traversal
+  float t[RTC_MAX_HIT_COUNT];  // hit distances sorted front to back
+  struct RTCHit hits[RTC_MAX_HIT_COUNT]; // hits sorted front to back
+};
+
 /* Ray structure for a packet of 4 rays */
 struct RTC_ALIGN(16) RTCRay4
 {
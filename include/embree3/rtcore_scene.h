@@ -47,6 +47,9 @@ RTC_API void rtcAttachGeometryByID(RTCScene scene, RTCGeometry geometry, unsigne
 /* Detaches the geometry from the scene. */
 RTC_API void rtcDetachGeometry(RTCScene scene, unsigned int geomID);
 
+/* Generates the build primitives of an attached geometry ahead of the scene commit. */
+RTC_API void rtcPrepareSceneGeometry(RTCScene scene, unsigned int geomID);
+
 /* Gets a geometry handle from the scene. */
 RTC_API RTCGeometry rtcGetGeometry(RTCScene scene, unsigned int geomID);
 
@@ -95,6 +98,9 @@ RTC_API bool rtcPointQuery16(const int* valid, RTCScene scene, struct RTCPointQu
 /* Intersects a single ray with the scene. */
 RTC_API void rtcIntersect1(RTCScene scene, struct RTCIntersectContext* context, struct RTCRayHit* rayhit);
 
+/* Gathers multiple hits of a single ray with the scene. */
+RTC_API void rtcIntersectMultiHit1(RTCScene scene, struct RTCIntersectContext* context, struct RTCRayMultiHit* rayhit);
+
 /* Intersects a packet of 4 rays with the scene. */
 RTC_API void rtcIntersect4(const int* valid, RTCScene scene, struct RTCIntersectContext* context, struct RTCRayHit4* rayhit);
 
@@ -289,8 +289,10 @@ namespace embree
               for (size_t i=0; i<numChildren; i++)
                 children[i].alloc_barrier = children[i].size() <= cfg.primrefarrayalloc;
 
-            /* sort buildrecords for faster shadow ray traversal */
-            std::sort(&children[0],&children[numChildren],std::greater<BuildRecord>());
+            /* store children with larger surface area first, as shadow rays visit them first */
+            std::sort(&children[0],&children[numChildren],[] (const BuildRecord& a, const BuildRecord& b) {
+                return halfArea(a.prims.geomBounds) > halfArea(b.prims.geomBounds);
+              });
 
             /*! create an inner node */
             auto node = createNode(children,numChildren,alloc);
@@ -122,8 +122,13 @@ namespace embree
 
         void deterministic_order(const PrimInfoRange& pinfo)
         {
-          /* required as parallel partition destroys original primitive order */
-          std::sort(&prims[pinfo.begin()],&prims[pinfo.end()]);
+          /* required as parallel partition destroys original primitive order,
+             larger primitives go first as they more likely occlude shadow rays */
+          std::sort(&prims[pinfo.begin()],&prims[pinfo.end()],[] (const PrimRef& a, const PrimRef& b) {
+              const float areaA = halfArea(a.bounds());
+              const float areaB = halfArea(b.bounds());
+              return areaA > areaB || (areaA == areaB && a < b);
+            });
         }
 
         void splitFallback(const PrimInfoRange& pinfo, PrimInfoRange& linfo, PrimInfoRange& rinfo)
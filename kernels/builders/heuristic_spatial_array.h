@@ -509,8 +509,13 @@ namespace embree
 
         void deterministic_order(const PrimInfoExtRange& set) 
         {
-          /* required as parallel partition destroys original primitive order */
-          std::sort(&prims0[set.begin()],&prims0[set.end()]);
+          /* required as parallel partition destroys original primitive order,
+             larger primitives go first as they more likely occlude shadow rays */
+          std::sort(&prims0[set.begin()],&prims0[set.end()],[] (const PrimRef& a, const PrimRef& b) {
+              const float areaA = halfArea(a.bounds());
+              const float areaB = halfArea(b.bounds());
+              return areaA > areaB || (areaA == areaB && a < b);
+            });
         }
 
         void splitFallback(const PrimInfoExtRange& set, 
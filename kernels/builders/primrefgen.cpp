@@ -32,8 +32,49 @@ namespace embree
       return pinfo;
     }
 
+    /* copies build primitives that got already generated by rtcPrepareSceneGeometry, fails if some geometry is not prepared */
+    static bool copyPreparedPrimRefArray(Scene* scene, Geometry::GTypeMask types, mvector<PrimRef>& prims, PrimInfo& pinfo_o)
+    {
+      Scene::Iterator2 iter(scene,types,false);
+
+      std::vector<const mvector<PrimRef>*> prepared(iter.size(),nullptr);
+      std::vector<size_t> offsets(iter.size(),0);
+      std::vector<size_t> counts(iter.size(),0);
+      PrimInfo pinfo(empty);
+      for (size_t i=0; i<iter.size(); i++)
+      {
+        if (iter[i] == nullptr) continue;
+        PrimInfo ginfo(empty);
+        prepared[i] = scene->getPreparedPrimRefs(i,ginfo);
+        if (prepared[i] == nullptr) return false;
+        offsets[i] = pinfo.size();
+        counts[i] = ginfo.size();
+        pinfo.merge(ginfo);
+      }
+      
+      if (pinfo.size() > prims.size()) return false;
+      
+      parallel_for(iter.size(), [&](const size_t i) {
+          if (prepared[i] == nullptr) return;
+          parallel_for(size_t(0), counts[i], size_t(4096), [&](const range<size_t>& r) {
+              for (size_t j=r.begin(); j<r.end(); j++)
+                prims[offsets[i]+j] = (*prepared[i])[j];
+            });
+        });
+      
+      pinfo_o = pinfo;
+      return true;
+    }
+
     PrimInfo createPrimRefArray(Scene* scene, Geometry::GTypeMask types, bool mblur, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor)
     {
+      /* build primitives of streamed geometries got already generated before the commit */
+      PrimInfo prepared_pinfo(empty);
+      if (!mblur && scene->hasPreparedPrimRefs() && copyPreparedPrimRefArray(scene,types,prims,prepared_pinfo)) {
+        progressMonitor(0);
+        return prepared_pinfo;
+      }
+      
       ParallelForForPrefixSumState<PrimInfo> pstate;
       Scene::Iterator2 iter(scene,types,mblur);
       
@@ -238,6 +279,7 @@ namespace embree
 
     IF_ENABLED_TRIS (template size_t createMortonCodeArray<TriangleMesh>(TriangleMesh* mesh COMMA mvector<BVHBuilderMorton::BuildPrim>& morton COMMA BuildProgressMonitor& progressMonitor));
     IF_ENABLED_QUADS(template size_t createMortonCodeArray<QuadMesh>(QuadMesh* mesh COMMA mvector<BVHBuilderMorton::BuildPrim>& morton COMMA BuildProgressMonitor& progressMonitor));
+    IF_ENABLED_POINTS (template size_t createMortonCodeArray<Points>(Points* mesh COMMA mvector<BVHBuilderMorton::BuildPrim>& morton COMMA BuildProgressMonitor& progressMonitor));
     IF_ENABLED_USER (template size_t createMortonCodeArray<UserGeometry>(UserGeometry* mesh COMMA mvector<BVHBuilderMorton::BuildPrim>& morton COMMA BuildProgressMonitor& progressMonitor));
     IF_ENABLED_INSTANCE (template size_t createMortonCodeArray<Instance>(Instance* mesh COMMA mvector<BVHBuilderMorton::BuildPrim>& morton COMMA BuildProgressMonitor& progressMonitor));
   }
@@ -14,17 +14,23 @@ namespace embree
     BVH4Factory(int bfeatures, int ifeatures);
 
   public:
-    Accel* BVH4OBBVirtualCurve4i(Scene* scene, IntersectVariant ivariant);
-    Accel* BVH4OBBVirtualCurve4v(Scene* scene, IntersectVariant ivariant);
-    Accel* BVH4OBBVirtualCurve8i(Scene* scene, IntersectVariant ivariant);
+    Accel* BVH4OBBVirtualCurve4i(Scene* scene, Geometry::GTypeMask gtype, IntersectVariant ivariant);
+    Accel* BVH4OBBVirtualCurve4v(Scene* scene, Geometry::GTypeMask gtype, IntersectVariant ivariant);
+    Accel* BVH4OBBVirtualCurve4c(Scene* scene, Geometry::GTypeMask gtype, IntersectVariant ivariant);
+    Accel* BVH4OBBVirtualCurve8i(Scene* scene, Geometry::GTypeMask gtype, IntersectVariant ivariant);
+    Accel* BVH4Point4v(Scene* scene, IntersectVariant ivariant);
+    Accel* BVH4Point8v(Scene* scene, IntersectVariant ivariant);
     Accel* BVH4OBBVirtualCurve4iMB(Scene* scene, IntersectVariant ivariant);
     Accel* BVH4OBBVirtualCurve8iMB(Scene* scene, IntersectVariant ivariant);
     DEFINE_SYMBOL2(VirtualCurveIntersector*,VirtualCurveIntersector4i);
     DEFINE_SYMBOL2(VirtualCurveIntersector*,VirtualCurveIntersector8i);
     DEFINE_SYMBOL2(VirtualCurveIntersector*,VirtualCurveIntersector4v);
     DEFINE_SYMBOL2(VirtualCurveIntersector*,VirtualCurveIntersector8v);
+    DEFINE_SYMBOL2(VirtualCurveIntersector*,VirtualCurveIntersector4c);
     DEFINE_SYMBOL2(VirtualCurveIntersector*,VirtualCurveIntersector4iMB);
     DEFINE_SYMBOL2(VirtualCurveIntersector*,VirtualCurveIntersector8iMB);
+    DEFINE_SYMBOL2(VirtualCurveIntersector*,VirtualPointIntersector4v);
+    DEFINE_SYMBOL2(VirtualCurveIntersector*,VirtualPointIntersector8v);
         
     Accel* BVH4Triangle4   (Scene* scene, BuildVariant bvariant = BuildVariant::STATIC, IntersectVariant ivariant = IntersectVariant::FAST);
     Accel* BVH4Triangle4v  (Scene* scene, BuildVariant bvariant = BuildVariant::STATIC, IntersectVariant ivariant = IntersectVariant::ROBUST);
@@ -126,6 +132,7 @@ namespace embree
     DEFINE_SYMBOL2(Accel::Intersector1,BVH4GridIntersector1Moeller);
     DEFINE_SYMBOL2(Accel::Intersector1,BVH4GridMBIntersector1Moeller);
     DEFINE_SYMBOL2(Accel::Intersector1,BVH4GridIntersector1Pluecker);
+    DEFINE_SYMBOL2(Accel::Intersector1,BVH4GridMBIntersector1Pluecker);
 
     DEFINE_SYMBOL2(Accel::Intersector4,BVH4OBBVirtualCurveIntersector4Hybrid);
     DEFINE_SYMBOL2(Accel::Intersector4,BVH4OBBVirtualCurveIntersector4HybridMB);
@@ -164,6 +171,7 @@ namespace embree
     DEFINE_SYMBOL2(Accel::Intersector4,BVH4GridIntersector4HybridMoeller);
     DEFINE_SYMBOL2(Accel::Intersector4,BVH4GridMBIntersector4HybridMoeller);
     DEFINE_SYMBOL2(Accel::Intersector4,BVH4GridIntersector4HybridPluecker);
+    DEFINE_SYMBOL2(Accel::Intersector4,BVH4GridMBIntersector4HybridPluecker);
 
     // ==============
 
@@ -204,6 +212,7 @@ namespace embree
     DEFINE_SYMBOL2(Accel::Intersector8,BVH4GridIntersector8HybridMoeller);
     DEFINE_SYMBOL2(Accel::Intersector8,BVH4GridMBIntersector8HybridMoeller);
     DEFINE_SYMBOL2(Accel::Intersector8,BVH4GridIntersector8HybridPluecker);
+    DEFINE_SYMBOL2(Accel::Intersector8,BVH4GridMBIntersector8HybridPluecker);
 
     // ==============
 
@@ -244,6 +253,7 @@ namespace embree
     DEFINE_SYMBOL2(Accel::Intersector16,BVH4GridIntersector16HybridMoeller);
     DEFINE_SYMBOL2(Accel::Intersector16,BVH4GridMBIntersector16HybridMoeller);
     DEFINE_SYMBOL2(Accel::Intersector16,BVH4GridIntersector16HybridPluecker);
+    DEFINE_SYMBOL2(Accel::Intersector16,BVH4GridMBIntersector16HybridPluecker);
 
     // ==============
 
@@ -267,10 +277,11 @@ namespace embree
        
     // SAH scene builders
   private:
-    DEFINE_ISA_FUNCTION(Builder*,BVH4Curve4vBuilder_OBB_New,void* COMMA Scene* COMMA size_t);
-    DEFINE_ISA_FUNCTION(Builder*,BVH4Curve4iBuilder_OBB_New,void* COMMA Scene* COMMA size_t);
+    DEFINE_ISA_FUNCTION(Builder*,BVH4Curve4vBuilder_OBB_New,void* COMMA Scene* COMMA Geometry::GTypeMask);
+    DEFINE_ISA_FUNCTION(Builder*,BVH4Curve4iBuilder_OBB_New,void* COMMA Scene* COMMA Geometry::GTypeMask);
+    DEFINE_ISA_FUNCTION(Builder*,BVH4Curve4cBuilder_OBB_New,void* COMMA Scene* COMMA Geometry::GTypeMask);
     DEFINE_ISA_FUNCTION(Builder*,BVH4OBBCurve4iMBBuilder_OBB,void* COMMA Scene* COMMA size_t);
-    DEFINE_ISA_FUNCTION(Builder*,BVH4Curve8iBuilder_OBB_New,void* COMMA Scene* COMMA size_t);
+    DEFINE_ISA_FUNCTION(Builder*,BVH4Curve8iBuilder_OBB_New,void* COMMA Scene* COMMA Geometry::GTypeMask);
     DEFINE_ISA_FUNCTION(Builder*,BVH4OBBCurve8iMBBuilder_OBB,void* COMMA Scene* COMMA size_t);
 
     DEFINE_ISA_FUNCTION(Builder*,BVH4Triangle4SceneBuilderSAH,void* COMMA Scene* COMMA size_t);
@@ -312,5 +323,7 @@ namespace embree
     DEFINE_ISA_FUNCTION(Builder*,BVH4BuilderTwoLevelQuadMeshSAH,void* COMMA Scene* COMMA bool);
     DEFINE_ISA_FUNCTION(Builder*,BVH4BuilderTwoLevelVirtualSAH,void* COMMA Scene* COMMA bool);
     DEFINE_ISA_FUNCTION(Builder*,BVH4BuilderTwoLevelInstanceSAH,void* COMMA Scene* COMMA Geometry::GTypeMask COMMA bool);
+    DEFINE_ISA_FUNCTION(Builder*,BVH4BuilderTwoLevelPoint4vMorton,void* COMMA Scene*);
+    DEFINE_ISA_FUNCTION(Builder*,BVH4BuilderTwoLevelPoint8vMorton,void* COMMA Scene*);
   };
 }
@@ -69,6 +69,7 @@ namespace embree
   DECLARE_SYMBOL2(Accel::Intersector1,BVH8GridIntersector1Moeller);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH8GridMBIntersector1Moeller);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH8GridIntersector1Pluecker);
+  DECLARE_SYMBOL2(Accel::Intersector1,BVH8GridMBIntersector1Pluecker);
 
   DECLARE_SYMBOL2(Accel::Intersector4,BVH8OBBVirtualCurveIntersector4Hybrid);
   DECLARE_SYMBOL2(Accel::Intersector4,BVH8OBBVirtualCurveIntersector4HybridMB);
@@ -190,7 +191,7 @@ namespace embree
 
   DECLARE_SYMBOL2(Accel::IntersectorN,BVH8InstanceIntersectorStream);
 
-  DECLARE_ISA_FUNCTION(Builder*,BVH8Curve8vBuilder_OBB_New,void* COMMA Scene* COMMA size_t);
+  DECLARE_ISA_FUNCTION(Builder*,BVH8Curve8vBuilder_OBB_New,void* COMMA Scene* COMMA Geometry::GTypeMask);
   DECLARE_ISA_FUNCTION(Builder*,BVH8OBBCurve8iMBBuilder_OBB,void* COMMA Scene* COMMA size_t);
 
   DECLARE_ISA_FUNCTION(Builder*,BVH8Triangle4SceneBuilderSAH,void* COMMA Scene* COMMA size_t);
@@ -316,6 +317,7 @@ namespace embree
     IF_ENABLED_GRIDS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512SKX(features,BVH8GridIntersector1Moeller));
     IF_ENABLED_GRIDS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512SKX(features,BVH8GridMBIntersector1Moeller))
     IF_ENABLED_GRIDS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512SKX(features,BVH8GridIntersector1Pluecker));
+    IF_ENABLED_GRIDS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512SKX(features,BVH8GridMBIntersector1Pluecker));
 
 #if defined (EMBREE_RAY_PACKETS)
 
@@ -842,11 +844,11 @@ namespace embree
     return intersectors;
   }
 
-  Accel* BVH8Factory::BVH8OBBVirtualCurve8v(Scene* scene, IntersectVariant ivariant)
+  Accel* BVH8Factory::BVH8OBBVirtualCurve8v(Scene* scene, Geometry::GTypeMask gtype, IntersectVariant ivariant)
   {
     BVH8* accel = new BVH8(Curve8v::type,scene);
     Accel::Intersectors intersectors = BVH8OBBVirtualCurveIntersectors(accel,VirtualCurveIntersector8v(),ivariant);
-    Builder* builder = BVH8Curve8vBuilder_OBB_New(accel,scene,0);
+    Builder* builder = BVH8Curve8vBuilder_OBB_New(accel,scene,gtype);
     return new AccelInstance(accel,builder,intersectors);
   }
 
@@ -1126,7 +1128,10 @@ namespace embree
   {
     Accel::Intersectors intersectors;
     intersectors.ptr = bvh;
-    intersectors.intersector1  = BVH8GridMBIntersector1Moeller();
+    if (ivariant == IntersectVariant::FAST)
+      intersectors.intersector1  = BVH8GridMBIntersector1Moeller();
+    else /* if (ivariant == IntersectVariant::ROBUST) */
+      intersectors.intersector1  = BVH8GridMBIntersector1Pluecker();
 #if defined (EMBREE_RAY_PACKETS)
     intersectors.intersector4  = nullptr;
     intersectors.intersector8  = nullptr;
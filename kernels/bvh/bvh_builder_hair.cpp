@@ -8,6 +8,7 @@
 #include "../geometry/linei.h"
 #include "../geometry/curveNi.h"
 #include "../geometry/curveNv.h"
+#include "../geometry/curveNc.h"
 
 #if defined(EMBREE_GEOMETRY_CURVE) || defined(EMBREE_GEOMETRY_POINT)
 
@@ -25,9 +26,10 @@ namespace embree
       Scene* scene;
       mvector<PrimRef> prims;
       BVHBuilderHair::Settings settings;
+      Geometry::GTypeMask gtype;
 
-      BVHNHairBuilderSAH (BVH* bvh, Scene* scene)
-        : bvh(bvh), scene(scene), prims(scene->device,0) {}
+      BVHNHairBuilderSAH (BVH* bvh, Scene* scene, Geometry::GTypeMask gtype)
+        : bvh(bvh), scene(scene), prims(scene->device,0), gtype(gtype) {}
       
       void build() 
       {
@@ -36,7 +38,7 @@ namespace embree
           bvh->alloc.unshare(prims);
 
         /* fast path for empty BVH */
-        const size_t numPrimitives = scene->getNumPrimitives(Geometry::MTY_CURVES,false);
+        const size_t numPrimitives = scene->getNumPrimitives(gtype,false);
         if (numPrimitives == 0) {
           bvh->clear();
           prims.clear();
@@ -47,7 +49,7 @@ namespace embree
 
         /* create primref array */
         prims.resize(numPrimitives);
-        const PrimInfo pinfo = createPrimRefArray(scene,Geometry::MTY_CURVES,false,prims,scene->progressInterface);
+        const PrimInfo pinfo = createPrimRefArray(scene,gtype,false,prims,scene->progressInterface);
 
         /* estimate acceleration structure size */
         const size_t node_bytes = pinfo.size()*sizeof(typename BVH::OBBNode)/(4*N);
@@ -118,12 +120,13 @@ namespace embree
     };
     
     /*! entry functions for the builder */
-    Builder* BVH4Curve4vBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<4,Curve4v,Line4i,Point4i>((BVH4*)bvh,scene); }
-    Builder* BVH4Curve4iBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<4,Curve4i,Line4i,Point4i>((BVH4*)bvh,scene); }
+    Builder* BVH4Curve4vBuilder_OBB_New   (void* bvh, Scene* scene, Geometry::GTypeMask gtype) { return new BVHNHairBuilderSAH<4,Curve4v,Line4i,Point4i>((BVH4*)bvh,scene,gtype); }
+    Builder* BVH4Curve4iBuilder_OBB_New   (void* bvh, Scene* scene, Geometry::GTypeMask gtype) { return new BVHNHairBuilderSAH<4,Curve4i,Line4i,Point4i>((BVH4*)bvh,scene,gtype); }
+    Builder* BVH4Curve4cBuilder_OBB_New   (void* bvh, Scene* scene, Geometry::GTypeMask gtype) { return new BVHNHairBuilderSAH<4,Curve4c,Line4i,Point4i>((BVH4*)bvh,scene,gtype); }
 
 #if defined(__AVX__)
-    Builder* BVH8Curve8vBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<8,Curve8v,Line8i,Point8i>((BVH8*)bvh,scene); }
-    Builder* BVH4Curve8iBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<4,Curve8i,Line8i,Point8i>((BVH4*)bvh,scene); }
+    Builder* BVH8Curve8vBuilder_OBB_New   (void* bvh, Scene* scene, Geometry::GTypeMask gtype) { return new BVHNHairBuilderSAH<8,Curve8v,Line8i,Point8i>((BVH8*)bvh,scene,gtype); }
+    Builder* BVH4Curve8iBuilder_OBB_New   (void* bvh, Scene* scene, Geometry::GTypeMask gtype) { return new BVHNHairBuilderSAH<4,Curve8i,Line8i,Point8i>((BVH4*)bvh,scene,gtype); }
 #endif
 
   }
@@ -15,6 +15,7 @@
 #include "../geometry/trianglei.h"
 #include "../geometry/quadv.h"
 #include "../geometry/quadi.h"
+#include "../geometry/pointv.h"
 #include "../geometry/object.h"
 #include "../geometry/instance.h"
 
@@ -241,7 +242,8 @@ namespace embree
           v2[i] = 0;
         }
         Triangle4i::store_nt(accel,Triangle4i(v0,v1,v2,vgeomID,vprimID));
-        BBox3fx box_o = BBox3fx((Vec3fx)lower,(Vec3fx)upper);
+        const BBox3fa box = mesh->enlargeQuantized(BBox3fa((Vec3fa)lower,(Vec3fa)upper));
+        BBox3fx box_o = BBox3fx((Vec3fx)box.lower,(Vec3fx)box.upper);
 #if ROTATE_TREE
         if (N == 4)
           box_o.lower.a = current.size();
@@ -399,6 +401,47 @@ namespace embree
       unsigned int geomID_ = std::numeric_limits<unsigned int>::max();
     };
 
+    template<int N, int M>
+    struct CreateMortonLeaf<N,PointMv<M>>
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
+      typedef typename BVH::NodeRecord NodeRecord;
+
+      __forceinline CreateMortonLeaf (Points* mesh, unsigned int geomID, BVHBuilderMorton::BuildPrim* morton)
+        : mesh(mesh), morton(morton), geomID_(geomID) {}
+      
+      __noinline NodeRecord operator() (const range<unsigned>& current, const FastAllocator::CachedAllocator& alloc)
+      {
+        size_t items = current.size();
+        size_t start = current.begin();
+        assert(items<=M);
+
+        /* fill leaf on the stack first, as the leaf size depends on the radii of the points */
+        unsigned int primIDs[M];
+        for (size_t i=0; i<items; i++)
+          primIDs[i] = morton[start+i].index;
+        PointMv<M> leaf;
+        const BBox3fa bounds = leaf.fill(mesh,geomID_,primIDs,items);
+
+        /* allocate leaf node */
+        PointMv<M>* accel = (PointMv<M>*) alloc.malloc1(leaf.bytes(),M*sizeof(float));
+        memcpy((void*)accel,(void*)&leaf,leaf.bytes());
+        NodeRef ref = BVH::encodeLeaf((char*)accel,1);
+
+        BBox3fx box_o = (BBox3fx&)bounds;
+#if ROTATE_TREE
+        if (N == 4)
+          box_o.lower.a = current.size();
+#endif
+        return NodeRecord(ref,box_o);
+      }
+    private:
+      Points* mesh;
+      BVHBuilderMorton::BuildPrim* morton;
+      unsigned int geomID_ = std::numeric_limits<unsigned int>::max();
+    };
+
     template<typename Mesh>
     struct CalculateMeshBounds
     {
@@ -520,6 +563,13 @@ namespace embree
 #endif
 #endif
 
+#if defined(EMBREE_GEOMETRY_POINT)
+    Builder* BVH4Point4vMeshBuilderMortonGeneral (void* bvh, Points* mesh, unsigned int geomID, size_t mode) { return new class BVHNMeshBuilderMorton<4,Points,Point4v>((BVH4*)bvh,mesh,geomID,4,4); }
+#if defined(__AVX__)
+    Builder* BVH4Point8vMeshBuilderMortonGeneral (void* bvh, Points* mesh, unsigned int geomID, size_t mode) { return new class BVHNMeshBuilderMorton<4,Points,Point8v>((BVH4*)bvh,mesh,geomID,8,8); }
+#endif
+#endif
+
 #if defined(EMBREE_GEOMETRY_INSTANCE)
     Builder* BVH4InstanceMeshBuilderMortonGeneral (void* bvh, Instance* mesh, Geometry::GTypeMask gtype, unsigned int geomID, size_t mode) { return new class BVHNMeshBuilderMorton<4,Instance,InstancePrimitive>((BVH4*)bvh,mesh,gtype,geomID,1,BVH4::maxLeafBlocks); }
 #if defined(__AVX__)
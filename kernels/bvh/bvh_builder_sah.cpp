@@ -286,61 +286,122 @@ namespace embree
       typedef BVHN<N> BVH;
       typedef typename BVH::NodeRef NodeRef;
 
-      __forceinline CreateLeafGrid (BVH* bvh, const SubGridBuildData * const sgrids) : bvh(bvh),sgrids(sgrids) {}
+      __forceinline CreateLeafGrid (BVH* bvh, const SubGridBuildData * const sgrids, const float quantizationStep)
+        : bvh(bvh), sgrids(sgrids), quantizationStep(quantizationStep) {}
 
       __forceinline NodeRef operator() (const PrimRef* prims, const range<size_t>& set, const FastAllocator::CachedAllocator& alloc) const
       {
         const size_t items = set.size(); //Primitive::blocks(n);
         const size_t start = set.begin();
+        const bool compressed = quantizationStep != 0.0f;
 
-        /* collect all subsets with unique geomIDs */
+        /* expand merged build primitives into their subgrids */
         assert(items <= N);
-        unsigned int geomIDs[N];
-        unsigned int num_geomIDs = 1;
-        geomIDs[0] = prims[start].geomID();
+        unsigned int geomIDs[4*N];
+        unsigned int xs[4*N];
+        unsigned int ys[4*N];
+        unsigned int primIDs[4*N];
+        BBox3fa bounds[4*N];
+        size_t numSubGrids = 0;
+        for (size_t i=0;i<items;i++)
+        {
+          const unsigned int geomID = prims[start+i].geomID();
+          const SubGridBuildData& sgrid_bd = sgrids[prims[start+i].primID()];
+          if (likely(!sgrid_bd.merged()))
+          {
+            geomIDs[numSubGrids] = geomID;
+            xs[numSubGrids] = sgrid_bd.sx;
+            ys[numSubGrids] = sgrid_bd.sy;
+            primIDs[numSubGrids] = sgrid_bd.primID;
+            bounds[numSubGrids] = prims[start+i].bounds();
+            numSubGrids++;
+            continue;
+          }
+
+          const GridMesh* mesh = bvh->scene->template get<GridMesh>(geomID);
+          const GridMesh::Grid& g = mesh->grid(sgrid_bd.primID);
+          for (unsigned int y=unsigned(sgrid_bd.y()); y<min(unsigned(sgrid_bd.y())+4u,g.resY-1u); y+=2)
+          {
+            for (unsigned int x=unsigned(sgrid_bd.x()); x<min(unsigned(sgrid_bd.x())+4u,g.resX-1u); x+=2)
+            {
+              geomIDs[numSubGrids] = geomID;
+              xs[numSubGrids] = x | g.get3x3FlagsX(x);
+              ys[numSubGrids] = y | g.get3x3FlagsY(y);
+              primIDs[numSubGrids] = sgrid_bd.primID;
+              mesh->buildBounds(g,x,y,bounds[numSubGrids]);
+              numSubGrids++;
+            }
+          }
+        }
 
-        for (size_t i=1;i<items;i++)
+        /* collect all subsets with unique geomIDs */
+        unsigned int uniqueGeomIDs[N];
+        unsigned int num_geomIDs = 0;
+        size_t num_blocks = 0;
+        for (size_t i=0;i<numSubGrids;i++)
         {
           bool found = false;
-          const unsigned int new_geomID = prims[start+i].geomID();
           for (size_t j=0;j<num_geomIDs;j++)
-            if (new_geomID == geomIDs[j])
+            if (geomIDs[i] == uniqueGeomIDs[j])
             { found = true; break; }
-          if (!found) 
-            geomIDs[num_geomIDs++] = new_geomID;
+          if (found) continue;
+          assert(num_geomIDs < N);
+          uniqueGeomIDs[num_geomIDs++] = geomIDs[i];
+          size_t count = 0;
+          for (size_t j=i;j<numSubGrids;j++)
+            count += geomIDs[j] == geomIDs[i];
+          num_blocks += (count+N-1)/N;
         }
+        assert(num_blocks <= BVH::maxLeafBlocks);
 
-        /* allocate all leaf memory in one single block */
-        SubGridQBVHN<N>* accel = (SubGridQBVHN<N>*) alloc.malloc1(num_geomIDs*sizeof(SubGridQBVHN<N>),BVH::byteAlignment);
-        typename BVH::NodeRef node = BVH::encodeLeaf((char*)accel,num_geomIDs);
+        /* allocate all leaf memory in one single block, quantized vertices are stored behind all leaf blocks */
+        SubGridQBVHN<N>* accel = (SubGridQBVHN<N>*) alloc.malloc1(num_blocks*SubGridQBVHN<N>::bytes(compressed),BVH::byteAlignment);
+        typename BVH::NodeRef node = BVH::encodeLeaf((char*)accel,num_blocks);
 
+        size_t b = 0;
         for (size_t g=0;g<num_geomIDs;g++)
         {
           unsigned int x[N];
           unsigned int y[N];
           unsigned int primID[N];
-          BBox3fa bounds[N];
+          BBox3fa blockBounds[N];
           unsigned int pos = 0;
-          for (size_t i=0;i<items;i++)
+          for (size_t i=0;i<numSubGrids;i++)
           {
-            if (unlikely(prims[start+i].geomID() != geomIDs[g])) continue;
-
-            const SubGridBuildData& sgrid_bd = sgrids[prims[start+i].primID()];
-            x[pos] = sgrid_bd.sx;
-            y[pos] = sgrid_bd.sy;
-            primID[pos] = sgrid_bd.primID;
-            bounds[pos] = prims[start+i].bounds();
-            pos++;
+            if (unlikely(geomIDs[i] != uniqueGeomIDs[g])) continue;
+
+            x[pos] = xs[i];
+            y[pos] = ys[i];
+            primID[pos] = primIDs[i];
+            blockBounds[pos] = bounds[i];
+            if (compressed)
+            {
+              Vec3fa vtx[16];
+              SubGridQuantizedVertices* qv = SubGridQBVHN<N>::quantizedVertices(accel,num_blocks,b,pos);
+              SubGrid(xs[i],ys[i],uniqueGeomIDs[g],primIDs[i]).gather(vtx,bvh->scene);
+              qv->encode(vtx,quantizationStep);
+              blockBounds[pos] = qv->bounds();
+            }
+            if (++pos == N) {
+              new (&accel[b]) SubGridQBVHN<N>(x,y,primID,blockBounds,uniqueGeomIDs[g],pos);
+              if (compressed) accel[b].setCompressed();
+              b++; pos = 0;
+            }
+          }
+          if (pos) {
+            new (&accel[b]) SubGridQBVHN<N>(x,y,primID,blockBounds,uniqueGeomIDs[g],pos);
+            if (compressed) accel[b].setCompressed();
+            b++;
           }
-          assert(pos <= N);
-          new (&accel[g]) SubGridQBVHN<N>(x,y,primID,bounds,geomIDs[g],pos);
         }
+        assert(b == num_blocks);
 
         return node;
       }
 
       BVH* bvh;
       const SubGridBuildData * const sgrids;
+      const float quantizationStep;
     };
 
 
@@ -349,21 +410,92 @@ namespace embree
     {
       typedef BVHN<N> BVH;
       typedef typename BVHN<N>::NodeRef NodeRef;
-      
+
+      /* thresholds for merging 2x2 subgrids into a single build primitive */
+      static constexpr float mergeMinCosAngle = 0.9f;
+      static constexpr float mergeMaxAreaRatio = 1.2f;
+
       BVH* bvh;
       Scene* scene;
       GridMesh* mesh;
       mvector<PrimRef> prims;
       mvector<SubGridBuildData> sgrids;
+      mvector<unsigned char> mergedGrids;
       GeneralBVHBuilder::Settings settings;
       unsigned int geomID_ = std::numeric_limits<unsigned int>::max();
       unsigned int numPreviousPrimitives = 0;
 
       BVHNBuilderSAHGrid (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
-        : bvh(bvh), scene(scene), mesh(nullptr), prims(scene->device,0), sgrids(scene->device,0), settings(sahBlockSize, minLeafSize, min(maxLeafSize,BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD) {}
+        : bvh(bvh), scene(scene), mesh(nullptr), prims(scene->device,0), sgrids(scene->device,0), mergedGrids(scene->device,0), settings(sahBlockSize, minLeafSize, min(maxLeafSize,BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD) {}
 
       BVHNBuilderSAHGrid (BVH* bvh, GridMesh* mesh, unsigned int geomID, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
-        : bvh(bvh), scene(nullptr), mesh(mesh), prims(bvh->device,0), sgrids(scene->device,0), settings(sahBlockSize, minLeafSize, min(maxLeafSize,BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD), geomID_(geomID) {}
+        : bvh(bvh), scene(nullptr), mesh(mesh), prims(bvh->device,0), sgrids(bvh->device,0), mergedGrids(bvh->device,0), settings(sahBlockSize, minLeafSize, min(maxLeafSize,BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD), geomID_(geomID) {}
+
+      /* decides whether the subgrids of a grid get merged and returns the number of build primitives of the grid */
+      __forceinline unsigned int countGridPrims(GridMesh* mesh, size_t gridID, size_t index, bool adaptive)
+      {
+        const GridMesh::Grid& g = mesh->grid(gridID);
+        const bool merge = adaptive && mesh->mergeSubGrids(g,mergeMinCosAngle,mergeMaxAreaRatio);
+        mergedGrids[index] = merge;
+        if (!merge) return mesh->getNumSubGrids(gridID);
+        return ((g.resX+2u)/4u) * ((g.resY+2u)/4u);
+      }
+
+      /* creates the build primitives of a grid, either one per subgrid or one per block of 2x2 subgrids */
+      __forceinline PrimInfo createGridPrims(GridMesh* mesh, size_t gridID, size_t index, unsigned int geomID, size_t& p_index)
+      {
+        PrimInfo pinfo(empty);
+        const GridMesh::Grid &g = mesh->grid(gridID);
+        if (mergedGrids[index])
+        {
+          for (unsigned int y=0; y<g.resY-1u; y+=4)
+            for (unsigned int x=0; x<g.resX-1u; x+=4)
+            {
+              BBox3fa bounds = empty;
+              for (unsigned int sy=y; sy<min(y+4u,g.resY-1u); sy+=2)
+                for (unsigned int sx=x; sx<min(x+4u,g.resX-1u); sx+=2)
+                {
+                  BBox3fa b = empty;
+                  mesh->buildBounds(g,sx,sy,b);
+                  bounds.extend(b);
+                }
+              const PrimRef prim(bounds,geomID,unsigned(p_index));
+              pinfo.add_center2(prim);
+              sgrids[p_index] = SubGridBuildData(x | 1, y, unsigned(gridID));
+              prims[p_index++] = prim;
+            }
+          return pinfo;
+        }
+
+        for (unsigned int y=0; y<g.resY-1u; y+=2)
+          for (unsigned int x=0; x<g.resX-1u; x+=2)
+          {
+            BBox3fa bounds = empty;
+            if (!mesh->buildBounds(g,x,y,bounds)) continue; // get bounds of subgrid
+            const PrimRef prim(bounds,geomID,unsigned(p_index));
+            pinfo.add_center2(prim);
+            sgrids[p_index] = SubGridBuildData(x | g.get3x3FlagsX(x), y | g.get3x3FlagsY(y), unsigned(gridID));
+            prims[p_index++] = prim;
+          }
+        return pinfo;
+      }
+
+      /* calculates a power of two quantization step such that the 16 bit
+       * vertex offsets cover each subgrid and that all decoded vertices
+       * are exactly representable as float */
+      float calculateQuantizationStep(const PrimInfo& pinfo) const
+      {
+        const float maxExtent = parallel_reduce(size_t(0), prims.size(), size_t(1024), 0.0f, [&](const range<size_t>& r) -> float {
+            float e = 0.0f;
+            for (size_t i=r.begin(); i<r.end(); i++)
+              e = max(e,reduce_max(prims[i].bounds().size()));
+            return e;
+          }, [](const float a, const float b) { return max(a,b); });
+        const float maxCoord = reduce_max(max(abs(pinfo.geomBounds.lower),abs(pinfo.geomBounds.upper)));
+        const float minStep = max(maxExtent/65000.0f,maxCoord/float(1<<23),float(ulp));
+        int exponent; frexpf(minStep,&exponent);
+        return ldexpf(1.0f,exponent);
+      }
 
       void build()
       {
@@ -378,6 +510,8 @@ namespace embree
 
         const size_t numGridPrimitives = mesh ? mesh->size() : scene->getNumPrimitives(GridMesh::geom_type,false);
         numPreviousPrimitives = numGridPrimitives;
+        const bool adaptive = bvh->device->grid_adaptive_subgrids;
+        const bool compressed = bvh->device->grid_compressed_vertices;
                
         PrimInfo pinfo(empty);
         size_t numPrimitives = 0;
@@ -390,17 +524,17 @@ namespace embree
           Scene::Iterator<GridMesh,false> iter(scene);
 
           pstate.init(iter,size_t(1024));
+          mergedGrids.resize(pstate.size());
 
           /* iterate over all meshes in the scene */
           pinfo = parallel_for_for_prefix_sum0( pstate, iter, PrimInfo(empty), [&](GridMesh* mesh, const range<size_t>& r, size_t k, size_t geomID) -> PrimInfo {
               PrimInfo pinfo(empty);
-              for (size_t j=r.begin(); j<r.end(); j++)
+              for (size_t j=r.begin(); j<r.end(); j++, k++)
               {
                 if (!mesh->valid(j)) continue;
                 BBox3fa bounds = empty;
                 const PrimRef prim(bounds,(unsigned)geomID,(unsigned)j);
-                if (!mesh->valid(j)) continue;
-                pinfo.add_center2(prim,mesh->getNumSubGrids(j));
+                pinfo.add_center2(prim,countGridPrims(mesh,j,k,adaptive));
               }
               return pinfo;
             }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
@@ -412,23 +546,12 @@ namespace embree
 
           /* second run to fill primrefs and SubGridBuildData arrays */
           pinfo = parallel_for_for_prefix_sum1( pstate, iter, PrimInfo(empty), [&](GridMesh* mesh, const range<size_t>& r, size_t k, size_t geomID, const PrimInfo& base) -> PrimInfo {
-              k = base.size();
-              size_t p_index = k;
+              size_t p_index = base.size();
               PrimInfo pinfo(empty);
-              for (size_t j=r.begin(); j<r.end(); j++)
+              for (size_t j=r.begin(); j<r.end(); j++, k++)
               {
                 if (!mesh->valid(j)) continue;
-                const GridMesh::Grid &g = mesh->grid(j);
-                for (unsigned int y=0; y<g.resY-1u; y+=2)
-                  for (unsigned int x=0; x<g.resX-1u; x+=2)
-                  {
-                    BBox3fa bounds = empty;
-                    if (!mesh->buildBounds(g,x,y,bounds)) continue; // get bounds of subgrid
-                    const PrimRef prim(bounds,(unsigned)geomID,(unsigned)p_index);
-                    pinfo.add_center2(prim);
-                    sgrids[p_index] = SubGridBuildData(x | g.get3x3FlagsX(x), y | g.get3x3FlagsY(y), unsigned(j));
-                    prims[p_index++] = prim;                
-                  }
+                pinfo.merge(createGridPrims(mesh,j,k,(unsigned)geomID,p_index));
               }
               return pinfo;
             }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
@@ -437,6 +560,8 @@ namespace embree
         else
         {
           ParallelPrefixSumState<PrimInfo> pstate;
+          mergedGrids.resize(mesh->size());
+
           /* iterate over all grids in a single mesh */
           pinfo = parallel_prefix_sum( pstate, size_t(0), mesh->size(), size_t(1024), PrimInfo(empty), [&](const range<size_t>& r, const PrimInfo& base) -> PrimInfo
                                        {
@@ -446,7 +571,7 @@ namespace embree
                                            if (!mesh->valid(j)) continue;
                                            BBox3fa bounds = empty;
                                            const PrimRef prim(bounds,geomID_,unsigned(j));
-                                           pinfo.add_center2(prim,mesh->getNumSubGrids(j));
+                                           pinfo.add_center2(prim,countGridPrims(mesh,j,j,adaptive));
                                          }
                                          return pinfo;
                                        }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
@@ -464,22 +589,13 @@ namespace embree
                                          for (size_t j=r.begin(); j<r.end(); j++)
                                          {
                                            if (!mesh->valid(j)) continue;
-                                           const GridMesh::Grid &g = mesh->grid(j);
-                                           for (unsigned int y=0; y<g.resY-1u; y+=2)
-                                             for (unsigned int x=0; x<g.resX-1u; x+=2)
-                                             {
-                                               BBox3fa bounds = empty;
-                                               if (!mesh->buildBounds(g,x,y,bounds)) continue; // get bounds of subgrid
-                                               const PrimRef prim(bounds,geomID_,unsigned(p_index));
-                                               pinfo.add_center2(prim);
-                                               sgrids[p_index] = SubGridBuildData(x | g.get3x3FlagsX(x), y | g.get3x3FlagsY(y), unsigned(j));
-                                               prims[p_index++] = prim;                
-                                             }
+                                           pinfo.merge(createGridPrims(mesh,j,j,geomID_,p_index));
                                          }
                                          return pinfo;
                                        }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
 
         }
+        mergedGrids.clear();
 
         /* no primitives */
         if (numPrimitives == 0) {
@@ -500,9 +616,22 @@ namespace embree
         if (mesh)
           bvh->alloc.setOSallocation(true);
 
+        /* the quantized vertices deviate by up to half a quantization step from the original vertices */
+        float quantizationStep = 0.0f;
+        if (compressed)
+        {
+          quantizationStep = calculateQuantizationStep(pinfo);
+          const Vec3fa eps(quantizationStep);
+          parallel_for(size_t(0), numPrimitives, size_t(1024), [&](const range<size_t>& r) {
+              for (size_t i=r.begin(); i<r.end(); i++)
+                prims[i] = PrimRef(BBox3fa(prims[i].lower-eps,prims[i].upper+eps),prims[i].geomID(),prims[i].primID());
+            });
+          pinfo.geomBounds = BBox3fa(pinfo.geomBounds.lower-eps,pinfo.geomBounds.upper+eps);
+        }
+
         /* initialize allocator */
         const size_t node_bytes = numPrimitives*sizeof(typename BVH::AABBNodeMB)/(4*N);
-        const size_t leaf_bytes = size_t(1.2*(float)numPrimitives/N * sizeof(SubGridQBVHN<N>));
+        const size_t leaf_bytes = size_t(1.2*(float)numPrimitives/N * SubGridQBVHN<N>::bytes(compressed));
 
         bvh->alloc.init_estimate(node_bytes+leaf_bytes);
         settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,numPrimitives,node_bytes+leaf_bytes);
@@ -517,7 +646,7 @@ namespace embree
         }
 
         /* call BVH builder */
-        NodeRef root = BVHNBuilderVirtual<N>::build(&bvh->alloc,CreateLeafGrid<N,SubGridQBVHN<N>>(bvh,sgrids.data()),bvh->scene->progressInterface,prims.data(),pinfo,settings);
+        NodeRef root = BVHNBuilderVirtual<N>::build(&bvh->alloc,CreateLeafGrid<N,SubGridQBVHN<N>>(bvh,sgrids.data(),quantizationStep),bvh->scene->progressInterface,prims.data(),pinfo,settings);
         bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
         bvh->layoutLargeNodes(size_t(pinfo.size()*0.005f));
 
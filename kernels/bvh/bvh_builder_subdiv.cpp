@@ -55,6 +55,11 @@ namespace embree
 
       __forceinline static unsigned createEager(SubdivPatch1Base& patch, Scene* scene, SubdivMesh* mesh, unsigned primID, Allocator& alloc, PrimRef* prims)
       {
+        /* displaced patches optionally get tessellated upfront in large batches */
+        const unsigned batch = scene->device->subdiv_displacement_batch;
+        if (mesh->displFunc && batch)
+          return createEagerBatched(patch,scene,mesh,batch,alloc,prims);
+
         unsigned NN = 0;
         const unsigned x0 = 0, x1 = patch.grid_u_res-1;
         const unsigned y0 = 0, y1 = patch.grid_v_res-1;
@@ -74,6 +79,66 @@ namespace embree
         return NN;
       }
 
+      /* tessellates the entire sub-patch in parallel blocks of rows, such
+       * that the displacement function gets called once for about
+       * 'batch' many vertices instead of once for each subgrid */
+      static unsigned createEagerBatched(SubdivPatch1Base& patch, Scene* scene, SubdivMesh* mesh, unsigned batch, Allocator& alloc, PrimRef* prims)
+      {
+        const unsigned width  = patch.grid_u_res;
+        const unsigned height = patch.grid_v_res;
+        const size_t numVertices = size_t(width)*size_t(height);
+        std::vector<float> grid_x(numVertices), grid_y(numVertices), grid_z(numVertices);
+        std::vector<float> grid_u(numVertices), grid_v(numVertices);
+
+        const unsigned rows = clamp(batch/width,1u,height);
+        const size_t numBlocks = (height+rows-1)/rows;
+        parallel_for(numBlocks, [&] (const size_t b)
+        {
+          const unsigned y0 = unsigned(b)*rows;
+          const unsigned y1 = min(y0+rows,height)-1;
+          const unsigned num = width*(y1-y0+1);
+          dynamic_large_stack_array(float,local_grid_x,num+VSIZEX,32*32*sizeof(float));
+          dynamic_large_stack_array(float,local_grid_y,num+VSIZEX,32*32*sizeof(float));
+          dynamic_large_stack_array(float,local_grid_z,num+VSIZEX,32*32*sizeof(float));
+          dynamic_large_stack_array(float,local_grid_u,num+VSIZEX,32*32*sizeof(float));
+          dynamic_large_stack_array(float,local_grid_v,num+VSIZEX,32*32*sizeof(float));
+          evalGrid(patch,0,width-1,y0,y1,width,height,
+                   local_grid_x,local_grid_y,local_grid_z,local_grid_u,local_grid_v,mesh);
+
+          const size_t ofs = size_t(y0)*width;
+          for (unsigned i=0; i<num; i++) {
+            grid_x[ofs+i] = local_grid_x[i];
+            grid_y[ofs+i] = local_grid_y[i];
+            grid_z[ofs+i] = local_grid_z[i];
+            grid_u[ofs+i] = local_grid_u[i];
+            grid_v[ofs+i] = local_grid_v[i];
+          }
+        });
+
+        GridSOA::PatchGrid pgrid;
+        pgrid.x = grid_x.data();
+        pgrid.y = grid_y.data();
+        pgrid.z = grid_z.data();
+        pgrid.u = grid_u.data();
+        pgrid.v = grid_v.data();
+        pgrid.width = width;
+
+        unsigned NN = 0;
+        for (unsigned y=0; y<height-1; y+=SUBGRID-1)
+        {
+          for (unsigned x=0; x<width-1; x+=SUBGRID-1) 
+          {
+            const unsigned lx0 = x, lx1 = min(lx0+SUBGRID-1,width-1);
+            const unsigned ly0 = y, ly1 = min(ly0+SUBGRID-1,height-1);
+            BBox3fa bounds;
+            GridSOA* leaf = GridSOA::create(&patch,1,lx0,lx1,ly0,ly1,scene,alloc,&bounds,&pgrid);
+            *prims = PrimRef(bounds,BVH4::encodeTypedLeaf(leaf,1)); prims++;
+            NN++;
+          }
+        }
+        return NN;
+      }
+
       void build() 
       {
         /* skip build for empty scene */
@@ -7,6 +7,7 @@
 #include "../common/scene_line_segments.h"
 #include "../common/scene_triangle_mesh.h"
 #include "../common/scene_quad_mesh.h"
+#include "../common/scene_points.h"
 
 #define PROFILE 0
 
@@ -335,6 +336,12 @@ namespace embree
     }
 #endif
 
+#if defined(EMBREE_GEOMETRY_POINT)
+    Builder* BVH4BuilderTwoLevelPoint4vMorton (void* bvh, Scene* scene) {
+      return new BVHNBuilderTwoLevel<4,Points,Point4v>((BVH4*)bvh,scene,Points::geom_type,true);
+    }
+#endif
+
 #if defined(EMBREE_GEOMETRY_INSTANCE)
     Builder* BVH4BuilderTwoLevelInstanceSAH (void* bvh, Scene* scene, Geometry::GTypeMask gtype, bool useMortonBuilder) {
       return new BVHNBuilderTwoLevel<4,Instance,InstancePrimitive>((BVH4*)bvh,scene,gtype,useMortonBuilder);
@@ -366,6 +373,12 @@ namespace embree
     }
 #endif
 
+#if defined(EMBREE_GEOMETRY_POINT)
+    Builder* BVH4BuilderTwoLevelPoint8vMorton (void* bvh, Scene* scene) {
+      return new BVHNBuilderTwoLevel<4,Points,Point8v>((BVH4*)bvh,scene,Points::geom_type,true);
+    }
+#endif
+
 #if defined(EMBREE_GEOMETRY_INSTANCE)
     Builder* BVH8BuilderTwoLevelInstanceSAH (void* bvh, Scene* scene, Geometry::GTypeMask gtype, bool useMortonBuilder) {
       return new BVHNBuilderTwoLevel<8,Instance,InstancePrimitive>((BVH8*)bvh,scene,gtype,useMortonBuilder);
@@ -9,6 +9,7 @@
 #include "../geometry/trianglei.h"
 #include "../geometry/quadv.h"
 #include "../geometry/quadi.h"
+#include "../geometry/pointv.h"
 #include "../geometry/object.h"
 #include "../geometry/instance.h"
 
@@ -29,6 +30,8 @@ namespace embree
   DECLARE_ISA_FUNCTION(Builder*,BVH4VirtualMeshBuilderMortonGeneral,void* COMMA UserGeometry* COMMA unsigned int COMMA size_t);
   DECLARE_ISA_FUNCTION(Builder*,BVH4VirtualMeshBuilderSAH,void* COMMA UserGeometry* COMMA unsigned int COMMA size_t);
   DECLARE_ISA_FUNCTION(Builder*,BVH4VirtualMeshRefitSAH,void* COMMA UserGeometry* COMMA unsigned int COMMA size_t);
+  DECLARE_ISA_FUNCTION(Builder*,BVH4Point4vMeshBuilderMortonGeneral,void* COMMA Points* COMMA unsigned int COMMA size_t);
+  DECLARE_ISA_FUNCTION(Builder*,BVH4Point8vMeshBuilderMortonGeneral,void* COMMA Points* COMMA unsigned int COMMA size_t);
   DECLARE_ISA_FUNCTION(Builder*,BVH4InstanceMeshBuilderMortonGeneral,void* COMMA Instance* COMMA Geometry::GTypeMask COMMA unsigned int COMMA size_t);
   DECLARE_ISA_FUNCTION(Builder*,BVH4InstanceMeshBuilderSAH,void* COMMA Instance* COMMA Geometry::GTypeMask COMMA unsigned int COMMA size_t);
   DECLARE_ISA_FUNCTION(Builder*,BVH4InstanceMeshRefitSAH,void* COMMA Instance* COMMA Geometry::GTypeMask COMMA unsigned int COMMA size_t)
@@ -89,6 +92,16 @@ namespace embree
         Builder* operator () (void* bvh, Instance* mesh, size_t geomID, Geometry::GTypeMask gtype) { return BVH4InstanceMeshBuilderMortonGeneral(bvh,mesh,gtype,geomID,0);}
       };
       template<>
+      struct MortonBuilder<4,Points,Point4v> {
+        MortonBuilder () {}
+        Builder* operator () (void* bvh, Points* mesh, size_t geomID, Geometry::GTypeMask /*gtype*/) { return BVH4Point4vMeshBuilderMortonGeneral(bvh,mesh,geomID,0);}
+      };
+      template<>
+      struct MortonBuilder<4,Points,Point8v> {
+        MortonBuilder () {}
+        Builder* operator () (void* bvh, Points* mesh, size_t geomID, Geometry::GTypeMask /*gtype*/) { return BVH4Point8vMeshBuilderMortonGeneral(bvh,mesh,geomID,0);}
+      };
+      template<>
       struct MortonBuilder<8,TriangleMesh,Triangle4> {
         MortonBuilder () {}
         Builder* operator () (void* bvh, TriangleMesh* mesh, size_t geomID, Geometry::GTypeMask /*gtype*/) { return BVH8Triangle4MeshBuilderMortonGeneral(bvh,mesh,geomID,0);}
@@ -262,6 +275,15 @@ namespace embree
           }
         }
       };
+
+      /* points are always built with the morton builder, as they are typically rebuilt every frame */
+      template<int N, int M>
+      struct MeshBuilder<N,Points,PointMv<M>> {
+        MeshBuilder () {}
+        void operator () (void* bvh, Points* mesh, size_t geomID, Geometry::GTypeMask gtype, bool /*useMortonBuilder*/, Builder*& builder) {
+          builder = MortonBuilder<N,Points,PointMv<M>>()(bvh,mesh,geomID,gtype);
+        }
+      };
     }
   }
 }
\ No newline at end of file
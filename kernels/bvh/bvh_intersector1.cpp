@@ -42,11 +42,19 @@ namespace embree
       Precalculations pre(ray, bvh);
 
       /* stack state */
+#if defined(EMBREE_COMPRESSED_TRAVERSAL_STACK)
+      typedef StackItemCompressedT<NodeRef> StackItem;
+      StackItem stack[stackSize];    // stack of nodes
+      StackItem* stackPtr = stack+1; // current stack pointer
+      StackItem* stackEnd = stack+stackSize;
+      stack[0] = StackItem(bvh->root,(unsigned)cast_f2i(neg_inf));
+#else
       StackItemT<NodeRef> stack[stackSize];    // stack of nodes
       StackItemT<NodeRef>* stackPtr = stack+1; // current stack pointer
       StackItemT<NodeRef>* stackEnd = stack+stackSize;
       stack[0].ptr  = bvh->root;
       stack[0].dist = neg_inf;
+#endif
       
       if (bvh->root == BVH::emptyNode)
         return;
@@ -72,6 +80,13 @@ namespace embree
         /* pop next node */
         if (unlikely(stackPtr == stack)) break;
         stackPtr--;
+#if defined(EMBREE_COMPRESSED_TRAVERSAL_STACK)
+        NodeRef cur = stackPtr->ptr();
+
+        /* if popped node is too far, pop next one */
+        if (unlikely(stackPtr->dist() > ray.tfar))
+          continue;
+#else
         NodeRef cur = NodeRef(stackPtr->ptr);
 
         /* if popped node is too far, pop next one */
@@ -82,6 +97,7 @@ namespace embree
 #else
         if (unlikely(*(float*)&stackPtr->dist > ray.tfar))
           continue;
+#endif
 #endif
 
         /* downtraversal loop */
@@ -92,6 +108,7 @@ namespace embree
           STAT3(normal.trav_nodes,1,1,1);
           bool nodeIntersected = BVHNNodeIntersector1<N, Nx, types, robust>::intersect(cur, tray, ray.time(), tNear, mask);
           if (unlikely(!nodeIntersected)) { STAT3(normal.trav_nodes,-1,-1,-1); break; }
+          TRAV_STAT(context,nodeCount,1);
 
           /* if no child is hit, pop next node */
           if (unlikely(mask == 0))
@@ -105,14 +122,20 @@ namespace embree
         assert(cur != BVH::emptyNode);
         STAT3(normal.trav_leaves,1,1,1);
         size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
+        TRAV_STAT(context,leafCount,1);
+        TRAV_STAT(context,primitiveCount,num);
         size_t lazy_node = 0;
         PrimitiveIntersector1::intersect(This, pre, ray, context, prim, num, tray, lazy_node);
         tray.tfar = ray.tfar;
 
         /* push lazy node onto stack */
         if (unlikely(lazy_node)) {
+#if defined(EMBREE_COMPRESSED_TRAVERSAL_STACK)
+          *stackPtr = StackItem(lazy_node,(unsigned)cast_f2i(neg_inf));
+#else
           stackPtr->ptr = lazy_node;
           stackPtr->dist = neg_inf;
+#endif
           stackPtr++;
         }
       }
@@ -174,6 +197,7 @@ namespace embree
           STAT3(shadow.trav_nodes,1,1,1);
           bool nodeIntersected = BVHNNodeIntersector1<N, Nx, types, robust>::intersect(cur, tray, ray.time(), tNear, mask);
           if (unlikely(!nodeIntersected)) { STAT3(shadow.trav_nodes,-1,-1,-1); break; }
+          TRAV_STAT(context,nodeCount,1);
 
           /* if no child is hit, pop next node */
           if (unlikely(mask == 0))
@@ -187,6 +211,8 @@ namespace embree
         assert(cur != BVH::emptyNode);
         STAT3(shadow.trav_leaves,1,1,1);
         size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
+        TRAV_STAT(context,leafCount,1);
+        TRAV_STAT(context,primitiveCount,num);
         size_t lazy_node = 0;
         if (PrimitiveIntersector1::occluded(This, pre, ray, context, prim, num, tray, lazy_node)) {
           ray.tfar = neg_inf;
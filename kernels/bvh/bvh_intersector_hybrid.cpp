@@ -79,6 +79,7 @@ namespace embree
           STAT3(normal.trav_nodes, 1, 1, 1);
           bool nodeIntersected = BVHNNodeIntersector1<N, Nx, types, robust>::intersect(cur, tray1, ray.time()[k], tNear, mask);
           if (unlikely(!nodeIntersected)) { STAT3(normal.trav_nodes,-1,-1,-1); break; }
+          TRAV_STAT(context,nodeCount,1);
 
           /* if no child is hit, pop next node */
           if (unlikely(mask == 0))
@@ -92,6 +93,8 @@ namespace embree
         assert(cur != BVH::emptyNode);
         STAT3(normal.trav_leaves, 1, 1, 1);
         size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
+        TRAV_STAT(context,leafCount,1);
+        TRAV_STAT(context,primitiveCount,num);
 
         size_t lazy_node = 0;
         PrimitiveIntersectorK::intersect(This, pre, ray, k, context, prim, num, tray1, lazy_node);
@@ -259,6 +262,7 @@ namespace embree
             /* process nodes */
             const vbool<K> valid_node = tray.tfar > curDist;
             STAT3(normal.trav_nodes, 1, popcnt(valid_node), K);
+            TRAV_STAT(context,nodeCount,1);
             const NodeRef nodeRef = cur;
             const BaseNode* __restrict__ const node = nodeRef.baseNode();
 
@@ -360,6 +364,8 @@ namespace embree
           STAT3(normal.trav_leaves, 1, popcnt(valid_leaf), K);
           if (unlikely(none(valid_leaf))) continue;
           size_t items; const Primitive* prim = (Primitive*)cur.leaf(items);
+          TRAV_STAT(context,leafCount,1);
+          TRAV_STAT(context,primitiveCount,items);
 
           size_t lazy_node = 0;
           PrimitiveIntersectorK::intersect(valid_leaf, This, pre, ray, context, prim, items, tray, lazy_node);
@@ -439,6 +445,7 @@ namespace embree
           {
             /* process nodes */
             //STAT3(normal.trav_nodes, 1, popcnt(valid_node), K);
+            TRAV_STAT(context,nodeCount,1);
             const NodeRef nodeRef = cur;
             const AABBNode* __restrict__ const node = nodeRef.getAABBNode();
 
@@ -510,6 +517,8 @@ namespace embree
           STAT3(normal.trav_leaves, 1, popcnt(valid_leaf), K);
           if (unlikely(none(valid_leaf))) continue;
           size_t items; const Primitive* prim = (Primitive*)cur.leaf(items);
+          TRAV_STAT(context,leafCount,1);
+          TRAV_STAT(context,primitiveCount,items);
 
           size_t lazy_node = 0;
           PrimitiveIntersectorK::intersect(valid_leaf, This, pre, ray, context, prim, items, tray, lazy_node);
@@ -570,6 +579,7 @@ namespace embree
             STAT3(shadow.trav_nodes, 1, 1, 1);
             bool nodeIntersected = BVHNNodeIntersector1<N, Nx, types, robust>::intersect(cur, tray1, ray.time()[k], tNear, mask);
             if (unlikely(!nodeIntersected)) { STAT3(shadow.trav_nodes,-1,-1,-1); break; }
+            TRAV_STAT(context,nodeCount,1);
 
             /* if no child is hit, pop next node */
             if (unlikely(mask == 0))
@@ -583,6 +593,8 @@ namespace embree
           assert(cur != BVH::emptyNode);
           STAT3(shadow.trav_leaves, 1, 1, 1);
           size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
+          TRAV_STAT(context,leafCount,1);
+          TRAV_STAT(context,primitiveCount,num);
 
           size_t lazy_node = 0;
           if (PrimitiveIntersectorK::occluded(This, pre, ray, k, context, prim, num, tray1, lazy_node)) {
@@ -706,6 +718,7 @@ namespace embree
           /* process nodes */
           const vbool<K> valid_node = tray.tfar > curDist;
           STAT3(shadow.trav_nodes, 1, popcnt(valid_node), K);
+          TRAV_STAT(context,nodeCount,1);
           const NodeRef nodeRef = cur;
           const BaseNode* __restrict__ const node = nodeRef.baseNode();
 
@@ -767,6 +780,8 @@ namespace embree
         STAT3(shadow.trav_leaves, 1, popcnt(valid_leaf), K);
         if (unlikely(none(valid_leaf))) continue;
         size_t items; const Primitive* prim = (Primitive*) cur.leaf(items);
+        TRAV_STAT(context,leafCount,1);
+        TRAV_STAT(context,primitiveCount,items);
 
         size_t lazy_node = 0;
         terminated |= PrimitiveIntersectorK::occluded(!terminated, This, pre, ray, context, prim, items, tray, lazy_node);
@@ -850,6 +865,7 @@ namespace embree
           {
             /* process nodes */
             //STAT3(normal.trav_nodes, 1, popcnt(valid_node), K);
+            TRAV_STAT(context,nodeCount,1);
             const NodeRef nodeRef = cur;
             const AABBNode* __restrict__ const node = nodeRef.getAABBNode();
 
@@ -898,6 +914,8 @@ namespace embree
 #endif
           if (unlikely(!m_active)) continue;
           size_t items; const Primitive* prim = (Primitive*)cur.leaf(items);
+          TRAV_STAT(context,leafCount,1);
+          TRAV_STAT(context,primitiveCount,items);
 
           size_t lazy_node = 0;
           terminated |= PrimitiveIntersectorK::occluded(!terminated, This, pre, ray, context, prim, items, tray, lazy_node);
@@ -100,6 +100,7 @@ namespace embree
         {
           if (unlikely(cur.isLeaf())) break;
           const AABBNode* __restrict__ const node = cur.getAABBNode();
+          TRAV_STAT(context,nodeCount,1);
           parent = cur;
 
           __aligned(64) size_t maskK[N];
@@ -129,6 +130,8 @@ namespace embree
         assert(cur != BVH::emptyNode);
         STAT3(normal.trav_leaves, 1, 1, 1);
         size_t num; PrimitiveK<K>* prim = (PrimitiveK<K>*)cur.leaf(num);
+        TRAV_STAT(context,leafCount,1);
+        TRAV_STAT(context,primitiveCount,num);
 
         size_t bits = m_trav_active;
 
@@ -229,6 +232,7 @@ namespace embree
         {
           if (unlikely(cur.isLeaf())) break;
           const AABBNode* __restrict__ const node = cur.getAABBNode();
+          TRAV_STAT(context,nodeCount,1);
           parent = cur;
 
           __aligned(64) size_t maskK[N];
@@ -259,6 +263,8 @@ namespace embree
         assert(cur != BVH::emptyNode);
         STAT3(normal.trav_leaves, 1, 1, 1);
         size_t num; PrimitiveK<K>* prim = (PrimitiveK<K>*)cur.leaf(num);
+        TRAV_STAT(context,leafCount,1);
+        TRAV_STAT(context,primitiveCount,num);
 
         size_t bits = m_trav_active & m_active;
         /*! intersect stream of rays with all primitives */
@@ -337,6 +343,7 @@ namespace embree
           /*! stop if we found a leaf node */
           if (unlikely(cur.isLeaf())) break;
           const AABBNode* __restrict__ const node = cur.getAABBNode();
+          TRAV_STAT(context,nodeCount,1);
 
           const vint<Nx> vmask = traverseIncoherentStream(cur_mask, packet, node, nf, shiftTable);
 
@@ -380,6 +387,8 @@ namespace embree
         assert(cur != BVH::emptyNode);
         STAT3(shadow.trav_leaves,1,1,1);
         size_t num; PrimitiveK<K>* prim = (PrimitiveK<K>*)cur.leaf(num);
+        TRAV_STAT(context,leafCount,1);
+        TRAV_STAT(context,primitiveCount,num);
 
         size_t bits = cur_mask;
         size_t lazy_node = 0;
@@ -134,19 +134,58 @@ namespace embree
       }
       else
       {
-        /* fallback to packets */
-        for (size_t i = 0; i < N; i += K)
+        /* regroup incoherent rays into packets of rays of the same direction octant */
+        __aligned(64) unsigned int octants[8][K];
+
+        unsigned int raysInOctant[8];
+        for (unsigned int i = 0; i < 8; i++)
+          raysInOctant[i] = 0;
+        size_t inputRayID = 0;
+
+        for (;;)
         {
-          const vint<K> vi = vint<K>(int(i)) + vint<K>(step);
-          vbool<K> valid = vi < vint<K>(int(N));
-          const vint<K> offset = vi * int(stride);
+          int curOctant = -1;
 
+          /* sort rays into octants until some packet is full */
+          for (; inputRayID < N;)
+          {
+            const Ray& ray = rayN.getRayByOffset(inputRayID * stride);
+
+            /* skip invalid rays */
+            if (unlikely(ray.tnear() > ray.tfar)) { inputRayID++; continue; }
+
+            const unsigned int octantID = movemask(vfloat4(Vec3fa(ray.dir)) < 0.0f) & 0x7;
+
+            assert(octantID < 8);
+            octants[octantID][raysInOctant[octantID]++] = (unsigned int)inputRayID;
+            inputRayID++;
+            if (unlikely(raysInOctant[octantID] == K))
+            {
+              curOctant = octantID;
+              break;
+            }
+          }
+
+          /* need to flush rays in octant? */
+          if (unlikely(curOctant == -1))
+          {
+            for (unsigned int i = 0; i < 8; i++)
+              if (raysInOctant[i]) { curOctant = i; break; }
+          }
+
+          /* all rays traced? */
+          if (unlikely(curOctant == -1))
+            break;
+
+          const vbool<K> valid = vint<K>(step) < vint<K>(int(raysInOctant[curOctant]));
+          const vint<K> offset = *(vint<K>*)&octants[curOctant][0] * int(stride);
           RayTypeK<K, intersect> ray = rayN.getRayByOffset(valid, offset);
-          valid &= ray.tnear() <= ray.tfar;
 
           scene->intersectors.intersect(valid, ray, context);
 
           rayN.setHitByOffset(valid, offset, ray);
+
+          raysInOctant[curOctant] = 0;
         }
       }
     }
@@ -276,18 +315,58 @@ namespace embree
       }
       else
       {
-        /* fallback to packets */
-        for (size_t i = 0; i < N; i += K)
+        /* regroup incoherent rays into packets of rays of the same direction octant */
+        __aligned(64) unsigned int octants[8][K];
+
+        unsigned int raysInOctant[8];
+        for (unsigned int i = 0; i < 8; i++)
+          raysInOctant[i] = 0;
+        size_t inputRayID = 0;
+
+        for (;;)
         {
-          const vint<K> vi = vint<K>(int(i)) + vint<K>(step);
-          vbool<K> valid = vi < vint<K>(int(N));
+          int curOctant = -1;
+
+          /* sort rays into octants until some packet is full */
+          for (; inputRayID < N;)
+          {
+            const Ray& ray = rayN.getRayByIndex(inputRayID);
+
+            /* skip invalid rays */
+            if (unlikely(ray.tnear() > ray.tfar)) { inputRayID++; continue; }
+
+            const unsigned int octantID = movemask(lt_mask(ray.dir,Vec3fa(0.0f)));
+
+            assert(octantID < 8);
+            octants[octantID][raysInOctant[octantID]++] = (unsigned int)inputRayID;
+            inputRayID++;
+            if (unlikely(raysInOctant[octantID] == K))
+            {
+              curOctant = octantID;
+              break;
+            }
+          }
 
-          RayTypeK<K, intersect> ray = rayN.getRayByIndex(valid, vi);
-          valid &= ray.tnear() <= ray.tfar;
+          /* need to flush rays in octant? */
+          if (unlikely(curOctant == -1))
+          {
+            for (unsigned int i = 0; i < 8; i++)
+              if (raysInOctant[i]) { curOctant = i; break; }
+          }
+
+          /* all rays traced? */
+          if (unlikely(curOctant == -1))
+            break;
+
+          const vbool<K> valid = vint<K>(step) < vint<K>(int(raysInOctant[curOctant]));
+          const vint<K> index = *(vint<K>*)&octants[curOctant][0];
+          RayTypeK<K, intersect> ray = rayN.getRayByIndex(valid, index);
 
           scene->intersectors.intersect(valid, ray, context);
 
-          rayN.setHitByIndex(valid, vi, ray);
+          rayN.setHitByIndex(valid, index, ray);
+
+          raysInOctant[curOctant] = 0;
         }
       }
     }
@@ -574,19 +653,58 @@ namespace embree
       }
       else
       {
-        /* fallback to packets */
-        for (size_t i = 0; i < N; i += K)
+        /* regroup incoherent rays into packets of rays of the same direction octant */
+        __aligned(64) unsigned int octants[8][K];
+
+        unsigned int raysInOctant[8];
+        for (unsigned int i = 0; i < 8; i++)
+          raysInOctant[i] = 0;
+        size_t inputRayID = 0;
+
+        for (;;)
         {
-          const vint<K> vi = vint<K>(int(i)) + vint<K>(step);
-          vbool<K> valid = vi < vint<K>(int(N));
-          const size_t offset = i * sizeof(float);
+          int curOctant = -1;
 
+          /* sort rays into octants until some packet is full */
+          for (; inputRayID < N;)
+          {
+            const size_t offset = inputRayID * sizeof(float);
+
+            /* skip invalid rays */
+            if (unlikely(!rayN.isValidByOffset(offset))) { inputRayID++; continue; }
+
+            const unsigned int octantID = (unsigned int)rayN.getOctantByOffset(offset);
+
+            assert(octantID < 8);
+            octants[octantID][raysInOctant[octantID]++] = (unsigned int)offset;
+            inputRayID++;
+            if (unlikely(raysInOctant[octantID] == K))
+            {
+              curOctant = octantID;
+              break;
+            }
+          }
+
+          /* need to flush rays in octant? */
+          if (unlikely(curOctant == -1))
+          {
+            for (unsigned int i = 0; i < 8; i++)
+              if (raysInOctant[i]) { curOctant = i; break; }
+          }
+
+          /* all rays traced? */
+          if (unlikely(curOctant == -1))
+            break;
+
+          const vbool<K> valid = vint<K>(step) < vint<K>(int(raysInOctant[curOctant]));
+          const vint<K> offset = *(vint<K>*)&octants[curOctant][0];
           RayTypeK<K, intersect> ray = rayN.getRayByOffset(valid, offset);
-          valid &= ray.tnear() <= ray.tfar;
 
           scene->intersectors.intersect(valid, ray, context);
 
           rayN.setHitByOffset(valid, offset, ray);
+
+          raysInOctant[curOctant] = 0;
         }
       }
     }
@@ -248,6 +248,60 @@ namespace embree
 
 #endif
 
+    /*! Traverses a node with at least one hit child and stores the
+     *  remaining hit children as compressed stack items. Optimized for
+     *  finding the closest hit (intersection). */
+    template<typename BVH, int Nx, int types>
+      __forceinline void traverseClosestHitCompressed(typename BVH::NodeRef& cur,
+                                                      size_t mask,
+                                                      const vfloat<Nx>& tNear,
+                                                      StackItemCompressedT<typename BVH::NodeRef>*& stackPtr,
+                                                      StackItemCompressedT<typename BVH::NodeRef>* stackEnd)
+    {
+      typedef typename BVH::NodeRef NodeRef;
+      typedef StackItemCompressedT<NodeRef> StackItem;
+
+      assert(mask != 0);
+      const typename BVH::BaseNode* node = cur.baseNode();
+
+      /*! one child is hit, continue with that child */
+      size_t r = bscf(mask);
+      cur = node->child(r);
+      BVH::prefetch(cur,types);
+      assert(cur != BVH::emptyNode);
+      if (likely(mask == 0)) return;
+
+      /*! two children are hit, push far child, and continue with closer child */
+      NodeRef c0 = cur;
+      const unsigned int d0 = ((unsigned int*)&tNear)[r];
+      r = bscf(mask);
+      NodeRef c1 = node->child(r);
+      BVH::prefetch(c1,types);
+      const unsigned int d1 = ((unsigned int*)&tNear)[r];
+      assert(c1 != BVH::emptyNode);
+      if (likely(mask == 0)) {
+        assert(stackPtr < stackEnd);
+        if (d0 < d1) { *stackPtr = StackItem(c1,d1); stackPtr++; cur = c0; return; }
+        else         { *stackPtr = StackItem(c0,d0); stackPtr++; cur = c1; return; }
+      }
+
+      /*! more children are hit, push all onto stack, sort them, and continue with closest child */
+      StackItem* stackFirst = stackPtr;
+      assert(stackPtr+1 < stackEnd);
+      *stackPtr = StackItem(c0,d0); stackPtr++;
+      *stackPtr = StackItem(c1,d1); stackPtr++;
+      do {
+        assert(stackPtr < stackEnd);
+        r = bscf(mask);
+        NodeRef c = node->child(r); BVH::prefetch(c,types);
+        assert(c != BVH::emptyNode);
+        *stackPtr = StackItem(c,((unsigned int*)&tNear)[r]); stackPtr++;
+      } while (mask);
+      sort(stackFirst,stackPtr);
+      stackPtr--;
+      cur = stackPtr->ptr();
+    }
+
     /* Specialization for BVH4. */
     template<int Nx, int types>
     class BVHNNodeTraverser1Hit<4, Nx, types>
@@ -347,6 +401,16 @@ namespace embree
 #endif
       }
 
+      /* Traverses a node with at least one hit child using compressed stack items. */
+      static __forceinline void traverseClosestHit(NodeRef& cur,
+                                                   size_t mask,
+                                                   const vfloat<Nx>& tNear,
+                                                   StackItemCompressedT<NodeRef>*& stackPtr,
+                                                   StackItemCompressedT<NodeRef>* stackEnd)
+      {
+        traverseClosestHitCompressed<BVH,Nx,types>(cur,mask,tNear,stackPtr,stackEnd);
+      }
+
       /* Traverses a node with at least one hit child. Optimized for finding any hit (occlusion). */
       static __forceinline void traverseAnyHit(NodeRef& cur,
                                                size_t mask,
@@ -356,26 +420,23 @@ namespace embree
       {
         const BaseNode* node = cur.baseNode();
 
-        /*! one child is hit, continue with that child */
+        /*! continue with the first hit child */
         size_t r = bscf(mask);
-        cur = node->child(r); 
+        cur = node->child(r);
         BVH::prefetch(cur,types);
-
-        /* simpler in sequence traversal order */
         assert(cur != BVH::emptyNode);
         if (likely(mask == 0)) return;
-        assert(stackPtr < stackEnd);
-        *stackPtr = cur; stackPtr++;
 
-        for (; ;)
-        {
-          r = bscf(mask);
-          cur = node->child(r); BVH::prefetch(cur,types);
-          assert(cur != BVH::emptyNode);
-          if (likely(mask == 0)) return;
+        /* no distance sorting, remaining children are visited in
+         * storage order, which has children of larger surface area
+         * first, as these more likely contain an occluder */
+        do {
           assert(stackPtr < stackEnd);
-          *stackPtr = cur; stackPtr++;
-        }
+          r = bsr(mask); mask = btc(mask,r);
+          NodeRef c = node->child(r); BVH::prefetch(c,types);
+          assert(c != BVH::emptyNode);
+          *stackPtr = c; stackPtr++;
+        } while (mask);
       }
     };
 
@@ -581,22 +642,40 @@ namespace embree
           stackPtr+=3;
           return;
         }
-        *(vint4*)&stackPtr[0] = s0; *(vint4*)&stackPtr[1] = s1; *(vint4*)&stackPtr[2] = s2; *(vint4*)&stackPtr[3] = s3;
-        /*! fallback case if more than 4 children are hit */
-        StackItemT<NodeRef>* stackFirst = stackPtr;
-        stackPtr+=4;      
-        while (1)
-        {
-          assert(stackPtr < stackEnd);
+
+        /*! more than 4 children are hit, unused items get the largest
+         *  distance to end up at the front after sorting */
+        vint4 s[8];
+        s[0] = s0; s[1] = s1; s[2] = s2; s[3] = s3;
+        s[4] = s[5] = s[6] = s[7] = vint4(0,0,INT_MAX,0);
+        unsigned int dmin = min(min(d0,d1),min(d2,d3));
+        unsigned int dmax = max(max(d0,d1),max(d2,d3));
+        size_t hits = 4;
+        do {
           r = bscf(mask);
-          NodeRef c = node->child(r); BVH::prefetch(c,types); unsigned int d = *(unsigned int*)&tNear[r]; 
-          const vint4 s((size_t)c,(size_t)d);
-          *(vint4*)stackPtr++ = s;
+          NodeRef c = node->child(r); BVH::prefetch(c,types); unsigned int d = ((unsigned int*)&tNear)[r];
           assert(c != BVH::emptyNode);
-          if (unlikely(mask == 0)) break;
+          s[hits++] = vint4((size_t)c,(size_t)d);
+          dmin = min(dmin,d); dmax = max(dmax,d);
+        } while (mask);
+        assert(stackPtr+hits-1 <= stackEnd);
+
+        /*! sorting cannot improve culling if all children are hit at
+         *  nearly the same distance (e.g. coplanar geometry), thus we
+         *  traverse them in storage order */
+        if (unlikely(StackItemT<NodeRef>::nearlyEqual(dmin,dmax)))
+        {
+          for (size_t i=0; i<hits-1; i++)
+            *(vint4*)stackPtr++ = s[i];
+          cur = toSizeT(s[hits-1]);
+          return;
         }
-        sort(stackFirst,stackPtr);
-        cur = (NodeRef) stackPtr[-1].ptr; stackPtr--;
+
+        /*! branch free sorting of all 8 items, the closest child ends up last */
+        StackItemT<NodeRef>::sort8(s);
+        for (size_t i=8-hits; i<7; i++)
+          *(vint4*)stackPtr++ = s[i];
+        cur = toSizeT(s[7]);
 #else
         /*! Here starts the slow path for 3 or 4 hit children. We push
          *  all nodes onto the stack to sort them there. */
@@ -642,6 +721,15 @@ namespace embree
 #endif
       }
 
+      static __forceinline void traverseClosestHit(NodeRef& cur,
+                                                   size_t mask,
+                                                   const vfloat<Nx>& tNear,
+                                                   StackItemCompressedT<NodeRef>*& stackPtr,
+                                                   StackItemCompressedT<NodeRef>* stackEnd)
+      {
+        traverseClosestHitCompressed<BVH,Nx,types>(cur,mask,tNear,stackPtr,stackEnd);
+      }
+
       static __forceinline void traverseAnyHit(NodeRef& cur,
                                                size_t mask,
                                                const vfloat<Nx>& tNear,
@@ -650,26 +738,23 @@ namespace embree
       {
         const BaseNode* node = cur.baseNode();
 
-        /*! one child is hit, continue with that child */
+        /*! continue with the first hit child */
         size_t r = bscf(mask);
         cur = node->child(r);
         BVH::prefetch(cur,types);
-
-        /* simpler in sequence traversal order */
         assert(cur != BVH::emptyNode);
         if (likely(mask == 0)) return;
-        assert(stackPtr < stackEnd);
-        *stackPtr = cur; stackPtr++;
 
-        for (; ;)
-        {
-          r = bscf(mask);
-          cur = node->child(r); BVH::prefetch(cur,types);
-          assert(cur != BVH::emptyNode);
-          if (likely(mask == 0)) return;
+        /* no distance sorting, remaining children are visited in
+         * storage order, which has children of larger surface area
+         * first, as these more likely contain an occluder */
+        do {
           assert(stackPtr < stackEnd);
-          *stackPtr = cur; stackPtr++;
-        }
+          r = bsr(mask); mask = btc(mask,r);
+          NodeRef c = node->child(r); BVH::prefetch(c,types);
+          assert(c != BVH::emptyNode);
+          *stackPtr = c; stackPtr++;
+        } while (mask);
       }
     };
   }
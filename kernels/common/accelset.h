@@ -122,7 +122,7 @@ namespace embree
 
       /*! calculates the linear bounds of the i'th primitive for the specified time range */
       __forceinline LBBox3fa linearBounds(size_t primID, const BBox1f& dt) const {
-        return LBBox3fa([&] (size_t itime) { return bounds(primID, itime); }, dt, time_range, fnumTimeSegments);
+        return linearTimeBounds([&] (size_t itime) { return bounds(primID, itime); }, dt);
       }
       
       /*! calculates the linear bounds of the i'th primitive for the specified time range */
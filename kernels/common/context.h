@@ -14,8 +14,8 @@ namespace embree
   struct IntersectContext
   {
   public:
-    __forceinline IntersectContext(Scene* scene, RTCIntersectContext* user_context)
-      : scene(scene), user(user_context) {}
+    __forceinline IntersectContext(Scene* scene, RTCIntersectContext* user_context, RTCRayMultiHit* multiHit = nullptr)
+      : scene(scene), user(user_context), multiHit(multiHit) {}
 
     __forceinline bool hasContextFilter() const {
       return user->filter != nullptr;
@@ -28,12 +28,64 @@ namespace embree
     __forceinline bool isIncoherent() const {
       return embree::isIncoherent(user->flags);
     }
+
+    /*! stores a hit of a multi-hit query in the sorted hit array and
+     *  returns the distance the ray can get shortened to */
+    float recordHit(float tfar, float t, const Vec3fa& Ng, float u, float v, unsigned int geomID, unsigned int primID) const
+    {
+      RTCRayMultiHit* mh = multiHit;
+
+      /* ignore duplicated hits of primitives that are referenced multiple times */
+      for (unsigned int i=0; i<mh->hitCount; i++)
+      {
+        if (mh->t[i] != t || mh->hits[i].geomID != geomID || mh->hits[i].primID != primID) continue;
+        bool sameInstance = true;
+        for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+          sameInstance &= mh->hits[i].instID[l] == user->instID[l];
+        if (sameInstance) return tfar;
+      }
+      mh->totalHitCount++;
+
+      /* insert hit at sorted position, the farthest hit gets dropped when the array is full */
+      unsigned int i = mh->hitCount;
+      if (i == mh->maxHitCount) {
+        if (t >= mh->t[i-1]) goto done;
+        i--;
+      }
+      else mh->hitCount++;
+
+      for (; i>0 && mh->t[i-1] > t; i--) {
+        mh->t[i] = mh->t[i-1];
+        mh->hits[i] = mh->hits[i-1];
+      }
+      mh->t[i] = t;
+      mh->hits[i].Ng_x = Ng.x;
+      mh->hits[i].Ng_y = Ng.y;
+      mh->hits[i].Ng_z = Ng.z;
+      mh->hits[i].u = u;
+      mh->hits[i].v = v;
+      mh->hits[i].primID = primID;
+      mh->hits[i].geomID = geomID;
+      for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+        mh->hits[i].instID[l] = user->instID[l];
+
+    done:
+      /* closest hits mode can ignore everything behind the farthest hit once the array is full */
+      if (mh->mode == RTC_MULTI_HIT_MODE_CLOSEST && mh->hitCount == mh->maxHitCount)
+        return min(tfar,mh->t[mh->hitCount-1]);
+      return tfar;
+    }
     
   public:
     Scene* scene;
     RTCIntersectContext* user;
+    RTCRayMultiHit* multiHit; //!< hit array of multi-hit queries, nullptr for standard queries
   };
 
+  /* Macro to gather traversal statistics if enabled in the user context */
+#define TRAV_STAT(context,counter,x) \
+  if (unlikely((context)->user->stats)) (context)->user->stats->counter += (unsigned int)(x);
+
   template<int M, typename Geometry>
       __forceinline Vec4vf<M> enlargeRadiusToMinWidth(const IntersectContext* context, const Geometry* geom, const Vec3vf<M>& ray_org, const Vec4vf<M>& v)
     {
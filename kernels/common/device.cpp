@@ -5,6 +5,8 @@
 #include "../hash.h"
 #include "scene_triangle_mesh.h"
 #include "scene_user_geometry.h"
+#include "scene_lazy_geometry.h"
+#include "scene.h"
 #include "scene_instance.h"
 #include "scene_curves.h"
 #include "scene_subdiv_mesh.h"
@@ -37,6 +39,7 @@ namespace embree
   static std::map<Device*,size_t> g_num_threads_map;
 
   Device::Device (const char* cfg)
+    : bytesAllocated(0), lazyClock(0), memoryBudget(std::numeric_limits<size_t>::max())
   {
     /* check that CPU supports lowest ISA */
     if (!hasISA(ISA)) {
@@ -69,6 +72,9 @@ namespace embree
     /*! set tessellation cache size */
     setCacheSize( State::tessellation_cache_size );
 
+    /*! set memory budget for lazy geometries */
+    memoryBudget = State::lazy_memory_budget;
+
     /*! enable some floating point exceptions to catch bugs */
     if (State::float_exceptions)
     {
@@ -298,6 +304,49 @@ namespace embree
         }
       }
     }
+    bytesAllocated += bytes;
+  }
+
+  const char* Device::memoryFileDirectory(size_t bytes)
+  {
+    if (State::out_of_core_dir == "" || bytes < State::out_of_core_threshold)
+      return nullptr;
+    return State::out_of_core_dir.c_str();
+  }
+
+  void Device::registerLazyGeometry(LazyGeometry* geometry)
+  {
+    Lock<MutexSys> lock(lazyMutex);
+    lazyGeometries.push_back(geometry);
+  }
+
+  void Device::unregisterLazyGeometry(LazyGeometry* geometry)
+  {
+    Lock<MutexSys> lock(lazyMutex);
+    auto i = std::find(lazyGeometries.begin(),lazyGeometries.end(),geometry);
+    if (i != lazyGeometries.end()) lazyGeometries.erase(i);
+  }
+
+  void Device::enforceLazyMemoryBudget()
+  {
+    while (size_t(max(ssize_t(0),bytesAllocated.load())) > memoryBudget.load())
+    {
+      /* the evicted scene gets released after the lock is freed, as it may itself contain lazy geometries */
+      Ref<Scene> evicted = nullptr;
+      {
+        Lock<MutexSys> lock(lazyMutex);
+        LazyGeometry* lru = nullptr;
+        for (LazyGeometry* geometry : lazyGeometries)
+        {
+          if (!geometry->isEvictable()) continue;
+          if (lru == nullptr || geometry->getLastUse() < lru->getLastUse())
+            lru = geometry;
+        }
+        if (lru == nullptr) return;
+        evicted = lru->evict();
+        if (evicted) lru->invokeEvictFunction();
+      }
+    }
   }
 
   size_t getMaxNumThreads()
@@ -378,6 +427,16 @@ namespace embree
     case 1000003: debug_int3 = val; return;
     }
 
+    switch (prop)
+    {
+    case RTC_DEVICE_PROPERTY_MEMORY_BUDGET:
+      memoryBudget = val < 0 ? std::numeric_limits<size_t>::max() : size_t(val);
+      enforceLazyMemoryBudget();
+      return;
+
+    default: break;
+    }
+
     throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "unknown writable property");
   }
 
@@ -409,6 +468,9 @@ namespace embree
     case RTC_DEVICE_PROPERTY_VERSION_PATCH: return RTC_VERSION_PATCH;
     case RTC_DEVICE_PROPERTY_VERSION      : return RTC_VERSION;
 
+    case RTC_DEVICE_PROPERTY_MEMORY_BUDGET: return memoryBudget == std::numeric_limits<size_t>::max() ? -1 : ssize_t(memoryBudget);
+    case RTC_DEVICE_PROPERTY_MEMORY_USAGE : return bytesAllocated;
+
 #if defined(EMBREE_TARGET_SIMD4) && defined(EMBREE_RAY_PACKETS)
     case RTC_DEVICE_PROPERTY_NATIVE_RAY4_SUPPORTED:  return hasISA(SSE2);
 #else
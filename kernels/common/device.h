@@ -11,6 +11,7 @@ namespace embree
 {
   class BVH4Factory;
   class BVH8Factory;
+  struct LazyGeometry;
 
   class Device : public State, public MemoryMonitorInterface
   {
@@ -45,6 +46,9 @@ namespace embree
     /*! invokes the memory monitor callback */
     void memoryMonitor(ssize_t bytes, bool post);
 
+    /*! returns the directory to store large build arrays in when out of core builds are enabled */
+    const char* memoryFileDirectory(size_t bytes);
+
     /*! sets the size of the software cache. */
     void setCacheSize(size_t bytes);
 
@@ -54,6 +58,15 @@ namespace embree
     /*! gets a property */
     ssize_t getProperty(const RTCDeviceProperty prop);
 
+    /*! registers a lazy geometry for eviction */
+    void registerLazyGeometry(LazyGeometry* geometry);
+
+    /*! unregisters a lazy geometry */
+    void unregisterLazyGeometry(LazyGeometry* geometry);
+
+    /*! evicts least recently used lazy geometries until the allocated memory fits into the lazy memory budget */
+    void enforceLazyMemoryBudget();
+
   private:
 
     /*! initializes the tasking system */
@@ -81,5 +94,14 @@ namespace embree
     
     /* ray streams filter */
     RayStreamFilterFuncs rayStreamFilters;
+
+  public:
+    std::atomic<ssize_t> bytesAllocated;        //!< number of bytes currently allocated through this device
+    std::atomic<size_t> lazyClock;              //!< advances whenever a lazy geometry gets created
+    std::atomic<size_t> memoryBudget;           //!< bytes after which lazy geometries get evicted
+
+  private:
+    MutexSys lazyMutex;                         //!< protects the lazy geometry list
+    std::vector<LazyGeometry*> lazyGeometries;  //!< lazy geometries that may get evicted
   };
 }
@@ -78,6 +78,7 @@ namespace embree
     
     numTimeSteps = numTimeSteps_in;
     fnumTimeSegments = float(numTimeSteps_in-1);
+    time_steps.clear();
     
     Geometry::update();
   }
@@ -87,6 +88,28 @@ namespace embree
     time_range = range;
     Geometry::update();
   }
+
+  void Geometry::setTimeSteps (const float* times, unsigned int numTimeSteps_in)
+  {
+    if (times == nullptr) {
+      time_steps.clear();
+      Geometry::update();
+      return;
+    }
+    
+    if (numTimeSteps_in != numTimeSteps)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"number of times does not match number of time steps");
+    
+    if (times[0] != 0.0f || times[numTimeSteps-1] != 1.0f)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"first time step has to be at 0 and last time step at 1");
+    
+    for (unsigned int i=1; i<numTimeSteps; i++)
+      if (!(times[i-1] < times[i]))
+        throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"times of time steps have to be strictly increasing");
+    
+    time_steps.assign(times,times+numTimeSteps);
+    Geometry::update();
+  }
   
   void Geometry::update()
   {
@@ -277,6 +277,9 @@ namespace embree
     /*! sets motion blur time range */
     void setTimeRange (const BBox1f range);
 
+    /*! sets non-uniform times of the time steps relative to the time range, nullptr selects uniform time steps */
+    virtual void setTimeSteps (const float* times, unsigned int numTimeSteps_in);
+
     /*! sets number of vertex attributes */
     virtual void setVertexAttributeCount (unsigned int N) {
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
@@ -295,24 +298,68 @@ namespace embree
     }
 
     /* calculate time segment itime and fractional time ftime */
-    __forceinline int timeSegment(float time, float& ftime) const {
-      return getTimeSegment(time,time_range.lower,time_range.upper,fnumTimeSegments,ftime);
+    __forceinline int timeSegment(float time, float& ftime) const
+    {
+      if (likely(time_steps.empty()))
+        return getTimeSegment(time,time_range.lower,time_range.upper,fnumTimeSegments,ftime);
+      return nonUniformTimeSegment(time,ftime);
     }
 
     template<int N>
-      __forceinline vint<N> timeSegment(const vfloat<N>& time, vfloat<N>& ftime) const {
-      return getTimeSegment(time,vfloat<N>(time_range.lower),vfloat<N>(time_range.upper),vfloat<N>(fnumTimeSegments),ftime);
+      __forceinline vint<N> timeSegment(const vfloat<N>& time, vfloat<N>& ftime) const
+    {
+      if (likely(time_steps.empty()))
+        return getTimeSegment(time,vfloat<N>(time_range.lower),vfloat<N>(time_range.upper),vfloat<N>(fnumTimeSegments),ftime);
+
+      vint<N> itime;
+      for (size_t i=0; i<N; i++) {
+        float f; itime[i] = nonUniformTimeSegment(time[i],f); ftime[i] = f;
+      }
+      return itime;
     }
     
     /* calculate overlapping time segment range */
-    __forceinline range<int> timeSegmentRange(const BBox1f& range) const {
-      return getTimeSegmentRange(range,time_range,fnumTimeSegments);
+    __forceinline range<int> timeSegmentRange(const BBox1f& range) const
+    {
+      if (likely(time_steps.empty()))
+        return getTimeSegmentRange(range,time_range,fnumTimeSegments);
+
+      const float round_up   = 1.0f+2.0f*float(ulp);
+      const float round_down = 1.0f-2.0f*float(ulp);
+      const float lower = round_up  *(range.lower-time_range.lower)/time_range.size();
+      const float upper = round_down*(range.upper-time_range.lower)/time_range.size();
+      const int itime_lower = max(int(std::upper_bound(time_steps.begin(),time_steps.end(),lower)-time_steps.begin())-1,0);
+      const int itime_upper = min(int(std::lower_bound(time_steps.begin(),time_steps.end(),upper)-time_steps.begin()),int(numTimeSteps-1));
+      return make_range(itime_lower, itime_upper);
     }
 
     /* returns time that corresponds to time step */
-    __forceinline float timeStep(const int i) const {
+    __forceinline float timeStep(const int i) const
+    {
       assert(i>=0 && i<(int)numTimeSteps);
-      return time_range.lower + time_range.size()*float(i)/fnumTimeSegments;
+      if (likely(time_steps.empty()))
+        return time_range.lower + time_range.size()*float(i)/fnumTimeSegments;
+      return time_range.lower + time_range.size()*time_steps[i];
+    }
+
+    /* calculates the linear bounds for the time range dt from the bounds of the time steps */
+    template<typename BoundsFunc>
+      __forceinline LBBox3fa linearTimeBounds(const BoundsFunc& bounds, const BBox1f& dt) const
+    {
+      if (likely(time_steps.empty()))
+        return LBBox3fa(bounds,dt,time_range,fnumTimeSegments);
+      return LBBox3fa(bounds,dt,time_range,time_steps.data(),int(numTimeSteps-1));
+    }
+
+  private:
+
+    /* time segment lookup for non-uniform time steps */
+    __forceinline int nonUniformTimeSegment(float time, float& ftime) const
+    {
+      const float t = (time-time_range.lower)/time_range.size();
+      const int itime = clamp(int(std::upper_bound(time_steps.begin()+1,time_steps.end()-1,t)-time_steps.begin())-1,0,int(numTimeSteps-2));
+      ftime = (t-time_steps[itime])/(time_steps[itime+1]-time_steps[itime]);
+      return itime;
     }
     
     /*! for all geometries */
@@ -447,6 +494,11 @@ namespace embree
     /*! Set occlusion filter function for ray packets of size N. */
     virtual void setOcclusionFilterFunctionN (RTCFilterFunctionN filterN);
 
+    /*! Sets the bounds 16 bit quantized vertex positions are relative to. */
+    virtual void setVertexQuantizationBounds (const BBox3fa& bounds) {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry");
+    }
+
     /*! for instances only */
   public:
 
@@ -465,6 +517,11 @@ namespace embree
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
     }
 
+    /*! Sets double precision offset of the instance transformation */
+    virtual void setTransformOffset(const double* offset) {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
+
     /*! Returns the transformation of the instance */
     virtual AffineSpace3fa getTransform(float time) {
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
@@ -484,10 +541,23 @@ namespace embree
     }
     
     /*! Set occlusion function for ray packets of size N. */
-    virtual void setOccludedFunctionN (RTCOccludedFunctionN occluded) { 
-      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
+    virtual void setOccludedFunctionN (RTCOccludedFunctionN occluded) {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry");
     }
-    
+
+    /*! for lazy geometries only */
+  public:
+
+    /*! Set create function of lazy geometry */
+    virtual void setLazyCreateFunction (RTCLazyCreateFunction create) {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry");
+    }
+
+    /*! Set evict function of lazy geometry */
+    virtual void setLazyEvictFunction (RTCLazyEvictFunction evict) {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry");
+    }
+
     /*! Set point query function. */
     void setPointQueryFunction(RTCPointQueryFunction func);
 
@@ -563,6 +633,7 @@ namespace embree
     unsigned int numTimeSteps;  //!< number of time steps
     float fnumTimeSegments;     //!< number of time segments (precalculation)
     BBox1f time_range;          //!< motion blur time range
+    std::vector<float> time_steps; //!< non-uniform times of the time steps relative to time_range, empty for uniform time steps
     
     unsigned int mask;             //!< for masking out geometry
     unsigned int modCounter_ = 1; //!< counter for every modification - used to rebuild scenes when geo is modified
@@ -0,0 +1,98 @@
+// Copyright 2009-2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "default.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! Interpolates vertex data of many primitives of a triangle or
+     *  quad like geometry in SIMD across the elements. The setup
+     *  function returns for some element the byte offsets of its NV
+     *  vertices, the local u/v coordinates, and the scaling of the
+     *  derivatives. Each SIMD lane gathers the values of its own
+     *  vertices, thus all lanes are busy even for 3 component
+     *  data. */
+    template<int NV, typename Setup>
+      __forceinline void interpolateNx(const RTCInterpolateNArguments* const args, const char* src, const Setup& setup)
+    {
+      const int* valid_i = (const int*) args->valid;
+      const unsigned int N = args->N;
+      const unsigned int valueCount = args->valueCount;
+      float* P = args->P;
+      float* dPdu = args->dPdu;
+      float* dPdv = args->dPdv;
+      float* ddPdudu = args->ddPdudu;
+      float* ddPdvdv = args->ddPdvdv;
+      float* ddPdudv = args->ddPdudv;
+
+      for (unsigned int i=0; i<N; i+=VSIZEX)
+      {
+        /* setup all valid lanes, invalid lanes replicate some valid lane */
+        size_t ofs[NV][VSIZEX];
+        vfloatx u(zero), v(zero), su(zero), sv(zero);
+        __aligned(64) int active[VSIZEX];
+        int first = -1;
+        for (int k=0; k<VSIZEX; k++)
+        {
+          active[k] = 0;
+          if (i+k >= N || (valid_i && !valid_i[i+k])) continue;
+          size_t o[NV]; float lu, lv, lsu, lsv;
+          setup(args->primIDs[i+k],args->u[i+k],args->v[i+k],o,lu,lv,lsu,lsv);
+          for (size_t l=0; l<NV; l++) ofs[l][k] = o[l];
+          u[k] = lu; v[k] = lv; su[k] = lsu; sv[k] = lsv;
+          active[k] = -1;
+          if (first == -1) first = k;
+        }
+        if (first == -1) continue;
+        const vboolx valid = vintx::load(active) != vintx(zero);
+        for (int k=0; k<VSIZEX; k++) {
+          if (active[k]) continue;
+          for (size_t l=0; l<NV; l++) ofs[l][k] = ofs[l][first];
+        }
+
+        /* the quad case interpolates the triangle the u/v coordinates are located in */
+        const vboolx left = NV == 3 ? vboolx(true) : vboolx(u+v <= 1.0f);
+        const vfloatx U = select(left,u,vfloatx(1.0f)-u);
+        const vfloatx V = select(left,v,vfloatx(1.0f)-v);
+        const vfloatx W = 1.0f-U-V;
+
+        for (unsigned int j=0; j<valueCount; j++)
+        {
+          vfloatx p[NV];
+          for (size_t l=0; l<NV; l++)
+            for (int k=0; k<VSIZEX; k++)
+              p[l][k] = *(float*)&src[ofs[l][k]+j*sizeof(float)];
+
+          vfloatx Q0, Q1, Q2, du, dv;
+          if (NV == 3) {
+            Q0 = p[0]; Q1 = p[1]; Q2 = p[2];
+            du = Q1-Q0; dv = Q2-Q0;
+          } else {
+            Q0 = select(left,p[0],p[NV-2]);
+            Q1 = select(left,p[1],p[NV-1]);
+            Q2 = select(left,p[NV-1],p[1]);
+            du = select(left,Q1-Q0,Q0-Q1);
+            dv = select(left,Q2-Q0,Q0-Q2);
+          }
+
+          if (P) {
+            vfloatx::storeu(valid,P+j*N+i,madd(W,Q0,madd(U,Q1,V*Q2)));
+          }
+          if (dPdu) {
+            assert(dPdu); vfloatx::storeu(valid,dPdu+j*N+i,du*su);
+            assert(dPdv); vfloatx::storeu(valid,dPdv+j*N+i,dv*sv);
+          }
+          if (ddPdudu) {
+            assert(ddPdudu); vfloatx::storeu(valid,ddPdudu+j*N+i,vfloatx(zero));
+            assert(ddPdvdv); vfloatx::storeu(valid,ddPdvdv+j*N+i,vfloatx(zero));
+            assert(ddPdudv); vfloatx::storeu(valid,ddPdudv+j*N+i,vfloatx(zero));
+          }
+        }
+      }
+    }
+  }
+}
@@ -495,6 +495,32 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(scene);
   }
 
+  RTC_API void rtcIntersectMultiHit1 (RTCScene hscene, RTCIntersectContext* user_context, RTCRayMultiHit* rayhit) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcIntersectMultiHit1);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (((size_t)rayhit) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 16 bytes");   
+#endif
+    if (rayhit->maxHitCount == 0 || rayhit->maxHitCount > RTC_MAX_HIT_COUNT)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"maximal number of hits is out of range");
+    
+    STAT3(normal.travs,1,1,1);
+    rayhit->hitCount = 0;
+    rayhit->totalHitCount = 0;
+    
+    /* the hits get gathered in the hit array, the ray itself stays unmodified */
+    RTCRayHit tmp;
+    tmp.ray = rayhit->ray;
+    tmp.hit.geomID = RTC_INVALID_GEOMETRY_ID;
+    IntersectContext context(scene,user_context,rayhit);
+    scene->intersectors.intersect(tmp,&context);
+    RTC_CATCH_END2(scene);
+  }
+
   RTC_API void rtcIntersect4 (const int* valid, RTCScene hscene, RTCIntersectContext* user_context, RTCRayHit4* rayhit) 
   {
     Scene* scene = (Scene*) hscene;
@@ -1114,6 +1140,17 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcSetGeometryTransformOffset(RTCGeometry hgeometry, const double* offset)
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryTransformOffset);
+    RTC_VERIFY_HANDLE(hgeometry);
+    RTC_VERIFY_HANDLE(offset);
+    geometry->setTransformOffset(offset);
+    RTC_CATCH_END2(geometry);
+  }
+
   RTC_API void rtcGetGeometryTransform(RTCGeometry hgeometry, float time, RTCFormat format, void* xfm)
   {
     Geometry* geometry = (Geometry*) hgeometry;
@@ -1291,6 +1328,18 @@ RTC_NAMESPACE_BEGIN;
 #endif
     }
 
+    case RTC_GEOMETRY_TYPE_LAZY:
+    {
+#if defined(EMBREE_GEOMETRY_USER)
+      createLazyGeometryTy createLazyGeometry = nullptr;
+      SELECT_SYMBOL_DEFAULT_AVX_AVX2_AVX512KNL_AVX512SKX(device->enabled_cpu_features,createLazyGeometry);
+      Geometry* geom = createLazyGeometry(device);
+      return (RTCGeometry) geom->refInc();
+#else
+      throw_RTCError(RTC_ERROR_UNKNOWN,"RTC_GEOMETRY_TYPE_LAZY is not supported");
+#endif
+    }
+
     case RTC_GEOMETRY_TYPE_GRID:
     {
 #if defined(EMBREE_GEOMETRY_GRID)
@@ -1353,6 +1402,16 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcSetGeometryTimeSteps(RTCGeometry hgeometry, const float* times, unsigned int timeStepCount)
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryTimeSteps);
+    RTC_VERIFY_HANDLE(hgeometry);
+    geometry->setTimeSteps(times,timeStepCount);
+    RTC_CATCH_END2(geometry);
+  }
+
   RTC_API void rtcSetGeometryVertexAttributeCount(RTCGeometry hgeometry, unsigned int N)
   {
     Geometry* geometry = (Geometry*) hgeometry;
@@ -1413,6 +1472,18 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcSetGeometryVertexQuantizationBounds (RTCGeometry hgeometry, const RTCBounds* bounds)
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryVertexQuantizationBounds);
+    RTC_VERIFY_HANDLE(hgeometry);
+    RTC_VERIFY_HANDLE(bounds);
+    geometry->setVertexQuantizationBounds(BBox3fa(Vec3fa(bounds->lower_x,bounds->lower_y,bounds->lower_z),
+                                                  Vec3fa(bounds->upper_x,bounds->upper_y,bounds->upper_z)));
+    RTC_CATCH_END2(geometry);
+  }
+
   RTC_API void rtcSetGeometrySubdivisionMode (RTCGeometry hgeometry, unsigned topologyID, RTCSubdivisionMode mode) 
   {
     Geometry* geometry = (Geometry*) hgeometry;
@@ -1661,6 +1732,26 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcSetGeometryLazyCreateFunction (RTCGeometry hgeometry, RTCLazyCreateFunction create)
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryLazyCreateFunction);
+    RTC_VERIFY_HANDLE(hgeometry);
+    geometry->setLazyCreateFunction(create);
+    RTC_CATCH_END2(geometry);
+  }
+
+  RTC_API void rtcSetGeometryLazyEvictFunction (RTCGeometry hgeometry, RTCLazyEvictFunction evict)
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryLazyEvictFunction);
+    RTC_VERIFY_HANDLE(hgeometry);
+    geometry->setLazyEvictFunction(evict);
+    RTC_CATCH_END2(geometry);
+  }
+
   RTC_API void rtcSetGeometryIntersectFilterFunction (RTCGeometry hgeometry, RTCFilterFunctionN filter) 
   {
     Geometry* geometry = (Geometry*) hgeometry;
@@ -1705,6 +1796,16 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcInterpolateBatch(const RTCInterpolateBatchArguments* const args)
+  {
+    Scene* scene = (Scene*) args->scene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcInterpolateBatch);
+    RTC_VERIFY_HANDLE(args->scene);
+    scene->interpolateBatch(args);
+    RTC_CATCH_END2(scene);
+  }
+
   RTC_API void rtcCommitGeometry (RTCGeometry hgeometry)
   {
     Geometry* geometry = (Geometry*) hgeometry;
@@ -1756,6 +1857,17 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(scene);
   }
 
+  RTC_API void rtcPrepareSceneGeometry (RTCScene hscene, unsigned int geomID)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcPrepareSceneGeometry);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_GEOMID(geomID);
+    scene->prepareGeometry(geomID);
+    RTC_CATCH_END2(scene);
+  }
+
   RTC_API void rtcRetainGeometry (RTCGeometry hgeometry)
   {
     Geometry* geometry = (Geometry*) hgeometry;
@@ -6,6 +6,8 @@
 #include "../bvh/bvh4_factory.h"
 #include "../bvh/bvh8_factory.h"
 #include "../../common/algorithms/parallel_reduce.h"
+#include "../../common/algorithms/parallel_prefix_sum.h"
+#include "../../common/algorithms/parallel_sort.h"
 
 namespace embree
 {
@@ -346,6 +348,7 @@ namespace embree
   void Scene::createHairAccel()
   {
 #if defined(EMBREE_GEOMETRY_CURVE) || defined(EMBREE_GEOMETRY_POINT)
+    const Geometry::GTypeMask gtype = hairTypeMask();
     if (device->hair_accel == "default")
     {
       int mode = 2*(int)isCompactAccel() + 1*(int)isRobustAccel();
@@ -353,28 +356,29 @@ namespace embree
       if (device->canUseAVX2()) // only enable on HSW machines, for SNB this codepath is slower
       {
         switch (mode) {
-        case /*0b00*/ 0: accels_add(device->bvh8_factory->BVH8OBBVirtualCurve8v(this,BVHFactory::IntersectVariant::FAST)); break;
-        case /*0b01*/ 1: accels_add(device->bvh8_factory->BVH8OBBVirtualCurve8v(this,BVHFactory::IntersectVariant::ROBUST)); break;
-        case /*0b10*/ 2: accels_add(device->bvh4_factory->BVH4OBBVirtualCurve8i(this,BVHFactory::IntersectVariant::FAST)); break;
-        case /*0b11*/ 3: accels_add(device->bvh4_factory->BVH4OBBVirtualCurve8i(this,BVHFactory::IntersectVariant::ROBUST)); break;
+        case /*0b00*/ 0: accels_add(device->bvh8_factory->BVH8OBBVirtualCurve8v(this,gtype,BVHFactory::IntersectVariant::FAST)); break;
+        case /*0b01*/ 1: accels_add(device->bvh8_factory->BVH8OBBVirtualCurve8v(this,gtype,BVHFactory::IntersectVariant::ROBUST)); break;
+        case /*0b10*/ 2: accels_add(device->bvh4_factory->BVH4OBBVirtualCurve8i(this,gtype,BVHFactory::IntersectVariant::FAST)); break;
+        case /*0b11*/ 3: accels_add(device->bvh4_factory->BVH4OBBVirtualCurve8i(this,gtype,BVHFactory::IntersectVariant::ROBUST)); break;
         }
       }
       else
 #endif
       {
         switch (mode) {
-        case /*0b00*/ 0: accels_add(device->bvh4_factory->BVH4OBBVirtualCurve4v(this,BVHFactory::IntersectVariant::FAST)); break;
-        case /*0b01*/ 1: accels_add(device->bvh4_factory->BVH4OBBVirtualCurve4v(this,BVHFactory::IntersectVariant::ROBUST)); break;
-        case /*0b10*/ 2: accels_add(device->bvh4_factory->BVH4OBBVirtualCurve4i(this,BVHFactory::IntersectVariant::FAST)); break;
-        case /*0b11*/ 3: accels_add(device->bvh4_factory->BVH4OBBVirtualCurve4i(this,BVHFactory::IntersectVariant::ROBUST)); break;
+        case /*0b00*/ 0: accels_add(device->bvh4_factory->BVH4OBBVirtualCurve4v(this,gtype,BVHFactory::IntersectVariant::FAST)); break;
+        case /*0b01*/ 1: accels_add(device->bvh4_factory->BVH4OBBVirtualCurve4v(this,gtype,BVHFactory::IntersectVariant::ROBUST)); break;
+        case /*0b10*/ 2: accels_add(device->bvh4_factory->BVH4OBBVirtualCurve4i(this,gtype,BVHFactory::IntersectVariant::FAST)); break;
+        case /*0b11*/ 3: accels_add(device->bvh4_factory->BVH4OBBVirtualCurve4i(this,gtype,BVHFactory::IntersectVariant::ROBUST)); break;
         }
       }
     }
-    else if (device->hair_accel == "bvh4obb.virtualcurve4v" ) accels_add(device->bvh4_factory->BVH4OBBVirtualCurve4v(this,BVHFactory::IntersectVariant::FAST));
-    else if (device->hair_accel == "bvh4obb.virtualcurve4i" ) accels_add(device->bvh4_factory->BVH4OBBVirtualCurve4i(this,BVHFactory::IntersectVariant::FAST));
+    else if (device->hair_accel == "bvh4obb.virtualcurve4v" ) accels_add(device->bvh4_factory->BVH4OBBVirtualCurve4v(this,gtype,BVHFactory::IntersectVariant::FAST));
+    else if (device->hair_accel == "bvh4obb.virtualcurve4i" ) accels_add(device->bvh4_factory->BVH4OBBVirtualCurve4i(this,gtype,BVHFactory::IntersectVariant::FAST));
+    else if (device->hair_accel == "bvh4obb.virtualcurve4c" ) accels_add(device->bvh4_factory->BVH4OBBVirtualCurve4c(this,gtype,BVHFactory::IntersectVariant::FAST));
 #if defined (EMBREE_TARGET_SIMD8)
-    else if (device->hair_accel == "bvh8obb.virtualcurve8v" ) accels_add(device->bvh8_factory->BVH8OBBVirtualCurve8v(this,BVHFactory::IntersectVariant::FAST));
-    else if (device->hair_accel == "bvh4obb.virtualcurve8i" ) accels_add(device->bvh4_factory->BVH4OBBVirtualCurve8i(this,BVHFactory::IntersectVariant::FAST));
+    else if (device->hair_accel == "bvh8obb.virtualcurve8v" ) accels_add(device->bvh8_factory->BVH8OBBVirtualCurve8v(this,gtype,BVHFactory::IntersectVariant::FAST));
+    else if (device->hair_accel == "bvh4obb.virtualcurve8i" ) accels_add(device->bvh4_factory->BVH4OBBVirtualCurve8i(this,gtype,BVHFactory::IntersectVariant::FAST));
 #endif
     else throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"unknown hair acceleration structure "+device->hair_accel);
 #endif
@@ -408,6 +412,38 @@ namespace embree
 #endif
   }
 
+  bool Scene::usePointAccel() const
+  {
+#if defined(EMBREE_GEOMETRY_POINT)
+    /* by default only dynamic point clouds use the fast to build point acceleration structure */
+    if (device->point_accel == "default") return quality_flags == RTC_BUILD_QUALITY_LOW;
+    return device->point_accel != "none";
+#else
+    return false;
+#endif
+  }
+
+  void Scene::createPointAccel()
+  {
+#if defined(EMBREE_GEOMETRY_POINT)
+    BVHFactory::IntersectVariant ivariant = isRobustAccel() ? BVHFactory::IntersectVariant::ROBUST : BVHFactory::IntersectVariant::FAST;
+    if (device->point_accel == "default")
+    {
+#if defined (EMBREE_TARGET_SIMD8)
+      if (device->canUseAVX2() && !isCompactAccel())
+        accels_add(device->bvh4_factory->BVH4Point8v(this,ivariant));
+      else
+#endif
+        accels_add(device->bvh4_factory->BVH4Point4v(this,ivariant));
+    }
+    else if (device->point_accel == "bvh4.point4v") accels_add(device->bvh4_factory->BVH4Point4v(this,BVHFactory::IntersectVariant::FAST));
+#if defined (EMBREE_TARGET_SIMD8)
+    else if (device->point_accel == "bvh4.point8v") accels_add(device->bvh4_factory->BVH4Point8v(this,BVHFactory::IntersectVariant::FAST));
+#endif
+    else throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"unknown point acceleration structure "+device->point_accel);
+#endif
+  }
+
   void Scene::createSubdivAccel()
   {
 #if defined(EMBREE_GEOMETRY_SUBDIVISION)
@@ -595,12 +631,13 @@ namespace embree
 
   void Scene::createGridMBAccel()
   {
+    BVHFactory::IntersectVariant ivariant = isRobustAccel() ? BVHFactory::IntersectVariant::ROBUST : BVHFactory::IntersectVariant::FAST;
 #if defined(EMBREE_GEOMETRY_GRID)
     if (device->grid_accel_mb == "default")
     {
-      accels_add(device->bvh4_factory->BVH4GridMB(this,BVHFactory::BuildVariant::STATIC));
+      accels_add(device->bvh4_factory->BVH4GridMB(this,BVHFactory::BuildVariant::STATIC,ivariant));
     }
-    else if (device->grid_accel_mb == "bvh4mb.grid") accels_add(device->bvh4_factory->BVH4GridMB(this));
+    else if (device->grid_accel_mb == "bvh4mb.grid") accels_add(device->bvh4_factory->BVH4GridMB(this,BVHFactory::BuildVariant::STATIC,ivariant));
     else throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"unknown grid mb accel "+device->grid_accel);
 #endif
 
@@ -639,6 +676,141 @@ namespace embree
     return geomID;
   }
 
+  void Scene::prepareGeometry(unsigned geomID)
+  {
+    Ref<Geometry> geometry = nullptr;
+    {
+#if defined(__aarch64__) && defined(BUILD_IOS)
+      std::scoped_lock lock(geometriesMutex);
+#else
+      Lock<SpinLock> lock(geometriesMutex);
+#endif
+      if (geomID >= geometries.size() || geometries[geomID] == null)
+        throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid geometry ID");
+      geometry = geometries[geomID];
+    }
+
+    if (geometry->state != (unsigned)Geometry::State::COMMITTED)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"geometry has to get committed before it can get prepared");
+
+    /* motion blur build primitives depend on the time range of the BVH, thus get generated during the commit */
+    if (!geometry->isEnabled() || geometry->numTimeSteps != 1)
+      return;
+
+    std::unique_ptr<PreparedPrimRefs> prepared(new PreparedPrimRefs(device,geometry.ptr));
+
+    ParallelPrefixSumState<PrimInfo> pstate;
+    PrimInfo pinfo = parallel_prefix_sum( pstate, size_t(0), geometry->size(), size_t(1024), PrimInfo(empty), [&](const range<size_t>& r, const PrimInfo& base) -> PrimInfo {
+        return geometry->createPrimRefArray(prepared->prims,r,r.begin(),geomID);
+      }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
+
+    /* if some primitives got filtered out, run again to compact the array */
+    if (pinfo.size() != prepared->prims.size())
+    {
+      pinfo = parallel_prefix_sum( pstate, size_t(0), geometry->size(), size_t(1024), PrimInfo(empty), [&](const range<size_t>& r, const PrimInfo& base) -> PrimInfo {
+          return geometry->createPrimRefArray(prepared->prims,r,base.size(),geomID);
+        }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
+    }
+    prepared->pinfo = pinfo;
+
+    Lock<MutexSys> lock(preparedPrimRefsMutex);
+    if (geomID >= preparedPrimRefs.size()) preparedPrimRefs.resize(geomID+1);
+    preparedPrimRefs[geomID] = std::move(prepared);
+  }
+
+  void Scene::interpolateBatch(const RTCInterpolateBatchArguments* const args)
+  {
+    const int* valid = (const int*) args->valid;
+    const unsigned int N = args->N;
+    const unsigned int valueCount = args->valueCount;
+    if (valueCount > 256) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"maximally 256 floating point values can be interpolated per vertex");
+
+    /* element index sorted by geometry and primitive */
+    struct KeyIndex
+    {
+      __forceinline operator uint64_t() const { return key; }
+      uint64_t key;
+      unsigned int index;
+    };
+
+    size_t numValid = 0;
+    std::vector<KeyIndex> items(N), temp(N);
+    for (unsigned int i=0; i<N; i++)
+    {
+      if (valid && !valid[i]) continue;
+      const unsigned int geomID = args->geomIDs[i];
+      if (geomID >= size() || get(geomID) == nullptr)
+        throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid geometry ID");
+      items[numValid].key = (uint64_t(geomID) << 32) | uint64_t(args->primIDs[i]);
+      items[numValid].index = i;
+      numValid++;
+    }
+    radix_sort_u64(items.data(),temp.data(),numValid);
+
+    /* split the sorted elements into blocks of a single geometry */
+    static const size_t blockSize = 256;
+    std::vector<range<size_t>> blocks;
+    for (size_t b=0; b<numValid; )
+    {
+      size_t e = b+1;
+      while (e < numValid && e-b < blockSize && (items[e].key >> 32) == (items[b].key >> 32)) e++;
+      blocks.push_back(range<size_t>(b,e));
+      b = e;
+    }
+
+    /* interpolate each block with one call to the geometry and scatter the results back */
+    parallel_for(blocks.size(), [&] (const size_t blockID)
+    {
+      const range<size_t> r = blocks[blockID];
+      const size_t M = r.size();
+      Geometry* geometry = get(unsigned(items[r.begin()].key >> 32));
+
+      /* arrays are padded as some geometries read beyond the last element */
+      __aligned(64) unsigned int primIDs[blockSize+16];
+      __aligned(64) float u[blockSize+16];
+      __aligned(64) float v[blockSize+16];
+      for (size_t i=0; i<blockSize+16; i++)
+      {
+        const KeyIndex& item = items[r.begin()+min(i,M-1)];
+        primIDs[i] = unsigned(item.key);
+        u[i] = args->u[item.index];
+        v[i] = args->v[item.index];
+      }
+
+      /* output arrays are padded as some geometries write full SIMD vectors */
+      float* dst[6] = { args->P, args->dPdu, args->dPdv, args->ddPdudu, args->ddPdvdv, args->ddPdudv };
+      std::vector<float> tmp[6];
+      for (size_t k=0; k<6; k++)
+        if (dst[k]) tmp[k].resize(valueCount*M+16);
+
+      RTCInterpolateNArguments nargs;
+      nargs.geometry = (RTCGeometry) geometry;
+      nargs.valid = nullptr;
+      nargs.primIDs = primIDs;
+      nargs.u = u;
+      nargs.v = v;
+      nargs.N = unsigned(M);
+      nargs.bufferType = args->bufferType;
+      nargs.bufferSlot = args->bufferSlot;
+      nargs.P       = dst[0] ? tmp[0].data() : nullptr;
+      nargs.dPdu    = dst[1] ? tmp[1].data() : nullptr;
+      nargs.dPdv    = dst[2] ? tmp[2].data() : nullptr;
+      nargs.ddPdudu = dst[3] ? tmp[3].data() : nullptr;
+      nargs.ddPdvdv = dst[4] ? tmp[4].data() : nullptr;
+      nargs.ddPdudv = dst[5] ? tmp[5].data() : nullptr;
+      nargs.valueCount = valueCount;
+      geometry->interpolateN(&nargs);
+
+      for (size_t k=0; k<6; k++)
+      {
+        if (!dst[k]) continue;
+        for (size_t j=0; j<valueCount; j++)
+          for (size_t i=0; i<M; i++)
+            dst[k][j*N+items[r.begin()+i].index] = tmp[k][j*M+i];
+      }
+    });
+  }
+
   void Scene::detachGeometry(size_t geomID)
   {
 #if defined(__aarch64__) && defined(BUILD_IOS)
@@ -662,6 +834,10 @@ namespace embree
     geometries[geomID] = null;
     vertices[geomID] = nullptr;
     geometryModCounters_[geomID] = 0;
+
+    Lock<MutexSys> prepared_lock(preparedPrimRefsMutex);
+    if (geomID < preparedPrimRefs.size())
+      preparedPrimRefs[geomID].reset();
   }
 
   void Scene::updateInterface()
@@ -721,8 +897,9 @@ namespace embree
       if (getNumPrimitives(GridMesh::geom_type,true)) createGridMBAccel();
       if (getNumPrimitives(SubdivMesh::geom_type,false)) createSubdivAccel();
       if (getNumPrimitives(SubdivMesh::geom_type,true)) createSubdivMBAccel();
-      if (getNumPrimitives(Geometry::MTY_CURVES,false)) createHairAccel();
+      if (getNumPrimitives(hairTypeMask(),false)) createHairAccel();
       if (getNumPrimitives(Geometry::MTY_CURVES,true)) createHairMBAccel();
+      if (getNumPrimitives(Points::geom_type,false) && usePointAccel()) createPointAccel();
       if (getNumPrimitives(UserGeometry::geom_type,false)) createUserGeometryAccel();
       if (getNumPrimitives(UserGeometry::geom_type,true)) createUserGeometryMBAccel();
       if (getNumPrimitives(Geometry::MTY_INSTANCE_CHEAP,false)) createInstanceAccel();
@@ -740,6 +917,9 @@ namespace embree
     /* build all hierarchies of this scene */
 	accels_build();
 
+    /* prepared build primitives got consumed by the build */
+    preparedPrimRefs.clear();
+
     /* make static geometry immutable */
     if (!isDynamicAccel()) {
       accels_immutable();
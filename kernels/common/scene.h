@@ -10,6 +10,7 @@
 #include "scene_triangle_mesh.h"
 #include "scene_quad_mesh.h"
 #include "scene_user_geometry.h"
+#include "scene_lazy_geometry.h"
 #include "scene_instance.h"
 #include "scene_curves.h"
 #include "scene_line_segments.h"
@@ -151,6 +152,7 @@ namespace embree
     void createQuadMBAccel();
     void createHairAccel();
     void createHairMBAccel();
+    void createPointAccel();
     void createSubdivAccel();
     void createSubdivMBAccel();
     void createUserGeometryAccel();
@@ -188,6 +190,28 @@ namespace embree
     
     /* bind geometry to the scene */
     unsigned int bind (unsigned geomID, Ref<Geometry> geometry);
+
+    /* generates the build primitives of a committed geometry ahead of the scene commit */
+    void prepareGeometry (unsigned geomID);
+
+    /* interpolates vertex data of many geometries, sorted by geometry and scattered back in original order */
+    void interpolateBatch (const RTCInterpolateBatchArguments* const args);
+
+    /* returns the build primitives prepared for some geometry if they are still up to date */
+    __forceinline const mvector<PrimRef>* getPreparedPrimRefs (size_t geomID, PrimInfo& pinfo) const
+    {
+      if (geomID >= preparedPrimRefs.size() || !preparedPrimRefs[geomID]) return nullptr;
+      const PreparedPrimRefs* prepared = preparedPrimRefs[geomID].get();
+      if (prepared->geometry != geometries[geomID].ptr) return nullptr;
+      if (prepared->modCounter != geometries[geomID]->getModCounter()) return nullptr;
+      pinfo = prepared->pinfo;
+      return &prepared->prims;
+    }
+
+    /* true if build primitives of some geometries got prepared */
+    __forceinline bool hasPreparedPrimRefs() const {
+      return preparedPrimRefs.size() != 0;
+    }
     
     /* determines if scene is modified */
     __forceinline bool isModified() const { return modified; }
@@ -258,6 +282,14 @@ namespace embree
     __forceinline bool isRobustAccel()  const { return scene_flags & RTC_SCENE_FLAG_ROBUST; }
     __forceinline bool isStaticAccel()  const { return !(scene_flags & RTC_SCENE_FLAG_DYNAMIC); }
     __forceinline bool isDynamicAccel() const { return scene_flags & RTC_SCENE_FLAG_DYNAMIC; }
+
+    /*! returns true if non motion blur points get stored in a separate point acceleration structure */
+    bool usePointAccel() const;
+
+    /*! returns the geometry types stored in the hair acceleration structure */
+    __forceinline Geometry::GTypeMask hairTypeMask() const {
+      return usePointAccel() ? Geometry::GTypeMask(Geometry::MTY_CURVES & ~Geometry::MTY_POINTS) : Geometry::MTY_CURVES;
+    }
     
     __forceinline bool hasContextFilterFunction() const {
       return scene_flags & RTC_SCENE_FLAG_CONTEXT_FILTER_FUNCTION;
@@ -292,6 +324,20 @@ namespace embree
     MutexSys buildMutex;
     SpinLock geometriesMutex;
     bool is_build;
+
+    /* build primitives of a geometry generated ahead of the scene commit */
+    struct PreparedPrimRefs
+    {
+      PreparedPrimRefs (Device* device, Geometry* geometry)
+        : prims(device,geometry->size()), pinfo(empty), geometry(geometry), modCounter(geometry->getModCounter()) {}
+
+      mvector<PrimRef> prims;     //!< build primitives, only the first pinfo.size() are valid
+      PrimInfo pinfo;             //!< info about the build primitives
+      Geometry* geometry;         //!< geometry the primitives got generated for
+      unsigned int modCounter;    //!< modification counter of the geometry when the primitives got generated
+    };
+    std::vector<std::unique_ptr<PreparedPrimRefs>> preparedPrimRefs;
+    MutexSys preparedPrimRefsMutex;
   private:
     bool modified;                   //!< true if scene got modified
 
@@ -30,7 +30,7 @@ namespace embree
   }
 
   CurveGeometry::CurveGeometry (Device* device, GType gtype)
-    : Geometry(device,gtype,0,1), tessellationRate(4)
+    : Geometry(device,gtype,0,1), tessellationRate(4), segments(device,0)
   {
     resizeBuffers(numTimeSteps);
   }
@@ -373,9 +373,77 @@ namespace embree
     if (getCurveBasis() == GTY_BASIS_HERMITE)
       tangents0 = tangents[0];
 
+    /* estimate how many linear segments approximate each curve, the intersectors reduce their subdivision depth accordingly */
+    if (device->hair_adaptive_subdivision && getCurveType() != GTY_SUBTYPE_ORIENTED_CURVE)
+    {
+      segments.resize(size());
+      parallel_for(size_t(0), size(), size_t(4096), [&] (const range<size_t>& r) {
+        for (size_t i=r.begin(); i<r.end(); i++)
+          segments[i] = estimateSegments(i);
+      });
+    }
+    else
+      segments.clear();
+
     Geometry::commit();
   }
 
+  uint8_t CurveGeometry::estimateSegments(size_t i) const
+  {
+    const size_t index = curve(i);
+    const unsigned int basis = getCurveBasis();
+    if (index+(basis == GTY_BASIS_HERMITE ? 2 : 4) > numVertices())
+      return 0;
+
+    float dev = 0.0f;
+    float rmin = inf;
+    for (size_t t=0; t<numTimeSteps; t++)
+    {
+      /* calculate control points of the equivalent cubic bezier curve, buffers may not be aligned */
+      auto vtx = [&] (size_t j) { return Vec3ff::loadu(vertices[t].getPtr(index+j)); };
+      auto tan = [&] (size_t j) { return Vec3ff::loadu(tangents[t].getPtr(index+j)); };
+      Vec3ff b0,b1,b2,b3;
+      if (basis == GTY_BASIS_HERMITE)
+      {
+        const Vec3ff p0 = vtx(0), t0 = tan(0);
+        const Vec3ff p1 = vtx(1), t1 = tan(1);
+        b0 = p0; b1 = madd(1.0f/3.0f,t0,p0); b2 = nmadd(1.0f/3.0f,t1,p1); b3 = p1;
+      }
+      else
+      {
+        const Vec3ff p0 = vtx(0), p1 = vtx(1);
+        const Vec3ff p2 = vtx(2), p3 = vtx(3);
+        if (basis == GTY_BASIS_BSPLINE) {
+          b0 = (1.0f/6.0f)*(p0+4.0f*p1+p2);
+          b1 = (1.0f/3.0f)*(2.0f*p1+p2);
+          b2 = (1.0f/3.0f)*(p1+2.0f*p2);
+          b3 = (1.0f/6.0f)*(p1+4.0f*p2+p3);
+        }
+        else if (basis == GTY_BASIS_CATMULL_ROM) {
+          b0 = p1; b1 = madd(1.0f/6.0f,p2-p0,p1); b2 = nmadd(1.0f/6.0f,p3-p1,p2); b3 = p2;
+        }
+        else {
+          b0 = p0; b1 = p1; b2 = p2; b3 = p3;
+        }
+      }
+
+      /* the distance of a cubic bezier curve to its linear
+       * interpolation using n segments is bounded by 3/4 of the
+       * largest second difference of its control points over n^2 */
+      const Vec3ff d0 = b0-2.0f*b1+b2;
+      const Vec3ff d1 = b1-2.0f*b2+b3;
+      dev = max(dev,0.75f*max(length(Vec3fa(d0))+abs(d0.w),length(Vec3fa(d1))+abs(d1.w)));
+      rmin = min(rmin,b0.w,b1.w,b2.w,b3.w);
+    }
+
+    /* the linear approximation should deviate by at most a small fraction of the curve radius */
+    const float maxError = 1.0f/16.0f;
+    if (!(rmin > 0.0f)) return 0;
+    const float n = ceil(sqrt(dev/(maxError*rmin)));
+    if (!(n <= 255.0f)) return 0;
+    return (uint8_t) max(n,1.0f);
+  }
+
 #endif
 
   namespace isa
@@ -847,17 +915,17 @@ namespace embree
 
       /*! calculates the linear bounds of the i'th primitive for the specified time range */
       __forceinline LBBox3fa linearBounds(size_t primID, const BBox1f& dt) const {
-        return LBBox3fa([&] (size_t itime) { return bounds(primID, itime); }, dt, this->time_range, fnumTimeSegments);
+        return this->linearTimeBounds([&] (size_t itime) { return bounds(primID, itime); }, dt);
       }
       
       /*! calculates the linear bounds of the i'th primitive for the specified time range */
       __forceinline LBBox3fa linearBounds(const LinearSpace3fa& space, size_t primID, const BBox1f& dt) const {
-        return LBBox3fa([&] (size_t itime) { return bounds(space, primID, itime); }, dt, this->time_range, fnumTimeSegments);
+        return this->linearTimeBounds([&] (size_t itime) { return bounds(space, primID, itime); }, dt);
       }
       
       /*! calculates the linear bounds of the i'th primitive for the specified time range */
       __forceinline LBBox3fa linearBounds(const Vec3fa& ofs, const float scale, const float r_scale0, const LinearSpace3fa& space, size_t primID, const BBox1f& dt) const {
-        return LBBox3fa([&] (size_t itime) { return bounds(ofs, scale, r_scale0, space, primID, itime); }, dt, this->time_range, fnumTimeSegments);
+        return this->linearTimeBounds([&] (size_t itime) { return bounds(ofs, scale, r_scale0, space, primID, itime); }, dt);
       }
       
       PrimInfo createPrimRefArray(mvector<PrimRef>& prims, const range<size_t>& r, size_t k, unsigned int geomID) const
@@ -318,8 +318,27 @@ namespace embree
       return clerp(curve0,curve1,ftime);
     }
 
+    /*! returns the number of linear segments that approximate the
+     *  i'th curve well enough, or 0 if this number is unknown */
+    __forceinline unsigned int numSegments(size_t i) const {
+      return i < segments.size() ? segments[i] : 0;
+    }
+
+    /*! returns the tessellation rate for the i'th flat curve, halved
+     *  while the curve still gets approximated well enough, such that
+     *  the sample points stay a subset of the ones used for bounding */
+    __forceinline int tessellationRateOf(size_t i) const
+    {
+      int N = tessellationRate;
+      const unsigned int n = numSegments(i);
+      if (n == 0) return N;
+      while ((N & 1) == 0 && unsigned(N/2) >= n) N /= 2;
+      return N;
+    }
+
   private:
     void resizeBuffers(unsigned int numSteps);
+    uint8_t estimateSegments(size_t i) const;
 
   public:
     BufferView<unsigned int> curves;        //!< array of curve indices
@@ -334,6 +353,7 @@ namespace embree
     BufferView<char> flags;                 //!< start, end flag per segment
     vector<BufferView<char>> vertexAttribs; //!< user buffers
     int tessellationRate;                   //!< tessellation rate for flat curve
+    mvector<uint8_t> segments;              //!< number of linear segments required per curve, empty if unknown
     float maxRadiusScale = 1.0;             //!< maximal min-width scaling of curve radii
   };
   
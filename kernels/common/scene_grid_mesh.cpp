@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "scene_grid_mesh.h"
+#include "interpolate_n.h"
 #include "scene.h"
 
 namespace embree
@@ -253,6 +254,49 @@ namespace embree
   
   namespace isa
   {
+    void GridMeshISA::interpolateN(const RTCInterpolateNArguments* const args)
+    {
+      if (args->valueCount > 256) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"maximally 256 floating point values can be interpolated per vertex");
+
+      /* calculate base pointer and stride */
+      const RTCBufferType bufferType = args->bufferType;
+      const unsigned int bufferSlot = args->bufferSlot;
+      assert((bufferType == RTC_BUFFER_TYPE_VERTEX && bufferSlot < numTimeSteps) ||
+             (bufferType == RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE && bufferSlot <= vertexAttribs.size()));
+      const char* src = nullptr; 
+      size_t stride = 0;
+      if (bufferType == RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE) {
+        src    = vertexAttribs[bufferSlot].getPtr();
+        stride = vertexAttribs[bufferSlot].getStride();
+      } else {
+        src    = vertices[bufferSlot].getPtr();
+        stride = vertices[bufferSlot].getStride();
+      }
+
+      interpolateNx<4>(args,src,[&] (unsigned primID, float U, float V, size_t ofs[4], float& u, float& v, float& su, float& sv)
+      {
+        /* clamp input u,v to [0;1] range */
+        U = max(min(U,1.0f),0.0f);
+        V = max(min(V,1.0f),0.0f);
+
+        const Grid& grid = grids[primID];
+        const int grid_width  = grid.resX-1;
+        const int grid_height = grid.resY-1;
+        const int iu = min((int)floor(U*grid_width ),grid_width);
+        const int iv = min((int)floor(V*grid_height),grid_height);
+        const unsigned int idx0 = grid.startVtxID + (iv+0)*grid.lineVtxOffset + iu;
+        const unsigned int idx1 = grid.startVtxID + (iv+1)*grid.lineVtxOffset + iu;
+        ofs[0] = size_t(idx0+0)*stride;
+        ofs[1] = size_t(idx0+1)*stride;
+        ofs[2] = size_t(idx1+1)*stride;
+        ofs[3] = size_t(idx1+0)*stride;
+        u = U*grid_width-float(iu);
+        v = V*grid_height-float(iv);
+        su = rcp(float(grid_width));
+        sv = rcp(float(grid_height));
+      });
+    }
+
     GridMesh* createGridMesh(Device* device) {
       return new GridMeshISA(device);
     }
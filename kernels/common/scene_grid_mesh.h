@@ -192,7 +192,55 @@ namespace embree
 
     /*! calculates the linear bounds of the i'th primitive for the specified time range */
     __forceinline LBBox3fa linearBounds(const Grid& g, size_t sx, size_t sy, const BBox1f& dt) const {
-      return LBBox3fa([&] (size_t itime) { return bounds(g,sx,sy,itime); }, dt, time_range, fnumTimeSegments);
+      return linearTimeBounds([&] (size_t itime) { return bounds(g,sx,sy,itime); }, dt);
+    }
+
+    /*! returns the normal of the subgrid starting at sx,sy, estimated from its diagonals */
+    __forceinline Vec3fa subGridNormal(const Grid& g, size_t sx, size_t sy) const
+    {
+      const size_t ex = min(sx+2,(size_t)g.resX-1);
+      const size_t ey = min(sy+2,(size_t)g.resY-1);
+      return cross(grid_vertex(g,ex,ey)-grid_vertex(g,sx,sy),grid_vertex(g,sx,ey)-grid_vertex(g,ex,sy));
+    }
+
+    /*! returns true if blocks of 2x2 subgrids of the grid should get
+     *  built as single primitives. This is the case if the normals of
+     *  all subgrids are within a cone of the specified angle, and if
+     *  the surface area of the merged bounds does not exceed the summed
+     *  surface area of the subgrid bounds by more than maxAreaRatio. */
+    __forceinline bool mergeSubGrids(const Grid& g, const float minCosAngle, const float maxAreaRatio) const
+    {
+      if (g.resX < 5 || g.resY < 5) return false;
+
+      Vec3fa Ng = zero;
+      for (size_t y=0; y<g.resY-1u; y+=2)
+        for (size_t x=0; x<g.resX-1u; x+=2)
+          Ng += subGridNormal(g,x,y);
+      if (dot(Ng,Ng) == 0.0f) return false;
+      Ng = normalize(Ng);
+
+      float subArea = 0.0f, mergedArea = 0.0f;
+      for (size_t y=0; y<g.resY-1u; y+=4)
+      {
+        for (size_t x=0; x<g.resX-1u; x+=4)
+        {
+          BBox3fa merged = empty;
+          for (size_t dy=0; dy<4 && y+dy<g.resY-1u; dy+=2)
+          {
+            for (size_t dx=0; dx<4 && x+dx<g.resX-1u; dx+=2)
+            {
+              const Vec3fa n = subGridNormal(g,x+dx,y+dy);
+              if (dot(n,Ng) < minCosAngle*length(n)) return false;
+              BBox3fa b = empty;
+              if (!buildBounds(g,x+dx,y+dy,b)) return false;
+              subArea += halfArea(b);
+              merged.extend(b);
+            }
+          }
+          mergedArea += halfArea(merged);
+        }
+      }
+      return mergedArea <= maxAreaRatio*subArea;
     }
 
   public:
@@ -208,6 +256,8 @@ namespace embree
     {
       GridMeshISA (Device* device)
         : GridMesh(device) {}
+
+      void interpolateN(const RTCInterpolateNArguments* const args);
     };
   }
 
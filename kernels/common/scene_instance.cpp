@@ -12,6 +12,8 @@ namespace embree
     : Geometry(device,Geometry::GTY_INSTANCE_CHEAP,1,numTimeSteps)
     , object(object)
     , local2world(nullptr)
+    , offset_hi(zero)
+    , offset_lo(zero)
   {
     if (object) object->refInc();
     gsubtype = GTY_SUBTYPE_INSTANCE_LINEAR;
@@ -48,6 +50,12 @@ namespace embree
     Geometry::setNumTimeSteps(numTimeSteps_in);
   }
 
+  void Instance::setTimeSteps (const float* times, unsigned int numTimeSteps_in)
+  {
+    if (times != nullptr)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry");
+  }
+
   void Instance::setInstancedScene(const Ref<Scene>& scene)
   {
     if (object) object->refDec();
@@ -109,6 +117,16 @@ namespace embree
     gsubtype = GTY_SUBTYPE_INSTANCE_QUATERNION;
   }
 
+  void Instance::setTransformOffset(const double* offset)
+  {
+    /* store the offset as sum of two floats */
+    const Vec3fa hi((float)offset[0],(float)offset[1],(float)offset[2]);
+    offset_hi = hi;
+    offset_lo = Vec3fa((float)(offset[0]-(double)hi.x),
+                       (float)(offset[1]-(double)hi.y),
+                       (float)(offset[2]-(double)hi.z));
+  }
+
   AffineSpace3fa Instance::getTransform(float time)
   {
     if (likely(numTimeSteps <= 1))
@@ -46,9 +46,11 @@ namespace embree
 
   public:
     virtual void setNumTimeSteps (unsigned int numTimeSteps) override;
+    virtual void setTimeSteps (const float* times, unsigned int numTimeSteps) override;
     virtual void setInstancedScene(const Ref<Scene>& scene) override;
     virtual void setTransform(const AffineSpace3fa& local2world, unsigned int timeStep) override;
     virtual void setQuaternionDecomposition(const AffineSpace3ff& qd, unsigned int timeStep) override;
+    virtual void setTransformOffset(const double* offset) override;
     virtual AffineSpace3fa getTransform(float time) override;
     virtual void setMask (unsigned mask) override;
     virtual void build() {}
@@ -61,8 +63,13 @@ namespace embree
     __forceinline BBox3fa bounds(size_t i) const {
       assert(i == 0);
       if (unlikely(gsubtype == GTY_SUBTYPE_INSTANCE_QUATERNION))
-        return xfmBounds(quaternionDecompositionToAffineSpace(local2world[0]),object->bounds.bounds());
-      return xfmBounds(local2world[0],object->bounds.bounds());
+        return offsetBounds(xfmBounds(quaternionDecompositionToAffineSpace(local2world[0]),object->bounds.bounds()));
+      return offsetBounds(xfmBounds(local2world[0],object->bounds.bounds()));
+    }
+
+    /*! moves bounds by the double precision offset of the instance */
+    __forceinline BBox3fa offsetBounds(const BBox3fa& b) const {
+      return BBox3fa(b.lower+offset_hi-abs(offset_lo),b.upper+offset_hi+abs(offset_lo));
     }
 
     /*! gets the bounds of the instanced scene */
@@ -82,7 +89,7 @@ namespace embree
     __forceinline LBBox3fa linearBounds(size_t i, const BBox1f& dt) const {
       assert(i == 0);
       LBBox3fa lbbox = nonlinearBounds(dt, time_range, fnumTimeSegments);
-      return lbbox;
+      return LBBox3fa(offsetBounds(lbbox.bounds0),offsetBounds(lbbox.bounds1));
     }
 
     /*! calculates the build bounds of the i'th item, if it's valid */
@@ -142,6 +149,23 @@ namespace embree
       return world2local0;
     }
 
+    /*! moves a world space ray origin, given as high and low-order part, into
+     *  the space of the instance transformation. Subtracting the double
+     *  precision offset before transforming keeps the origin accurate far
+     *  away from the world origin. */
+    __forceinline Vec3fa rebaseOrigin(const Vec3fa& org, const Vec3fa& org_lo) const {
+      return (org - offset_hi) + (org_lo - offset_lo);
+    }
+
+    template<int K>
+    __forceinline Vec3vf<K> rebaseOrigin(const Vec3vf<K>& org, const Vec3fa& org_lo) const
+    {
+      const Vec3fa d = org_lo - offset_lo;
+      return Vec3vf<K>((org.x - offset_hi.x) + d.x,
+                       (org.y - offset_hi.y) + d.y,
+                       (org.z - offset_hi.z) + d.z);
+    }
+
     __forceinline AffineSpace3fa getWorld2Local(float t) const {
       return rcp(getLocal2World(t));
     }
@@ -211,6 +235,8 @@ namespace embree
     Accel* object;                 //!< pointer to instanced acceleration structure
     AffineSpace3ff* local2world;   //!< transformation from local space to world space for each timestep (either normal matrix or quaternion decomposition)
     AffineSpace3fa world2local0;   //!< transformation from world space to local space for timestep 0
+    Vec3fa offset_hi;              //!< high-order part of the double precision offset of the transformation
+    Vec3fa offset_lo;              //!< low-order part of the double precision offset of the transformation
   };
 
   namespace isa
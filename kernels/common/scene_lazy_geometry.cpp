@@ -0,0 +1,228 @@
+// Copyright 2009-2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "scene_lazy_geometry.h"
+#include "scene.h"
+#include "instance_stack.h"
+
+namespace embree
+{
+#if defined(EMBREE_LOWEST_ISA)
+
+  LazyGeometry::LazyGeometry (Device* device)
+    : UserGeometry(device,1,1), createFunc(nullptr), evictFunc(nullptr), scene(nullptr), state(INVALID), numUsers(0), lastUse(0), numCreates(0)
+  {
+    intersectorN.intersect = intersectFunc;
+    intersectorN.occluded = occludedFunc;
+    device->registerLazyGeometry(this);
+  }
+
+  LazyGeometry::~LazyGeometry ()
+  {
+    /* unregister first such that the device cannot evict us while we get destroyed */
+    device->unregisterLazyGeometry(this);
+  }
+
+  void LazyGeometry::setNumPrimitives (unsigned int numPrimitives)
+  {
+    if (numPrimitives != 1)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"lazy geometries always contain a single primitive");
+  }
+
+  void LazyGeometry::setIntersectFunctionN (RTCIntersectFunctionN intersect) {
+    throw_RTCError(RTC_ERROR_INVALID_OPERATION,"intersect function of lazy geometry cannot get changed");
+  }
+
+  void LazyGeometry::setOccludedFunctionN (RTCOccludedFunctionN occluded) {
+    throw_RTCError(RTC_ERROR_INVALID_OPERATION,"occluded function of lazy geometry cannot get changed");
+  }
+
+  void LazyGeometry::setLazyCreateFunction (RTCLazyCreateFunction create)
+  {
+    Geometry::update();
+    createFunc = create;
+  }
+
+  void LazyGeometry::setLazyEvictFunction (RTCLazyEvictFunction evict) {
+    evictFunc = evict;
+  }
+
+  void LazyGeometry::invokeEvictFunction()
+  {
+    if (!evictFunc) return;
+    RTCLazyEvictFunctionArguments args;
+    args.geometryUserPtr = userPtr;
+    args.geometry = (RTCGeometry) this;
+    evictFunc(&args);
+  }
+
+  Scene* LazyGeometry::acquire()
+  {
+    numUsers++;
+
+    /* only write the use time when it changed to not share the cache line between threads */
+    const size_t clock = device->lazyClock.load(std::memory_order_relaxed);
+    if (lastUse.load(std::memory_order_relaxed) != clock)
+      lastUse.store(clock,std::memory_order_relaxed);
+
+    if (unlikely(state.load() != VALID))
+    {
+      try {
+        create();
+      } catch (...) {
+        numUsers--;
+        throw;
+      }
+    }
+    return scene.ptr;
+  }
+
+  void LazyGeometry::create()
+  {
+    while (true)
+    {
+      int s = state.load();
+      if (s == VALID)
+        return;
+
+      /* a single thread invokes the create callback */
+      if (s == INVALID)
+      {
+        if (!state.compare_exchange_strong(s,CREATE))
+          continue;
+
+        if (!createFunc)
+        {
+          state.store(INVALID);
+          throw_RTCError(RTC_ERROR_INVALID_OPERATION,"no lazy create function set");
+        }
+
+        try {
+          scene = new Scene(device);
+          RTCLazyCreateFunctionArguments args;
+          args.geometryUserPtr = userPtr;
+          args.geometry = (RTCGeometry) this;
+          args.scene = (RTCScene) scene.ptr;
+          createFunc(&args);
+        }
+        catch (...) {
+          scene = nullptr;
+          state.store(INVALID);
+          throw;
+        }
+
+        numCreates++;
+        device->lazyClock++;
+        state.store(COMMIT);
+        commitScene(true);
+        continue;
+      }
+
+      /* all threads that reach the geometry during commit help building it */
+      if (s == COMMIT) {
+        commitScene(false);
+        continue;
+      }
+
+      /* wait while another thread creates or evicts the geometry */
+      pause_cpu();
+      yield();
+    }
+  }
+
+  void LazyGeometry::commitScene(bool creator)
+  {
+    const bool join = device->getProperty(RTC_DEVICE_PROPERTY_JOIN_COMMIT_SUPPORTED);
+    if (!join && !creator) {
+      pause_cpu();
+      yield();
+      return;
+    }
+
+    /* on failure the state stays COMMIT and the next ray entering the geometry retries the commit */
+    scene->commit(join);
+
+    int s = COMMIT;
+    if (state.compare_exchange_strong(s,VALID))
+      device->enforceLazyMemoryBudget();
+  }
+
+  Ref<Scene> LazyGeometry::evict()
+  {
+    int s = VALID;
+    if (!state.compare_exchange_strong(s,EVICT))
+      return nullptr;
+
+    /* a thread may have started using the geometry in the meantime */
+    if (numUsers.load() != 0) {
+      state.store(VALID);
+      return nullptr;
+    }
+
+    Ref<Scene> evicted = scene;
+    scene = nullptr;
+    state.store(INVALID);
+    return evicted;
+  }
+
+  void LazyGeometry::intersectFunc(const RTCIntersectFunctionNArguments* args_i)
+  {
+    const IntersectFunctionNArguments* args = (const IntersectFunctionNArguments*) args_i;
+    LazyGeometry* geometry = (LazyGeometry*) args->geometry;
+    Scene* scene = geometry->acquire();
+
+    RTCIntersectContext* user_context = args->context;
+    if (likely(instance_id_stack::push(user_context, args->geomID)))
+    {
+      IntersectContext context(scene,user_context,args->internal_context->multiHit);
+      switch (args->N)
+      {
+      case 1 : scene->intersectors.intersect(*(RTCRayHit*)args->rayhit,&context); break;
+#if defined(EMBREE_RAY_PACKETS)
+      case 4 : scene->intersectors.intersect4 (args->valid,*(RTCRayHit4* )args->rayhit,&context); break;
+      case 8 : scene->intersectors.intersect8 (args->valid,*(RTCRayHit8* )args->rayhit,&context); break;
+      case 16: scene->intersectors.intersect16(args->valid,*(RTCRayHit16*)args->rayhit,&context); break;
+#endif
+      default: assert(false); break;
+      }
+      instance_id_stack::pop(user_context);
+    }
+
+    geometry->release();
+  }
+
+  void LazyGeometry::occludedFunc(const RTCOccludedFunctionNArguments* args_i)
+  {
+    const OccludedFunctionNArguments* args = (const OccludedFunctionNArguments*) args_i;
+    LazyGeometry* geometry = (LazyGeometry*) args->geometry;
+    Scene* scene = geometry->acquire();
+
+    RTCIntersectContext* user_context = args->context;
+    if (likely(instance_id_stack::push(user_context, args->geomID)))
+    {
+      IntersectContext context(scene,user_context);
+      switch (args->N)
+      {
+      case 1 : scene->intersectors.occluded(*(RTCRay*)args->ray,&context); break;
+#if defined(EMBREE_RAY_PACKETS)
+      case 4 : scene->intersectors.occluded4 (args->valid,*(RTCRay4* )args->ray,&context); break;
+      case 8 : scene->intersectors.occluded8 (args->valid,*(RTCRay8* )args->ray,&context); break;
+      case 16: scene->intersectors.occluded16(args->valid,*(RTCRay16*)args->ray,&context); break;
+#endif
+      default: assert(false); break;
+      }
+      instance_id_stack::pop(user_context);
+    }
+
+    geometry->release();
+  }
+
+#endif
+
+  namespace isa
+  {
+    LazyGeometry* createLazyGeometry(Device* device) {
+      return new LazyGeometryISA(device);
+    }
+  }
+}
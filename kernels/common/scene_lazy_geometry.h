@@ -0,0 +1,136 @@
+// Copyright 2009-2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "scene_user_geometry.h"
+
+namespace embree
+{
+  class Scene;
+
+  /*! Lazy geometry whose content is created and built on demand when
+   *  a ray first enters its bounds. The content is an instanced scene
+   *  created by a user callback, that may get evicted again when the
+   *  device exceeds its lazy memory budget. */
+  struct LazyGeometry : public UserGeometry
+  {
+    /*! type of this geometry */
+    static const Geometry::GTypeMask geom_type = Geometry::MTY_USER_GEOMETRY;
+
+    /*! state of the lazily created scene */
+    enum State
+    {
+      INVALID = 0,  //!< scene not yet created or evicted
+      CREATE  = 1,  //!< one thread executes the create callback
+      COMMIT  = 2,  //!< possibly multiple threads commit the scene
+      VALID   = 3,  //!< scene is ready for traversal
+      EVICT   = 4   //!< one thread releases the scene
+    };
+
+  public:
+    LazyGeometry (Device* device);
+    ~LazyGeometry ();
+
+  public:
+    virtual void setNumPrimitives (unsigned int numPrimitives);
+    virtual void setIntersectFunctionN (RTCIntersectFunctionN intersect);
+    virtual void setOccludedFunctionN (RTCOccludedFunctionN occluded);
+    virtual void setLazyCreateFunction (RTCLazyCreateFunction create);
+    virtual void setLazyEvictFunction (RTCLazyEvictFunction evict);
+
+  public:
+
+    /*! marks the geometry as used by the calling thread and makes sure the instanced scene is ready */
+    Scene* acquire();
+
+    /*! releases the geometry again */
+    __forceinline void release() {
+      numUsers--;
+    }
+
+    /*! detaches the instanced scene if the geometry is currently unused and returns it */
+    Ref<Scene> evict();
+
+    /*! notifies the user that the instanced scene got evicted */
+    void invokeEvictFunction();
+
+    /*! returns the last time this geometry got used */
+    __forceinline size_t getLastUse() const {
+      return lastUse.load(std::memory_order_relaxed);
+    }
+
+    /*! returns true if the instanced scene can get evicted */
+    __forceinline bool isEvictable() const {
+      return state.load() == VALID && numUsers.load() == 0;
+    }
+
+  private:
+    void create();
+    void commitScene(bool creator);
+
+    static void intersectFunc(const RTCIntersectFunctionNArguments* args);
+    static void occludedFunc(const RTCOccludedFunctionNArguments* args);
+
+  public:
+    RTCLazyCreateFunction createFunc;   //!< user callback that fills the instanced scene
+    RTCLazyEvictFunction evictFunc;     //!< user callback invoked after the instanced scene got evicted
+    Ref<Scene> scene;                   //!< lazily created instanced scene
+    std::atomic<int> state;             //!< state of the instanced scene
+    std::atomic<size_t> numUsers;       //!< number of threads currently traversing the instanced scene
+    std::atomic<size_t> lastUse;        //!< device lazy clock value of last use
+    std::atomic<size_t> numCreates;     //!< number of times the instanced scene got created
+  };
+
+  namespace isa
+  {
+    struct LazyGeometryISA : public LazyGeometry
+    {
+      LazyGeometryISA (Device* device)
+        : LazyGeometry(device) {}
+
+      PrimInfo createPrimRefArray(mvector<PrimRef>& prims, const range<size_t>& r, size_t k, unsigned int geomID) const
+      {
+        assert(r.begin() == 0);
+        assert(r.end()   == 1);
+
+        PrimInfo pinfo(empty);
+        BBox3fa b = empty;
+        if (!buildBounds(0,&b)) return pinfo;
+        const PrimRef prim(b,geomID,unsigned(0));
+        pinfo.add_center2(prim);
+        prims[k++] = prim;
+        return pinfo;
+      }
+
+      PrimInfo createPrimRefArrayMB(mvector<PrimRef>& prims, size_t itime, const range<size_t>& r, size_t k, unsigned int geomID) const
+      {
+        assert(r.begin() == 0);
+        assert(r.end()   == 1);
+
+        PrimInfo pinfo(empty);
+        BBox3fa b = empty;
+        if (!buildBounds(0,itime,b)) return pinfo;
+        const PrimRef prim(b,geomID,unsigned(0));
+        pinfo.add_center2(prim);
+        prims[k++] = prim;
+        return pinfo;
+      }
+
+      PrimInfoMB createPrimRefMBArray(mvector<PrimRefMB>& prims, const BBox1f& t0t1, const range<size_t>& r, size_t k, unsigned int geomID) const
+      {
+        assert(r.begin() == 0);
+        assert(r.end()   == 1);
+
+        PrimInfoMB pinfo(empty);
+        if (!valid(0, timeSegmentRange(t0t1))) return pinfo;
+        const PrimRefMB prim(linearBounds(0,t0t1),this->numTimeSegments(),this->time_range,this->numTimeSegments(),geomID,unsigned(0));
+        pinfo.add_primref(prim);
+        prims[k++] = prim;
+        return pinfo;
+      }
+    };
+  }
+
+  DECLARE_ISA_FUNCTION(LazyGeometry*, createLazyGeometry, Device*);
+}
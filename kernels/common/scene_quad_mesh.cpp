@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "scene_quad_mesh.h"
+#include "interpolate_n.h"
 #include "scene.h"
 
 namespace embree
@@ -238,6 +239,33 @@ namespace embree
 
   namespace isa
   {
+    void QuadMeshISA::interpolateN(const RTCInterpolateNArguments* const args)
+    {
+      if (args->valueCount > 256) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"maximally 256 floating point values can be interpolated per vertex");
+
+      /* calculate base pointer and stride */
+      const RTCBufferType bufferType = args->bufferType;
+      const unsigned int bufferSlot = args->bufferSlot;
+      assert((bufferType == RTC_BUFFER_TYPE_VERTEX && bufferSlot < numTimeSteps) ||
+             (bufferType == RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE && bufferSlot <= vertexAttribs.size()));
+      const char* src = nullptr; 
+      size_t stride = 0;
+      if (bufferType == RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE) {
+        src    = vertexAttribs[bufferSlot].getPtr();
+        stride = vertexAttribs[bufferSlot].getStride();
+      } else {
+        src    = vertices[bufferSlot].getPtr();
+        stride = vertices[bufferSlot].getStride();
+      }
+
+      interpolateNx<4>(args,src,[&] (unsigned primID, float u, float v, size_t ofs[4], float& lu, float& lv, float& su, float& sv)
+      {
+        const Quad& q = quad(primID);
+        for (size_t i=0; i<4; i++) ofs[i] = q.v[i]*stride;
+        lu = u; lv = v; su = sv = 1.0f;
+      });
+    }
+
     QuadMesh* createQuadMesh(Device* device) {
       return new QuadMeshISA(device);
     }
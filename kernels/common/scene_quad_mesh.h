@@ -179,7 +179,7 @@ namespace embree
 
     /*! calculates the linear bounds of the i'th primitive for the specified time range */
     __forceinline LBBox3fa linearBounds(size_t primID, const BBox1f& dt) const {
-      return LBBox3fa([&] (size_t itime) { return bounds(primID, itime); }, dt, time_range, fnumTimeSegments);
+      return linearTimeBounds([&] (size_t itime) { return bounds(primID, itime); }, dt);
     }
 
     /*! calculates the linear bounds of the i'th primitive for the specified time range */
@@ -230,6 +230,8 @@ namespace embree
       QuadMeshISA (Device* device)
         : QuadMesh(device) {}
 
+      void interpolateN(const RTCInterpolateNArguments* const args);
+
       PrimInfo createPrimRefArray(mvector<PrimRef>& prims, const range<size_t>& r, size_t k, unsigned int geomID) const
       {
         PrimInfo pinfo(empty);
@@ -5,6 +5,9 @@
 #include "scene.h"
 #include "../subdiv/patch_eval.h"
 #include "../subdiv/patch_eval_simd.h"
+#include "../subdiv/patch_eval_grid.h"
+#include "../subdiv/feature_adaptive_eval_grid.h"
+#include "../subdiv/subdivpatch1base.h"
 
 #include "../../common/algorithms/parallel_sort.h"
 #include "../../common/algorithms/parallel_prefix_sum.h"
@@ -25,6 +28,7 @@ namespace embree
       faceStartEdge(device,0),
       halfEdgeFace(device,0),
       invalid_face(device,0),
+      faceStencil(device,0),
       commitCounter(0)
   {
     
@@ -77,6 +81,12 @@ namespace embree
     Geometry::setNumTimeSteps(numTimeSteps);
   }
 
+  void SubdivMesh::setTimeSteps (const float* times, unsigned int numTimeSteps)
+  {
+    if (times != nullptr)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry");
+  }
+
   void SubdivMesh::setVertexAttributeCount (unsigned int N)
   {
     vertexAttribs.resize(N);
@@ -374,6 +384,8 @@ namespace embree
   {
     if (subdiv_mode == mode) return;
     subdiv_mode = mode;
+    /* pinning may change edge and vertex creases */
+    mesh->updateBuffer(RTC_BUFFER_TYPE_EDGE_CREASE_WEIGHT, 0);
     mesh->updateBuffer(RTC_BUFFER_TYPE_VERTEX_CREASE_WEIGHT, 0);
   }
   
@@ -510,20 +522,18 @@ namespace embree
     });
 
     /* set subdivision mode and calculate patch types */
-    parallel_for( size_t(0), numFaces, blockSize, [&](const range<size_t>& r) 
+    calculatePatchTypes();
+  }
+
+  void SubdivMesh::Topology::calculatePatchTypes()
+  {
+    /* the patch type depends on the creases of all edges of a face, thus we process faces after all edges got updated */
+    parallel_for( size_t(0), mesh->numFaces(), size_t(4096), [&](const range<size_t>& r) 
     {
       for (size_t f=r.begin(); f<r.end(); f++) 
       {
         HalfEdge* edge = &halfEdges[mesh->faceStartEdge[f]];
 
-        /* for vertex topology we also test if vertices are valid */
-        if (this == &mesh->topology[0])
-        {
-          /* calculate if face is valid */
-          for (size_t t=0; t<mesh->numTimeSteps; t++)
-            mesh->invalidFace(f,t) = !edge->valid(mesh->vertices[t]) || mesh->holeSet.lookup(unsigned(f));
-        }
-
         /* pin some edges and vertices */
         for (size_t i=0; i<mesh->faceVertices[f]; i++) 
         {
@@ -581,30 +591,13 @@ namespace embree
         
         /* we only use user specified vertex_crease_weight if the vertex is manifold */
         if (updateVertexCreases && edge.vertex_type != HalfEdge::NON_MANIFOLD_EDGE_VERTEX) 
-        {
 	  edge.vertex_crease_weight = mesh->vertexCreaseMap.lookup(halfEdgesGeom[i].vtx_index,0.0f);
-
-          /* pin corner vertices when requested by user */
-          if (subdiv_mode == RTC_SUBDIVISION_MODE_PIN_CORNERS && edge.isCorner())
-            edge.vertex_crease_weight = float(inf);
-          
-          /* pin all border vertices when requested by user */
-          else if (subdiv_mode == RTC_SUBDIVISION_MODE_PIN_BOUNDARY && edge.vertexHasBorder()) 
-            edge.vertex_crease_weight = float(inf);
-
-          /* pin every vertex when requested by user */
-          else if (subdiv_mode == RTC_SUBDIVISION_MODE_PIN_ALL) {
-            edge.edge_crease_weight = float(inf);
-            edge.vertex_crease_weight = float(inf);
-          }
-        }
-
-        /* update patch type */
-        if (updateEdgeCreases || updateVertexCreases) {
-          edge.patch_type = edge.patchType();
-        }
       }
     });
+
+    /* pinning and patch types only have to get updated when creases changed */
+    if (updateEdgeCreases || updateVertexCreases)
+      calculatePatchTypes();
   }
 
   void SubdivMesh::Topology::initializeHalfEdgeStructures ()
@@ -675,6 +668,13 @@ namespace embree
   {
     double t0 = getSeconds();
 
+    /* faces only have to get validated again if the topology or the vertices changed */
+    bool validate = invalid_face.size() != numFaces()*numTimeSteps;
+    validate |= topology[0].vertexIndices.isLocalModified();
+    validate |= faceVertices.isLocalModified();
+    validate |= holes.isLocalModified();
+    for (auto& buffer : vertices) validate |= buffer.isLocalModified();
+
     invalid_face.resize(numFaces()*numTimeSteps);
  
     /* calculate start edge of each face */
@@ -686,9 +686,12 @@ namespace embree
 
       /* calculate face of each half edge */
       halfEdgeFace.resize(numHalfEdges);
-      for (size_t f=0, h=0; f<numFaces(); f++)
-        for (size_t e=0; e<faceVertices[f]; e++)
-          halfEdgeFace[h++] = (unsigned int) f;
+      parallel_for( size_t(0), numFaces(), size_t(4096), [&](const range<size_t>& r) 
+      {
+        for (size_t f=r.begin(); f<r.end(); f++)
+          for (size_t e=faceStartEdge[f]; e<faceStartEdge[f]+faceVertices[f]; e++)
+            halfEdgeFace[e] = (unsigned int) f;
+      });
     }
     
     /* create set with all vertex creases */
@@ -707,6 +710,10 @@ namespace embree
     for (auto& t: topology)
       t.initializeHalfEdgeStructures();
 
+    /* calculate which faces are valid */
+    if (validate && topology[0].vertexIndices)
+      calculateInvalidFaces();
+
     /* create interpolation cache mapping for interpolatable meshes */
     for (size_t i=0; i<vertex_buffer_tags.size(); i++)
       vertex_buffer_tags[i].resize(numFaces()*numInterpolationSlots4(vertices[i].getStride()));
@@ -739,6 +746,35 @@ namespace embree
     }
   }
 
+  void SubdivMesh::calculateInvalidFaces ()
+  {
+    parallel_for( size_t(0), numFaces(), size_t(4096), [&](const range<size_t>& r) 
+    {
+      for (size_t f=r.begin(); f<r.end(); f++) 
+      {
+        const HalfEdge* edge = &topology[0].halfEdges[faceStartEdge[f]];
+        const bool hole = holeSet.lookup(unsigned(f));
+        for (size_t t=0; t<numTimeSteps; t++)
+          invalidFace(f,t) = hole || !edge->valid(vertices[t]);
+      }
+    });
+  }
+
+  bool SubdivMesh::stencilsModified () const
+  {
+    /* stencils depend on topology, creases, and levels, but not on the vertex positions */
+    bool modified = faceStencil.size() != numFaces();
+    modified |= topology[0].vertexIndices.isLocalModified();
+    modified |= faceVertices.isLocalModified();
+    modified |= holes.isLocalModified();
+    modified |= levels.isLocalModified();
+    modified |= edge_creases.isLocalModified();
+    modified |= edge_crease_weights.isLocalModified();
+    modified |= vertex_creases.isLocalModified();
+    modified |= vertex_crease_weights.isLocalModified();
+    return modified;
+  }
+
   bool SubdivMesh::verify () 
   {
     /*! verify consistent size of vertex arrays */
@@ -820,6 +856,136 @@ namespace embree
     SubdivMesh* createSubdivMesh(Device* device) {
       return new SubdivMeshISA(device);
     }
+
+    void SubdivMeshISA::commit ()
+    {
+      const bool updateStencils = stencilsModified();
+      initializeHalfEdgeStructures();
+      if (updateStencils) calculateStencils();
+      Geometry::commit();
+    }
+
+    /* calls the function for each control vertex slot of the patch */
+    template<typename Func>
+    static __forceinline void foreachVertex(GeneralCatmullClarkPatch3fa& patch, const Func& func)
+    {
+      for (size_t i=0; i<patch.size(); i++)
+      {
+        func(patch.ring[i].vtx);
+        for (size_t j=0; j<patch.ring[i].edge_valence; j++)
+          func(patch.ring[i].ring[j]);
+      }
+    }
+
+    /* calculates the stencil of some sub-patch by evaluating the patch with unit vectors
+     * as control vertices, each evaluation delivers the weights of three control vertices */
+    static void calculateStencil(GridStencil& stencil, const HalfEdge* edge, const unsigned subPatch,
+                                 const unsigned swidth, const unsigned sheight, const float level[4], const char* ids)
+    {
+      /* the patch over the index buffer stores the index of each control vertex */
+      std::vector<unsigned> vertexIDs;
+      GeneralCatmullClarkPatch3fa idpatch(edge,ids,sizeof(float));
+      foreachVertex(idpatch,[&] (const Vec3fa& p) { vertexIDs.push_back(unsigned(p.x)); });
+      std::sort(vertexIDs.begin(),vertexIDs.end());
+      vertexIDs.erase(std::unique(vertexIDs.begin(),vertexIDs.end()),vertexIDs.end());
+      stencil.init(swidth,sheight,level,vertexIDs);
+
+      const bool stitch =
+        int(level[0])+1 < int(swidth) || int(level[2])+1 < int(swidth) ||
+        int(level[1])+1 < int(sheight) || int(level[3])+1 < int(sheight);
+
+      const unsigned N = swidth*sheight;
+      dynamic_large_stack_array(float,grid_x,N+VSIZEX,64*64*sizeof(float));
+      dynamic_large_stack_array(float,grid_y,N+VSIZEX,64*64*sizeof(float));
+      dynamic_large_stack_array(float,grid_z,N+VSIZEX,64*64*sizeof(float));
+      dynamic_large_stack_array(float,grid_u,N+VSIZEX,64*64*sizeof(float));
+      dynamic_large_stack_array(float,grid_v,N+VSIZEX,64*64*sizeof(float));
+      float* grid[3] = { grid_x, grid_y, grid_z };
+
+      for (size_t k=0; k<vertexIDs.size(); k+=3)
+      {
+        GeneralCatmullClarkPatch3fa patch(edge,ids,sizeof(float));
+        foreachVertex(patch,[&] (Vec3fa& p) {
+          const size_t i = std::lower_bound(vertexIDs.begin(),vertexIDs.end(),unsigned(p.x)) - vertexIDs.begin();
+          p = Vec3fa(i == k+0 ? 1.0f : 0.0f, i == k+1 ? 1.0f : 0.0f, i == k+2 ? 1.0f : 0.0f);
+        });
+
+        feature_adaptive_eval_grid<FeatureAdaptiveEvalGrid,GeneralCatmullClarkPatch3fa>
+          (patch,subPatch,stitch ? level : nullptr,
+           0,swidth-1,0,sheight-1,swidth,sheight,
+           grid_x,grid_y,grid_z,grid_u,grid_v,nullptr,nullptr,nullptr,
+           swidth,sheight);
+
+        for (size_t j=0; j<3 && k+j<vertexIDs.size(); j++)
+          for (size_t i=0; i<N; i++)
+            stencil.weight(k+j)[i] = grid[j][i];
+      }
+
+      for (size_t i=0; i<N; i++) {
+        stencil.u[i] = grid_u[i];
+        stencil.v[i] = grid_v[i];
+      }
+    }
+
+    void SubdivMeshISA::calculateStencils ()
+    {
+      stencils.clear();
+      faceStencil.clear();
+
+      /* displacements require the surface normals, thus displaced meshes get evaluated
+       * directly, the index buffer below can store vertex indices up to 2^24 exactly */
+      if (!device->subdiv_stencils || displFunc || !topology[0].vertexIndices || numVertices() >= (1<<24))
+        return;
+
+      double t0 = getSeconds();
+
+      /* assign stencils to the sub-patches of all faces that are evaluated adaptively */
+      faceStencil.resize(numFaces());
+      size_t numStencils = 0;
+      for (size_t f=0; f<numFaces(); f++)
+      {
+        faceStencil[f] = uint32_t(-1);
+        if (!valid(f)) continue;
+        const HalfEdge* edge = getHalfEdge(0,f);
+#if PATCH_USE_GREGORY == 2
+        if (edge->patch_type != HalfEdge::COMPLEX_PATCH) continue;
+#else
+        if (edge->patch_type != HalfEdge::COMPLEX_PATCH && edge->patch_type != HalfEdge::IRREGULAR_QUAD_PATCH) continue;
+#endif
+        faceStencil[f] = uint32_t(numStencils);
+        numStencils += patch_eval_subdivision_count(edge);
+      }
+      stencils.resize(numStencils);
+
+      /* buffer that stores the index of each vertex */
+      std::vector<float> ids(numVertices()+3);
+      for (size_t i=0; i<ids.size(); i++) ids[i] = float(i);
+
+      parallel_for( size_t(0), numFaces(), size_t(64), [&](const range<size_t>& r)
+      {
+        for (size_t f=r.begin(); f<r.end(); f++)
+        {
+          if (faceStencil[f] == uint32_t(-1)) continue;
+          const HalfEdge* edge = getHalfEdge(0,f);
+          patch_eval_subdivision(edge,[&](const Vec2f uv[4], const int subdiv[4], const float edge_level[4], int subPatch)
+          {
+            float level[4]; SubdivPatch1Base::computeEdgeLevels(edge_level,subdiv,level);
+            const Vec2i grid = SubdivPatch1Base::computeGridSize(level);
+            calculateStencil(stencils[faceStencil[f]+subPatch],edge,subPatch,grid.x,grid.y,level,(const char*)ids.data());
+          });
+        }
+      });
+
+      double t1 = getSeconds();
+
+      /* print statistics in verbose mode */
+      if (device->verbosity(2))
+      {
+        size_t bytes = 0;
+        for (const auto& stencil : stencils) bytes += stencil.bytes();
+        std::cout << "stencil generation = " << 1000.0*(t1-t0) << "ms, " << numStencils << " stencils, " << 1E-6*double(bytes) << " MB" << std::endl;
+      }
+    }
     
     void SubdivMeshISA::interpolate(const RTCInterpolateArguments* const args)
     {
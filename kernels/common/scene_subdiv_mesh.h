@@ -9,6 +9,7 @@
 #include "../subdiv/tessellation_cache.h"
 #include "../subdiv/catmullclark_coefficients.h"
 #include "../subdiv/patch.h"
+#include "../subdiv/grid_stencil.h"
 #include "../../common/algorithms/parallel_map.h"
 #include "../../common/algorithms/parallel_set.h"
 
@@ -55,6 +56,7 @@ namespace embree
     void setSubdivisionMode (unsigned int topologyID, RTCSubdivisionMode mode);
     void setVertexAttributeTopology(unsigned int vertexAttribID, unsigned int topologyID);
     void setNumTimeSteps (unsigned int numTimeSteps);
+    void setTimeSteps (const float* times, unsigned int numTimeSteps);
     void setVertexAttributeCount (unsigned int N);
     void setTopologyCount (unsigned int N);
     void setBuffer(RTCBufferType type, unsigned int slot, RTCFormat format, const Ref<Buffer>& buffer, size_t offset, size_t stride, unsigned int num);
@@ -108,6 +110,19 @@ namespace embree
 
     /*! initializes the half edge data structure */
     void initializeHalfEdgeStructures ();
+
+    /*! marks faces with invalid vertices or holes as invalid */
+    void calculateInvalidFaces ();
+
+    /*! checks if the limit surface stencils have to get recalculated */
+    bool stencilsModified () const;
+
+    /*! returns the limit surface stencil of some sub-patch of face f, or nullptr if there is none */
+    __forceinline const GridStencil* getStencil(size_t f, unsigned subPatch) const
+    {
+      if (f >= faceStencil.size() || faceStencil[f] == unsigned(-1)) return nullptr;
+      return &stencils[faceStencil[f]+subPatch];
+    }
  
   public:
 
@@ -191,6 +206,9 @@ namespace embree
       
       /*! updates half edges when recalculation is not necessary */
       void updateHalfEdges();
+
+      /*! pins edges and vertices as requested by the subdivision mode and calculates the patch type of each face */
+      void calculatePatchTypes();
       
       /*! user input data */
     public:
@@ -293,6 +311,13 @@ namespace embree
     std::vector<std::vector<SharedLazyTessellationCache::CacheEntry>> vertex_buffer_tags;
     std::vector<std::vector<SharedLazyTessellationCache::CacheEntry>> vertex_attrib_buffer_tags;
     std::vector<Patch3fa::Ref> patch_eval_trees;
+
+    /*! limit surface stencils of the tessellation grids of complex faces */
+  protected:
+    std::vector<GridStencil> stencils;
+
+    /*! index of the first stencil of each face, -1 for faces without stencils */
+    mvector<uint32_t> faceStencil;
     
     /*! the following data is only required during construction of the
      *  half edge structure and can be cleared for static scenes */
@@ -317,8 +342,12 @@ namespace embree
       SubdivMeshISA (Device* device)
         : SubdivMesh(device) {}
 
+      void commit();
       void interpolate(const RTCInterpolateArguments* const args);
       void interpolateN(const RTCInterpolateNArguments* const args);
+
+    private:
+      void calculateStencils();
     };
   }
 
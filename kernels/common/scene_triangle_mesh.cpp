@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "scene_triangle_mesh.h"
+#include "interpolate_n.h"
 #include "scene.h"
 
 namespace embree
@@ -9,7 +10,7 @@ namespace embree
 #if defined(EMBREE_LOWEST_ISA)
 
   TriangleMesh::TriangleMesh (Device* device)
-    : Geometry(device,GTY_TRIANGLE_MESH,0,1)
+    : Geometry(device,GTY_TRIANGLE_MESH,0,1), quant_lower(0.0f), quant_scale(1.0f/65535.0f), quant_eps(4.0f*float(ulp)), quantized(false)
   {
     vertices.resize(numTimeSteps);
   }
@@ -40,7 +41,7 @@ namespace embree
 
     if (type == RTC_BUFFER_TYPE_VERTEX)
     {
-      if (format != RTC_FORMAT_FLOAT3)
+      if (format != RTC_FORMAT_FLOAT3 && format != RTC_FORMAT_USHORT3)
         throw_RTCError(RTC_ERROR_INVALID_OPERATION, "invalid vertex buffer format");
 
       /* if buffer is larger than 16GB the premultiplied index optimization does not work */
@@ -51,7 +52,7 @@ namespace embree
         throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "invalid vertex buffer slot");
 
       vertices[slot].set(buffer, offset, stride, num, format);
-      vertices[slot].checkPadding16();
+      if (format == RTC_FORMAT_FLOAT3) vertices[slot].checkPadding16();
       vertices0 = vertices[0];
     }
     else if (type == RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE)
@@ -134,13 +135,33 @@ namespace embree
     Geometry::update();
   }
 
+  void TriangleMesh::setVertexQuantizationBounds (const BBox3fa& bounds)
+  {
+    if (!(bounds.lower.x <= bounds.upper.x && bounds.lower.y <= bounds.upper.y && bounds.lower.z <= bounds.upper.z))
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid quantization bounds");
+
+    quant_lower = bounds.lower;
+    quant_scale = (bounds.upper-bounds.lower)*(1.0f/65535.0f);
+
+    /* decoding is a single multiply add, thus at most some ulps off for different rounding modes */
+    const Vec3fa maxabs = max(abs(bounds.lower),abs(bounds.upper));
+    quant_eps = 4.0f*float(ulp)*reduce_max(maxabs);
+    Geometry::update();
+  }
+
   void TriangleMesh::commit() 
   {
-    /* verify that stride of all time steps are identical */
+    /* verify that stride and format of all time steps are identical */
     for (unsigned int t=0; t<numTimeSteps; t++)
       if (vertices[t].getStride() != vertices[0].getStride())
         throw_RTCError(RTC_ERROR_INVALID_OPERATION,"stride of vertex buffers have to be identical for each time step");
 
+    for (unsigned int t=0; t<numTimeSteps; t++)
+      if (vertices[t].getFormat() != vertices[0].getFormat())
+        throw_RTCError(RTC_ERROR_INVALID_OPERATION,"format of vertex buffers have to be identical for each time step");
+
+    quantized = vertices[0].getFormat() == RTC_FORMAT_USHORT3;
+
     Geometry::commit();
   }
 
@@ -171,9 +192,9 @@ namespace embree
     }
 
     /*! verify vertices */
-    for (const auto& buffer : vertices)
-      for (size_t i=0; i<buffer.size(); i++)
-	if (!isvalid(buffer[i])) 
+    for (size_t t=0; t<vertices.size(); t++)
+      for (size_t i=0; i<vertices[t].size(); i++)
+	if (!isvalid(vertex(i,t))) 
 	  return false;
 
     return true;
@@ -199,6 +220,29 @@ namespace embree
            (bufferType == RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE && bufferSlot <= vertexAttribs.size()));
     const char* src = nullptr; 
     size_t stride = 0;
+
+    /* quantized vertex positions get decoded first */
+    if (bufferType == RTC_BUFFER_TYPE_VERTEX && quantized)
+    {
+      const float w = 1.0f-u-v;
+      const Triangle& tri = triangle(primID);
+      const vbool4 valid = vint4(step) < vint4(int(min(valueCount,3u)));
+      const vfloat4 p0 = (vfloat4) vertex(tri.v[0],bufferSlot);
+      const vfloat4 p1 = (vfloat4) vertex(tri.v[1],bufferSlot);
+      const vfloat4 p2 = (vfloat4) vertex(tri.v[2],bufferSlot);
+      if (P) vfloat4::storeu(valid,P,madd(w,p0,madd(u,p1,v*p2)));
+      if (dPdu) {
+        assert(dPdu); vfloat4::storeu(valid,dPdu,p1-p0);
+        assert(dPdv); vfloat4::storeu(valid,dPdv,p2-p0);
+      }
+      if (ddPdudu) {
+        assert(ddPdudu); vfloat4::storeu(valid,ddPdudu,vfloat4(zero));
+        assert(ddPdvdv); vfloat4::storeu(valid,ddPdvdv,vfloat4(zero));
+        assert(ddPdudv); vfloat4::storeu(valid,ddPdudv,vfloat4(zero));
+      }
+      return;
+    }
+
     if (bufferType == RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE) {
       src    = vertexAttribs[bufferSlot].getPtr();
       stride = vertexAttribs[bufferSlot].getStride();
@@ -236,6 +280,37 @@ namespace embree
   
   namespace isa
   {
+    void TriangleMeshISA::interpolateN(const RTCInterpolateNArguments* const args)
+    {
+      /* quantized vertex positions get decoded by the scalar path */
+      if (args->bufferType == RTC_BUFFER_TYPE_VERTEX && quantized)
+        return Geometry::interpolateN(args);
+
+      if (args->valueCount > 256) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"maximally 256 floating point values can be interpolated per vertex");
+
+      /* calculate base pointer and stride */
+      const RTCBufferType bufferType = args->bufferType;
+      const unsigned int bufferSlot = args->bufferSlot;
+      assert((bufferType == RTC_BUFFER_TYPE_VERTEX && bufferSlot < numTimeSteps) ||
+             (bufferType == RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE && bufferSlot <= vertexAttribs.size()));
+      const char* src = nullptr; 
+      size_t stride = 0;
+      if (bufferType == RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE) {
+        src    = vertexAttribs[bufferSlot].getPtr();
+        stride = vertexAttribs[bufferSlot].getStride();
+      } else {
+        src    = vertices[bufferSlot].getPtr();
+        stride = vertices[bufferSlot].getStride();
+      }
+
+      interpolateNx<3>(args,src,[&] (unsigned primID, float u, float v, size_t ofs[3], float& lu, float& lv, float& su, float& sv)
+      {
+        const Triangle& tri = triangle(primID);
+        for (size_t i=0; i<3; i++) ofs[i] = tri.v[i]*stride;
+        lu = u; lv = v; su = sv = 1.0f;
+      });
+    }
+
     TriangleMesh* createTriangleMesh(Device* device) {
       return new TriangleMeshISA(device);
     }
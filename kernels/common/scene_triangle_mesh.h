@@ -11,6 +11,8 @@ namespace embree
   /*! Triangle Mesh */
   struct TriangleMesh : public Geometry
   {
+    ALIGNED_STRUCT_(16);
+
     /*! type of this geometry */
     static const Geometry::GTypeMask geom_type = Geometry::MTY_TRIANGLE_MESH;
 
@@ -42,6 +44,7 @@ namespace embree
     bool verify();
     void interpolate(const RTCInterpolateArguments* const args);
     void addElementsToCount (GeometryCounts & counts) const;
+    void setVertexQuantizationBounds (const BBox3fa& bounds);
 
   public:
 
@@ -55,8 +58,20 @@ namespace embree
       return triangles[i];
     }
 
+    /*! returns true if vertex positions are stored as 16 bit values relative to the quantization bounds */
+    __forceinline bool isQuantized() const {
+      return quantized;
+    }
+
+    /*! decodes a 16 bit quantized vertex position */
+    __forceinline const Vec3fa dequantize(const char* ptr) const {
+      const unsigned short* q = (const unsigned short*) ptr;
+      return madd(Vec3fa(float(q[0]),float(q[1]),float(q[2])),quant_scale,quant_lower);
+    }
+
     /*! returns i'th vertex of the first time step  */
     __forceinline const Vec3fa vertex(size_t i) const {
+      if (unlikely(quantized)) return dequantize(vertices0.getPtr(i));
       return vertices0[i];
     }
 
@@ -67,6 +82,7 @@ namespace embree
 
     /*! returns i'th vertex of itime'th timestep */
     __forceinline const Vec3fa vertex(size_t i, size_t itime) const {
+      if (unlikely(quantized)) return dequantize(vertices[itime].getPtr(i));
       return vertices[itime][i];
     }
 
@@ -82,7 +98,7 @@ namespace embree
       const Vec3fa v0 = vertex(tri.v[0]);
       const Vec3fa v1 = vertex(tri.v[1]);
       const Vec3fa v2 = vertex(tri.v[2]);
-      return BBox3fa(min(v0,v1,v2),max(v0,v1,v2));
+      return enlargeQuantized(BBox3fa(min(v0,v1,v2),max(v0,v1,v2)));
     }
 
     /*! calculates the bounds of the i'th triangle at the itime'th timestep */
@@ -92,7 +108,13 @@ namespace embree
       const Vec3fa v0 = vertex(tri.v[0],itime);
       const Vec3fa v1 = vertex(tri.v[1],itime);
       const Vec3fa v2 = vertex(tri.v[2],itime);
-      return BBox3fa(min(v0,v1,v2),max(v0,v1,v2));
+      return enlargeQuantized(BBox3fa(min(v0,v1,v2),max(v0,v1,v2)));
+    }
+
+    /*! enlarges bounds of quantized vertices to stay conservative under rounding differences of the decoding */
+    __forceinline BBox3fa enlargeQuantized(const BBox3fa& b) const {
+      if (likely(!quantized)) return b;
+      return BBox3fa(b.lower-Vec3fa(quant_eps),b.upper+Vec3fa(quant_eps));
     }
 
     /*! check if the i'th primitive is valid at the itime'th timestep */
@@ -163,13 +185,13 @@ namespace embree
       const Vec3fa b2 = vertex(tri.v[2],itime+1); if (unlikely(!isvalid(b2))) return false;
       
       /* use bounds of first time step in builder */
-      bbox = BBox3fa(min(a0,a1,a2),max(a0,a1,a2));
+      bbox = enlargeQuantized(BBox3fa(min(a0,a1,a2),max(a0,a1,a2)));
       return true;
     }
 
     /*! calculates the linear bounds of the i'th primitive for the specified time range */
     __forceinline LBBox3fa linearBounds(size_t primID, const BBox1f& dt) const {
-      return LBBox3fa([&] (size_t itime) { return bounds(primID, itime); }, dt, time_range, fnumTimeSegments);
+      return linearTimeBounds([&] (size_t itime) { return bounds(primID, itime); }, dt);
     }
 
     /*! calculates the linear bounds of the i'th primitive for the specified time range */
@@ -179,8 +201,9 @@ namespace embree
       return true;
     }
 
-    /*! get fast access to first vertex buffer */
+    /*! get fast access to first vertex buffer, quantized vertices have to get decoded through the mesh */
     __forceinline float * getCompactVertexArray () const {
+      if (quantized) return nullptr;
       return (float*) vertices0.getPtr();
     }
 
@@ -208,6 +231,10 @@ namespace embree
     BufferView<Vec3fa> vertices0;        //!< fast access to first vertex buffer
     vector<BufferView<Vec3fa>> vertices; //!< vertex array for each timestep
     vector<RawBufferView> vertexAttribs; //!< vertex attributes
+    Vec3fa quant_lower;                  //!< lower bounds of quantized vertex positions
+    Vec3fa quant_scale;                  //!< scale from quantized to float vertex positions
+    float quant_eps;                     //!< bounds enlargement for quantized vertex positions
+    bool quantized;                      //!< true if vertex positions are 16 bit quantized
   };
 
   namespace isa
@@ -217,6 +244,8 @@ namespace embree
       TriangleMeshISA (Device* device)
         : TriangleMesh(device) {}
 
+      void interpolateN(const RTCInterpolateNArguments* const args);
+
       PrimInfo createPrimRefArray(mvector<PrimRef>& prims, const range<size_t>& r, size_t k, unsigned int geomID) const
       {
         PrimInfo pinfo(empty);
@@ -83,6 +83,24 @@ namespace embree
       cmp_xchg(s3,s2);
     }
 
+    /*! Sort 8 stack items in descending order using an optimal
+     *  sorting network of 19 compare-exchange operations. */
+    __forceinline static void sort8(vint4* s)
+    {
+      cmp_xchg(s[2],s[0]); cmp_xchg(s[3],s[1]); cmp_xchg(s[6],s[4]); cmp_xchg(s[7],s[5]);
+      cmp_xchg(s[4],s[0]); cmp_xchg(s[5],s[1]); cmp_xchg(s[6],s[2]); cmp_xchg(s[7],s[3]);
+      cmp_xchg(s[1],s[0]); cmp_xchg(s[3],s[2]); cmp_xchg(s[5],s[4]); cmp_xchg(s[7],s[6]);
+      cmp_xchg(s[4],s[2]); cmp_xchg(s[5],s[3]);
+      cmp_xchg(s[4],s[1]); cmp_xchg(s[6],s[3]);
+      cmp_xchg(s[2],s[1]); cmp_xchg(s[4],s[3]); cmp_xchg(s[6],s[5]);
+    }
+
+    /*! Returns true if the distances of all items are equal up to a
+     *  relative difference of about 2^-10. As distances are positive
+     *  floats, their bit patterns differ by less than 2^13 then. */
+    __forceinline static bool nearlyEqual(unsigned int dmin, unsigned int dmax) {
+      return dmax - dmin < (1u << 13);
+    }
 
     /*! Sort N stack items. */
     __forceinline friend void sort(StackItemT* begin, StackItemT* end)
@@ -108,6 +126,58 @@ namespace embree
     unsigned dist;
   };
 
+  /*! A compressed stack item packs the node ID and the upper 16 bits of
+   *  the distance of that node into 8 bytes. Truncating the distance
+   *  rounds positive distances down, thus culling popped nodes against
+   *  the ray stays conservative. As the distance is stored in the upper
+   *  bits, comparing items as integers compares their distances. */
+  template<typename T>
+  struct __aligned(8) StackItemCompressedT
+  {
+    static_assert(sizeof(size_t) == 8, "compressed stack items require 64 bit pointers");
+
+    /*! node IDs have to fit into the lower 48 bits */
+    static const size_t ptrBits = 48;
+    static const size_t ptrMask = (size_t(1) << ptrBits)-1;
+
+    __forceinline StackItemCompressedT() {}
+
+    __forceinline StackItemCompressedT(T ptr, unsigned dist)
+      : item(size_t(ptr) | (size_t(dist >> 16) << ptrBits))
+    {
+      assert((size_t(ptr) & ~ptrMask) == 0);
+    }
+
+    __forceinline T ptr() const {
+      return T(item & ptrMask);
+    }
+
+    __forceinline float dist() const {
+      return cast_i2f(int(unsigned(item >> ptrBits) << 16));
+    }
+
+    /*! Sort N stack items, the closest item gets stored last. */
+    __forceinline friend void sort(StackItemCompressedT* begin, StackItemCompressedT* end)
+    {
+      for (StackItemCompressedT* i = begin+1; i != end; ++i)
+      {
+        const size_t item = i->item;
+        StackItemCompressedT* j = i;
+
+        while ((j != begin) && ((j-1)->item < item))
+        {
+          j->item = (j-1)->item;
+          --j;
+        }
+
+        j->item = item;
+      }
+    }
+
+  public:
+    size_t item;
+  };
+
   /*! An item on the stack holds the node ID and active ray mask. */
   template<typename T>
   struct __aligned(8) StackItemMaskT
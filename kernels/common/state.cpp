@@ -66,6 +66,8 @@ namespace embree
     hair_accel = "default";
     hair_builder = "default";
     hair_traverser = "default";
+    hair_adaptive_subdivision = true;
+    point_accel = "default";
 
     hair_accel_mb = "default";
     hair_builder_mb = "default";
@@ -85,6 +87,11 @@ namespace embree
     useSpatialPreSplits = false;
 
     tessellation_cache_size = 128*1024*1024;
+    subdiv_stencils = false;
+    subdiv_displacement_batch = 0;
+    lazy_memory_budget = std::numeric_limits<size_t>::max();
+    out_of_core_dir = "";
+    out_of_core_threshold = 0;
 
     subdiv_accel = "default";
     subdiv_accel_mb = "default";
@@ -93,6 +100,8 @@ namespace embree
     grid_builder = "default";
     grid_accel_mb = "default";
     grid_builder_mb = "default";
+    grid_adaptive_subgrids = true;
+    grid_compressed_vertices = false;
 
     instancing_open_min = 0;
     instancing_block_size = 0;
@@ -352,6 +361,10 @@ namespace embree
         hair_builder = cin->get().Identifier();
       else if (tok == Token::Id("hair_traverser") && cin->trySymbol("="))
         hair_traverser = cin->get().Identifier();
+      else if (tok == Token::Id("hair_adaptive_subdivision") && cin->trySymbol("="))
+        hair_adaptive_subdivision = cin->get().Int();
+      else if (tok == Token::Id("point_accel") && cin->trySymbol("="))
+        point_accel = cin->get().Identifier();
 
       else if (tok == Token::Id("hair_accel_mb") && cin->trySymbol("="))
         hair_accel_mb = cin->get().Identifier();
@@ -402,6 +415,10 @@ namespace embree
         grid_accel = cin->get().Identifier();
       else if (tok == Token::Id("grid_accel_mb") && cin->trySymbol("="))
         grid_accel_mb = cin->get().Identifier();
+      else if (tok == Token::Id("grid_adaptive_subgrids") && cin->trySymbol("="))
+        grid_adaptive_subgrids = cin->get().Int();
+      else if (tok == Token::Id("grid_compressed_vertices") && cin->trySymbol("="))
+        grid_compressed_vertices = cin->get().Int();
       
       else if (tok == Token::Id("verbose") && cin->trySymbol("="))
         verbose = cin->get().Int();
@@ -439,6 +456,18 @@ namespace embree
         tessellation_cache_size = size_t(cin->get().Float()*1024.0f*1024.0f);
       else if (tok == Token::Id("cache_size") && cin->trySymbol("="))
         tessellation_cache_size = size_t(cin->get().Float()*1024.0f*1024.0f);
+      else if (tok == Token::Id("subdiv_stencils") && cin->trySymbol("="))
+        subdiv_stencils = cin->get().Int();
+      else if (tok == Token::Id("subdiv_displacement_batch") && cin->trySymbol("="))
+        subdiv_displacement_batch = cin->get().Int();
+
+      else if (tok == Token::Id("lazy_memory_budget") && cin->trySymbol("="))
+        lazy_memory_budget = size_t(cin->get().Float()*1024.0f*1024.0f);
+
+      else if (tok == Token::Id("out_of_core_dir") && cin->trySymbol("="))
+        out_of_core_dir = cin->get().String();
+      else if (tok == Token::Id("out_of_core_threshold") && cin->trySymbol("="))
+        out_of_core_threshold = size_t(cin->get().Float()*1024.0f*1024.0f);
 
       else if (tok == Token::Id("alloc_main_block_size") && cin->trySymbol("="))
         alloc_main_block_size = cin->get().Int();
@@ -479,6 +508,14 @@ namespace embree
 
     std::cout << "  verbosity          = " << verbose << std::endl;
     std::cout << "  cache_size         = " << float(tessellation_cache_size)*1E-6 << " MB" << std::endl;
+    std::cout << "  subdiv_stencils    = " << subdiv_stencils << std::endl;
+    std::cout << "  displacement_batch = " << subdiv_displacement_batch << std::endl;
+    if (lazy_memory_budget != std::numeric_limits<size_t>::max())
+      std::cout << "  lazy_memory_budget = " << float(lazy_memory_budget)*1E-6 << " MB" << std::endl;
+    if (out_of_core_dir != "") {
+      std::cout << "  out_of_core_dir    = " << out_of_core_dir << std::endl;
+      std::cout << "  out_of_core_threshold = " << float(out_of_core_threshold)*1E-6 << " MB" << std::endl;
+    }
     std::cout << "  max_spatial_split_replications = " << max_spatial_split_replications << std::endl;
     
     std::cout << "triangles:" << std::endl;
@@ -515,6 +552,8 @@ namespace embree
     std::cout << "  accel              = " << hair_accel << std::endl;
     std::cout << "  builder            = " << hair_builder << std::endl;
     std::cout << "  traverser          = " << hair_traverser << std::endl;
+    std::cout << "  adaptive_subdivision = " << hair_adaptive_subdivision << std::endl;
+    std::cout << "  point accel        = " << point_accel << std::endl;
 
     std::cout << "motion blur hair:" << std::endl;
     std::cout << "  accel              = " << hair_accel_mb << std::endl;
@@ -527,6 +566,8 @@ namespace embree
     std::cout << "grids:" << std::endl;
     std::cout << "  accel              = " << grid_accel << std::endl;
     std::cout << "  builder            = " << grid_builder << std::endl;
+    std::cout << "  adaptive subgrids  = " << grid_adaptive_subgrids << std::endl;
+    std::cout << "  compressed verts   = " << grid_compressed_vertices << std::endl;
 
     std::cout << "motion blur grids:" << std::endl;
     std::cout << "  accel              = " << grid_accel_mb << std::endl;
@@ -77,6 +77,8 @@ namespace embree
     std::string hair_accel;                //!< hair acceleration structure to use
     std::string hair_builder;              //!< builder to use for hair
     std::string hair_traverser;            //!< traverser to use for hair
+    bool hair_adaptive_subdivision;        //!< reduces curve subdivision depth based on curvature estimated at commit
+    std::string point_accel;               //!< acceleration structure to use for points without motion blur
 
   public:
     std::string hair_accel_mb;             //!< acceleration structure to use for motion blur hair
@@ -104,11 +106,18 @@ namespace embree
     std::string grid_builder;            //!< builder for grids
     std::string grid_accel_mb;           //!< acceleration structure to use for motion blur grids
     std::string grid_builder_mb;         //!< builder for motion blur grids
+    bool grid_adaptive_subgrids;         //!< build blocks of 2x2 subgrids of flat grids as single primitives
+    bool grid_compressed_vertices;       //!< store 16 bit quantized subgrid vertices in grid leaves
 
   public:
     float max_spatial_split_replications;  //!< maximally replications*N many primitives in accel for spatial splits
     bool useSpatialPreSplits;              //!< use spatial pre-splits instead of the full spatial split builder
     size_t tessellation_cache_size;        //!< size of the shared tessellation cache 
+    bool subdiv_stencils;                  //!< precalculate limit surface stencils of complex subdivision faces
+    unsigned subdiv_displacement_batch;    //!< number of vertices to displace at once when building displaced subdivision meshes, 0 to displace each subgrid separately
+    size_t lazy_memory_budget;             //!< memory budget after which lazy geometries get evicted
+    std::string out_of_core_dir;           //!< directory to store large build arrays in, empty for in core builds
+    size_t out_of_core_threshold;          //!< minimal size of build arrays that get stored out of core
 
   public:
     size_t instancing_open_min;            //!< instancing opens tree to minimally that number of subtrees
@@ -8,6 +8,9 @@ namespace embree
   /*! invokes the memory monitor callback */
   struct MemoryMonitorInterface {
     virtual void memoryMonitor(ssize_t bytes, bool post) = 0;
+
+    /*! returns the directory to store allocations of the specified size in, or nullptr to allocate them in memory */
+    virtual const char* memoryFileDirectory(size_t bytes) { return nullptr; }
   };
 
   /*! allocator that performs aligned monitored allocations */
@@ -33,6 +36,9 @@ namespace embree
         }
         if (n*sizeof(value_type) >= 14 * PAGE_SIZE_2M)
         {
+          if (const char* dir = device->memoryFileDirectory(n*sizeof(value_type)))
+            return (pointer) os_malloc_file(n*sizeof(value_type),dir);
+          
           pointer p =  (pointer) os_malloc(n*sizeof(value_type),hugepages);
           assert(p);
           return p;
@@ -45,7 +51,12 @@ namespace embree
         if (p)
         {
           if (n*sizeof(value_type) >= 14 * PAGE_SIZE_2M)
-            os_free(p,n*sizeof(value_type),hugepages); 
+          {
+            if (device->memoryFileDirectory(n*sizeof(value_type)))
+              os_free_file(p,n*sizeof(value_type));
+            else
+              os_free(p,n*sizeof(value_type),hugepages);
+          }
           else
             alignedFree(p);
         }
@@ -0,0 +1,191 @@
+// Copyright 2009-2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "curveNi.h"
+
+namespace embree
+{
+  /* Compressed curve leaf. Stores the OBB data of CurveNi followed by
+   * the control points of each curve quantized to 16 bit relative to
+   * a per leaf quantization frame. This requires half the control
+   * point storage of CurveNv while still avoiding the indirection to
+   * the vertex buffer during intersection. */
+  template<int M>
+    struct CurveNc : public CurveNi<M>
+  {
+    using CurveNi<M>::N;
+
+    struct Type : public PrimitiveType {
+      const char* name() const;
+      size_t sizeActive(const char* This) const;
+      size_t sizeTotal(const char* This) const;
+      size_t getBytes(const char* This) const;
+    };
+    static Type type;
+
+  public:
+
+    /* Returns maximum number of stored primitives */
+    static __forceinline size_t max_size() { return M; }
+
+    /* Returns required number of primitive blocks for N primitives */
+    static __forceinline size_t blocks(size_t N) { return (N+M-1)/M; }
+
+    static __forceinline size_t bytes(size_t N)
+    {
+      const size_t f = N/M, r = N%M;
+      static_assert(sizeof(CurveNc) == 22+25*M+20+4*8*M, "internal data layout issue");
+      return f*sizeof(CurveNc) + (r!=0)*(22 + 25*r + 20 + 4*8*r);
+    }
+
+    /* Returns true if curves of this type get stored compressed, all others use the CurveNi layout */
+    static __forceinline bool compressed(const unsigned int ty)
+    {
+      if ((ty & Geometry::GTY_SUBTYPE_MASK) == Geometry::GTY_SUBTYPE_ORIENTED_CURVE) return false;
+      const unsigned int basis = ty & Geometry::GTY_BASIS_MASK;
+      return basis == Geometry::GTY_BASIS_BEZIER || basis == Geometry::GTY_BASIS_BSPLINE;
+    }
+
+  public:
+
+    /*! Default constructor. */
+    __forceinline CurveNc () {}
+
+    /*! fill curve from curve list */
+    __forceinline void fill(const PrimRef* prims, size_t& begin, size_t _end, Scene* scene)
+    {
+      const size_t first = begin;
+      CurveNi<M>::fill(prims,begin,_end,scene);
+      const size_t N = this->N;
+
+      /* calculate quantization frame from all control points of the leaf */
+      BBox3fa bounds = empty;
+      float rmax = 0.0f;
+      for (size_t i=0; i<N; i++)
+      {
+        const PrimRef& prim = prims[first+i];
+        CurveGeometry* mesh = (CurveGeometry*) scene->get(prim.geomID());
+        const unsigned vtxID = mesh->curve(prim.primID());
+        for (size_t j=0; j<4; j++) {
+          const Vec3ff v = mesh->vertex(vtxID+j);
+          bounds.extend(Vec3fa(v));
+          rmax = max(rmax,v.w);
+        }
+      }
+      const float s  = reduce_max(bounds.size())/65535.0f;
+      const float rs = rmax/65535.0f;
+      const float rcp_s  = s  != 0.0f ? 1.0f/s  : 0.0f;
+      const float rcp_rs = rs != 0.0f ? 1.0f/rs : 0.0f;
+      *qoffset(N) = Vec3f(bounds.lower.x,bounds.lower.y,bounds.lower.z);
+      *qscale(N) = s;
+      *qrscale(N) = rs;
+
+      /* quantize all control points */
+      for (size_t i=0; i<N; i++)
+      {
+        const PrimRef& prim = prims[first+i];
+        CurveGeometry* mesh = (CurveGeometry*) scene->get(prim.geomID());
+        const unsigned vtxID = mesh->curve(prim.primID());
+        for (size_t j=0; j<4; j++)
+        {
+          const Vec3ff v = mesh->vertex(vtxID+j);
+          const Vec3fa q = (Vec3fa(v)-bounds.lower)*rcp_s;
+          unsigned short* qv = vertices(i,N)+4*j;
+          qv[0] = (unsigned short) clamp(floor(q.x+0.5f),0.0f,65535.0f);
+          qv[1] = (unsigned short) clamp(floor(q.y+0.5f),0.0f,65535.0f);
+          qv[2] = (unsigned short) clamp(floor(q.z+0.5f),0.0f,65535.0f);
+          qv[3] = (unsigned short) clamp(floor(v.w*rcp_rs+0.5f),0.0f,65535.0f);
+        }
+      }
+
+      /* enlarge OBBs to also bound the decoded curves, which deviate
+       * by at most half a quantization step from the original ones */
+      const float lscale = *CurveNi<M>::scale(N);
+      const float err = (0.5f*sqrt(3.0f)*s + 0.5f*rs)*lscale*126.0f;
+      const float eps = ceil(err)+1.0f;
+      for (size_t i=0; i<N; i++)
+      {
+        enlarge(this->bounds_vx_lower(N)[i],this->bounds_vx_upper(N)[i],eps);
+        enlarge(this->bounds_vy_lower(N)[i],this->bounds_vy_upper(N)[i],eps);
+        enlarge(this->bounds_vz_lower(N)[i],this->bounds_vz_upper(N)[i],eps);
+      }
+    }
+
+    template<typename BVH, typename Allocator>
+      __forceinline static typename BVH::NodeRef createLeaf (BVH* bvh, const PrimRef* prims, const range<size_t>& set, const Allocator& alloc)
+    {
+      if (set.size() == 0)
+        return BVH::emptyNode;
+
+      /* fall back to CurveNi for curves that are not stored compressed */
+      unsigned int geomID = prims[set.begin()].geomID();
+      if (!compressed(bvh->scene->get(geomID)->getType())) {
+        return CurveNi<M>::createLeaf(bvh,prims,set,alloc);
+      }
+
+      size_t start = set.begin();
+      size_t items = CurveNc::blocks(set.size());
+      size_t numbytes = CurveNc::bytes(set.size());
+      CurveNc* accel = (CurveNc*) alloc.malloc1(numbytes,BVH::byteAlignment);
+      for (size_t i=0; i<items; i++) {
+        accel[i].fill(prims,start,set.end(),bvh->scene);
+      }
+      return bvh->encodeLeaf((char*)accel,items);
+    };
+
+    /*! decodes the 4 control points of the i'th curve */
+    __forceinline void gather(Vec3ff& a0, Vec3ff& a1, Vec3ff& a2, Vec3ff& a3, size_t i, size_t N) const
+    {
+      const Vec3f ofs = *qoffset(N);
+      const vfloat4 lower(ofs.x,ofs.y,ofs.z,0.0f);
+      const vfloat4 scl(*qscale(N),*qscale(N),*qscale(N),*qrscale(N));
+      const unsigned short* qv = vertices(i,N);
+      a0 = Vec3ff(madd(vfloat4(vint4::load(qv+ 0)),scl,lower));
+      a1 = Vec3ff(madd(vfloat4(vint4::load(qv+ 4)),scl,lower));
+      a2 = Vec3ff(madd(vfloat4(vint4::load(qv+ 8)),scl,lower));
+      a3 = Vec3ff(madd(vfloat4(vint4::load(qv+12)),scl,lower));
+    }
+
+  private:
+
+    static __forceinline void enlarge(short& lower, short& upper, float eps)
+    {
+      lower = (short) clamp(float(lower)-eps,-32767.0f,32767.0f);
+      upper = (short) clamp(float(upper)+eps,-32767.0f,32767.0f);
+    }
+
+  public:
+    unsigned char data[20+4*8*M];
+
+    /*
+    struct Layout
+    {
+      CurveNi<M> layout;
+      Vec3f qoffset;
+      float qscale;
+      float qrscale;
+      unsigned short vertices[N][4][4];
+    };
+    */
+
+    __forceinline       Vec3f* qoffset(size_t N)       { return (Vec3f*)CurveNi<M>::end(N); }
+    __forceinline const Vec3f* qoffset(size_t N) const { return (Vec3f*)CurveNi<M>::end(N); }
+
+    __forceinline       float* qscale(size_t N)       { return (float*)(CurveNi<M>::end(N)+12); }
+    __forceinline const float* qscale(size_t N) const { return (float*)(CurveNi<M>::end(N)+12); }
+
+    __forceinline       float* qrscale(size_t N)       { return (float*)(CurveNi<M>::end(N)+16); }
+    __forceinline const float* qrscale(size_t N) const { return (float*)(CurveNi<M>::end(N)+16); }
+
+    __forceinline       unsigned short* vertices(size_t i, size_t N)       { return (unsigned short*)(CurveNi<M>::end(N)+20)+16*i; }
+    __forceinline const unsigned short* vertices(size_t i, size_t N) const { return (unsigned short*)(CurveNi<M>::end(N)+20)+16*i; }
+  };
+
+  template<int M>
+    typename CurveNc<M>::Type CurveNc<M>::type;
+
+  typedef CurveNc<4> Curve4c;
+  typedef CurveNc<8> Curve8c;
+}
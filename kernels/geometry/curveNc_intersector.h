@@ -0,0 +1,199 @@
+// Copyright 2009-2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "curveNc.h"
+#include "curveNi_intersector.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    template<int M>
+      struct CurveNcIntersector1 : public CurveNiIntersector1<M>
+    {
+      typedef CurveNc<M> Primitive;
+      typedef CurvePrecalculations1 Precalculations;
+
+      template<typename Intersector, typename Epilog>
+        static __forceinline void intersect_t(const Precalculations& pre, RayHit& ray, IntersectContext* context, const Primitive& prim)
+      {
+        vfloat<M> tNear;
+        vbool<M> valid = CurveNiIntersector1<M>::intersect(ray,prim,tNear);
+
+        const size_t N = prim.N;
+        size_t mask = movemask(valid);
+        while (mask)
+        {
+          const size_t i = bscf(mask);
+          STAT3(normal.trav_prims,1,1,1);
+          const unsigned int geomID = prim.geomID(N);
+          const unsigned int primID = prim.primID(N)[i];
+          const CurveGeometry* geom = (CurveGeometry*) context->scene->get(geomID);
+          Vec3ff a0,a1,a2,a3; prim.gather(a0,a1,a2,a3,i,N);
+
+          size_t mask1 = mask;
+          const size_t i1 = bscf(mask1);
+          if (mask) {
+            prefetchL1(prim.vertices(i1,N));
+            if (mask1) {
+              const size_t i2 = bsf(mask1);
+              prefetchL2(prim.vertices(i2,N));
+            }
+          }
+
+          Intersector().intersect(pre,ray,context,geom,primID,a0,a1,a2,a3,Epilog(ray,context,geomID,primID));
+          mask &= movemask(tNear <= vfloat<M>(ray.tfar));
+        }
+      }
+
+      template<typename Intersector, typename Epilog>
+        static __forceinline bool occluded_t(const Precalculations& pre, Ray& ray, IntersectContext* context, const Primitive& prim)
+      {
+        vfloat<M> tNear;
+        vbool<M> valid = CurveNiIntersector1<M>::intersect(ray,prim,tNear);
+
+        const size_t N = prim.N;
+        size_t mask = movemask(valid);
+        while (mask)
+        {
+          const size_t i = bscf(mask);
+          STAT3(shadow.trav_prims,1,1,1);
+          const unsigned int geomID = prim.geomID(N);
+          const unsigned int primID = prim.primID(N)[i];
+          const CurveGeometry* geom = (CurveGeometry*) context->scene->get(geomID);
+          Vec3ff a0,a1,a2,a3; prim.gather(a0,a1,a2,a3,i,N);
+
+          size_t mask1 = mask;
+          const size_t i1 = bscf(mask1);
+          if (mask) {
+            prefetchL1(prim.vertices(i1,N));
+            if (mask1) {
+              const size_t i2 = bsf(mask1);
+              prefetchL2(prim.vertices(i2,N));
+            }
+          }
+          
+          if (Intersector().intersect(pre,ray,context,geom,primID,a0,a1,a2,a3,Epilog(ray,context,geomID,primID)))
+            return true;
+          
+          mask &= movemask(tNear <= vfloat<M>(ray.tfar));
+        }
+        return false;
+      }
+    };
+
+    template<int M, int K>
+      struct CurveNcIntersectorK : public CurveNiIntersectorK<M,K>
+    {
+      typedef CurveNc<M> Primitive;
+      typedef CurvePrecalculationsK<K> Precalculations;
+
+      template<typename Intersector, typename Epilog>
+        static __forceinline void intersect_packet_t(const vbool<K>& valid_i, Precalculations& pre, RayHitK<K>& ray, IntersectContext* context, const Primitive& prim)
+      {
+        const size_t N = prim.N;
+        for (size_t i=0; i<N; i++)
+        {
+          vfloat<K> tNear;
+          const vbool<K> valid = CurveNiIntersectorK<M,K>::intersect(valid_i,ray,prim,i,tNear);
+          if (none(valid)) continue;
+          STAT3(normal.trav_prims,1,popcnt(valid),K);
+          const unsigned int geomID = prim.geomID(N);
+          const unsigned int primID = prim.primID(N)[i];
+          const CurveGeometry* geom = (CurveGeometry*) context->scene->get(geomID);
+          Vec3ff a0,a1,a2,a3; prim.gather(a0,a1,a2,a3,i,N);
+          Intersector().template intersect<Epilog>(valid,pre,ray,context,geom,geomID,primID,a0,a1,a2,a3);
+        }
+      }
+
+      template<typename Intersector, typename Epilog>
+        static __forceinline void occluded_packet_t(const vbool<K>& valid_i, vbool<K>& valid_o, Precalculations& pre, RayK<K>& ray, IntersectContext* context, const Primitive& prim)
+      {
+        valid_o = false;
+        const size_t N = prim.N;
+        for (size_t i=0; i<N; i++)
+        {
+          vfloat<K> tNear;
+          const vbool<K> valid = CurveNiIntersectorK<M,K>::intersect(valid_i & !valid_o,ray,prim,i,tNear);
+          if (none(valid)) continue;
+          STAT3(shadow.trav_prims,1,popcnt(valid),K);
+          const unsigned int geomID = prim.geomID(N);
+          const unsigned int primID = prim.primID(N)[i];
+          const CurveGeometry* geom = (CurveGeometry*) context->scene->get(geomID);
+          Vec3ff a0,a1,a2,a3; prim.gather(a0,a1,a2,a3,i,N);
+          valid_o |= Intersector().template intersect<Epilog>(valid,pre,ray,context,geom,geomID,primID,a0,a1,a2,a3);
+          if (none(valid_i & !valid_o)) break;
+        }
+      }
+
+      template<typename Intersector, typename Epilog>
+        static __forceinline void intersect_t(Precalculations& pre, RayHitK<K>& ray, const size_t k, IntersectContext* context, const Primitive& prim)
+      {
+        vfloat<M> tNear;
+        vbool<M> valid = CurveNiIntersectorK<M,K>::intersect(ray,k,prim,tNear);
+
+        const size_t N = prim.N;
+        size_t mask = movemask(valid);
+        while (mask)
+        {
+          const size_t i = bscf(mask);
+          STAT3(normal.trav_prims,1,1,1);
+          const unsigned int geomID = prim.geomID(N);
+          const unsigned int primID = prim.primID(N)[i];
+          const CurveGeometry* geom = (CurveGeometry*) context->scene->get(geomID);
+          Vec3ff a0,a1,a2,a3; prim.gather(a0,a1,a2,a3,i,N);
+
+          size_t mask1 = mask;
+          const size_t i1 = bscf(mask1);
+          if (mask) {
+            prefetchL1(prim.vertices(i1,N));
+            if (mask1) {
+              const size_t i2 = bsf(mask1);
+              prefetchL2(prim.vertices(i2,N));
+            }
+          }
+
+          Intersector().intersect(pre,ray,k,context,geom,primID,a0,a1,a2,a3,Epilog(ray,k,context,geomID,primID));
+          mask &= movemask(tNear <= vfloat<M>(ray.tfar[k]));
+        }
+      }
+
+      template<typename Intersector, typename Epilog>
+        static __forceinline bool occluded_t(Precalculations& pre, RayK<K>& ray, const size_t k, IntersectContext* context, const Primitive& prim)
+      {
+        vfloat<M> tNear;
+        vbool<M> valid = CurveNiIntersectorK<M,K>::intersect(ray,k,prim,tNear);
+
+        const size_t N = prim.N;
+        size_t mask = movemask(valid);
+        while (mask)
+        {
+          const size_t i = bscf(mask);
+          STAT3(shadow.trav_prims,1,1,1);
+          const unsigned int geomID = prim.geomID(N);
+          const unsigned int primID = prim.primID(N)[i];
+          const CurveGeometry* geom = (CurveGeometry*) context->scene->get(geomID);
+          Vec3ff a0,a1,a2,a3; prim.gather(a0,a1,a2,a3,i,N);
+
+          size_t mask1 = mask;
+          const size_t i1 = bscf(mask1);
+          if (mask) {
+            prefetchL1(prim.vertices(i1,N));
+            if (mask1) {
+              const size_t i2 = bsf(mask1);
+              prefetchL2(prim.vertices(i2,N));
+            }
+          }
+
+          if (Intersector().intersect(pre,ray,k,context,geom,primID,a0,a1,a2,a3,Epilog(ray,k,context,geomID,primID)))
+            return true;
+
+          mask &= movemask(tNear <= vfloat<M>(ray.tfar[k]));
+        }
+        return false;
+      }
+    };
+  }
+}
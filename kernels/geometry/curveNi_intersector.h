@@ -328,6 +328,81 @@ namespace embree
         tNear_o = tNear;
         return (vint<M>(step) < vint<M>(prim.N)) & (tNear <= tFar);
       }
+
+      /* intersects all rays of the packet with the OBB of the i'th curve of the leaf */
+      static __forceinline vbool<K> intersect(const vbool<K>& valid, RayK<K>& ray, const Primitive& prim, const size_t i, vfloat<K>& tNear_o)
+      {
+        const size_t N = prim.N;
+        const vfloat4 offset_scale = vfloat4::loadu(prim.offset(N));
+        const Vec3fa offset = Vec3fa(offset_scale);
+        const Vec3fa scale = Vec3fa(shuffle<3,3,3,3>(offset_scale));
+
+        const Vec3vf<K> org1 = (ray.org-Vec3vf<K>(offset))*Vec3vf<K>(scale);
+        const Vec3vf<K> dir1 = ray.dir*Vec3vf<K>(scale);
+
+        const LinearSpace3<Vec3vf<K>> space(vfloat<K>(float(prim.bounds_vx_x(N)[i])), vfloat<K>(float(prim.bounds_vx_y(N)[i])), vfloat<K>(float(prim.bounds_vx_z(N)[i])),
+                                            vfloat<K>(float(prim.bounds_vy_x(N)[i])), vfloat<K>(float(prim.bounds_vy_y(N)[i])), vfloat<K>(float(prim.bounds_vy_z(N)[i])),
+                                            vfloat<K>(float(prim.bounds_vz_x(N)[i])), vfloat<K>(float(prim.bounds_vz_y(N)[i])), vfloat<K>(float(prim.bounds_vz_z(N)[i])));
+
+        const Vec3vf<K> dir2 = xfmVector(space,dir1);
+        const Vec3vf<K> org2 = xfmPoint (space,org1);
+        const Vec3vf<K> rcp_dir2 = rcp_safe(dir2);
+
+        const vfloat<K> t_lower_x = (vfloat<K>(float(prim.bounds_vx_lower(N)[i]))-org2.x)*rcp_dir2.x;
+        const vfloat<K> t_upper_x = (vfloat<K>(float(prim.bounds_vx_upper(N)[i]))-org2.x)*rcp_dir2.x;
+        const vfloat<K> t_lower_y = (vfloat<K>(float(prim.bounds_vy_lower(N)[i]))-org2.y)*rcp_dir2.y;
+        const vfloat<K> t_upper_y = (vfloat<K>(float(prim.bounds_vy_upper(N)[i]))-org2.y)*rcp_dir2.y;
+        const vfloat<K> t_lower_z = (vfloat<K>(float(prim.bounds_vz_lower(N)[i]))-org2.z)*rcp_dir2.z;
+        const vfloat<K> t_upper_z = (vfloat<K>(float(prim.bounds_vz_upper(N)[i]))-org2.z)*rcp_dir2.z;
+
+        const vfloat<K> round_up  (1.0f+3.0f*float(ulp));
+        const vfloat<K> round_down(1.0f-3.0f*float(ulp));
+        const vfloat<K> tNear = round_down*max(mini(t_lower_x,t_upper_x),mini(t_lower_y,t_upper_y),mini(t_lower_z,t_upper_z),ray.tnear());
+        const vfloat<K> tFar  = round_up  *min(maxi(t_lower_x,t_upper_x),maxi(t_lower_y,t_upper_y),maxi(t_lower_z,t_upper_z),ray.tfar);
+        tNear_o = tNear;
+        return valid & (tNear <= tFar);
+      }
+
+      /* intersects the rays of the packet with the curves of the leaf, each
+       * curve is culled against all rays at once and its control points
+       * get gathered only once for all rays that hit its OBB */
+      template<typename Intersector, typename Epilog>
+        static __forceinline void intersect_packet_t(const vbool<K>& valid_i, Precalculations& pre, RayHitK<K>& ray, IntersectContext* context, const Primitive& prim)
+      {
+        const size_t N = prim.N;
+        for (size_t i=0; i<N; i++)
+        {
+          vfloat<K> tNear;
+          const vbool<K> valid = intersect(valid_i,ray,prim,i,tNear);
+          if (none(valid)) continue;
+          STAT3(normal.trav_prims,1,popcnt(valid),K);
+          const unsigned int geomID = prim.geomID(N);
+          const unsigned int primID = prim.primID(N)[i];
+          const CurveGeometry* geom = context->scene->get<CurveGeometry>(geomID);
+          Vec3ff a0,a1,a2,a3; geom->gather(a0,a1,a2,a3,geom->curve(primID));
+          Intersector().template intersect<Epilog>(valid,pre,ray,context,geom,geomID,primID,a0,a1,a2,a3);
+        }
+      }
+
+      template<typename Intersector, typename Epilog>
+        static __forceinline void occluded_packet_t(const vbool<K>& valid_i, vbool<K>& valid_o, Precalculations& pre, RayK<K>& ray, IntersectContext* context, const Primitive& prim)
+      {
+        valid_o = false;
+        const size_t N = prim.N;
+        for (size_t i=0; i<N; i++)
+        {
+          vfloat<K> tNear;
+          const vbool<K> valid = intersect(valid_i & !valid_o,ray,prim,i,tNear);
+          if (none(valid)) continue;
+          STAT3(shadow.trav_prims,1,popcnt(valid),K);
+          const unsigned int geomID = prim.geomID(N);
+          const unsigned int primID = prim.primID(N)[i];
+          const CurveGeometry* geom = context->scene->get<CurveGeometry>(geomID);
+          Vec3ff a0,a1,a2,a3; geom->gather(a0,a1,a2,a3,geom->curve(primID));
+          valid_o |= Intersector().template intersect<Epilog>(valid,pre,ray,context,geom,geomID,primID,a0,a1,a2,a3);
+          if (none(valid_i & !valid_o)) break;
+        }
+      }
       
       template<typename Intersector, typename Epilog>
         static __forceinline void intersect_t(Precalculations& pre, RayHitK<K>& ray, const size_t k, IntersectContext* context, const Primitive& prim)
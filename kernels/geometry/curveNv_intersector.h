@@ -100,6 +100,50 @@ namespace embree
       typedef CurveNv<M> Primitive;
       typedef CurvePrecalculationsK<K> Precalculations;
 
+      template<typename Intersector, typename Epilog>
+        static __forceinline void intersect_packet_t(const vbool<K>& valid_i, Precalculations& pre, RayHitK<K>& ray, IntersectContext* context, const Primitive& prim)
+      {
+        const size_t N = prim.N;
+        for (size_t i=0; i<N; i++)
+        {
+          vfloat<K> tNear;
+          const vbool<K> valid = CurveNiIntersectorK<M,K>::intersect(valid_i,ray,prim,i,tNear);
+          if (none(valid)) continue;
+          STAT3(normal.trav_prims,1,popcnt(valid),K);
+          const unsigned int geomID = prim.geomID(N);
+          const unsigned int primID = prim.primID(N)[i];
+          const CurveGeometry* geom = (CurveGeometry*) context->scene->get(geomID);
+          const Vec3ff a0 = Vec3ff::loadu(&prim.vertices(i,N)[0]);
+          const Vec3ff a1 = Vec3ff::loadu(&prim.vertices(i,N)[1]);
+          const Vec3ff a2 = Vec3ff::loadu(&prim.vertices(i,N)[2]);
+          const Vec3ff a3 = Vec3ff::loadu(&prim.vertices(i,N)[3]);
+          Intersector().template intersect<Epilog>(valid,pre,ray,context,geom,geomID,primID,a0,a1,a2,a3);
+        }
+      }
+
+      template<typename Intersector, typename Epilog>
+        static __forceinline void occluded_packet_t(const vbool<K>& valid_i, vbool<K>& valid_o, Precalculations& pre, RayK<K>& ray, IntersectContext* context, const Primitive& prim)
+      {
+        valid_o = false;
+        const size_t N = prim.N;
+        for (size_t i=0; i<N; i++)
+        {
+          vfloat<K> tNear;
+          const vbool<K> valid = CurveNiIntersectorK<M,K>::intersect(valid_i & !valid_o,ray,prim,i,tNear);
+          if (none(valid)) continue;
+          STAT3(shadow.trav_prims,1,popcnt(valid),K);
+          const unsigned int geomID = prim.geomID(N);
+          const unsigned int primID = prim.primID(N)[i];
+          const CurveGeometry* geom = (CurveGeometry*) context->scene->get(geomID);
+          const Vec3ff a0 = Vec3ff::loadu(&prim.vertices(i,N)[0]);
+          const Vec3ff a1 = Vec3ff::loadu(&prim.vertices(i,N)[1]);
+          const Vec3ff a2 = Vec3ff::loadu(&prim.vertices(i,N)[2]);
+          const Vec3ff a3 = Vec3ff::loadu(&prim.vertices(i,N)[3]);
+          valid_o |= Intersector().template intersect<Epilog>(valid,pre,ray,context,geom,geomID,primID,a0,a1,a2,a3);
+          if (none(valid_i & !valid_o)) break;
+        }
+      }
+
       template<typename Intersector, typename Epilog>
         static __forceinline void intersect_t(Precalculations& pre, RayHitK<K>& ray, const size_t k, IntersectContext* context, const Primitive& prim)
       {
@@ -56,7 +56,7 @@ namespace embree
                                    const Vec3fa& v0, const Vec3fa& v1, const Vec3fa& v2, const Vec3fa& v3,
                                    const Epilog& epilog)
       {
-        const int N = geom->tessellationRate;
+        const int N = geom->tessellationRateOf(primID);
         
         /* transform control points into ray space */
         const NativeCurve3fa curve3Di(v0,v1,v2,v3);
@@ -31,6 +31,7 @@ namespace embree
     {
       vfloat<K> depth_scale;
       LinearSpace3fa ray_space[K];
+      LinearSpace3<Vec3vf<K>> ray_space_k; //!< ray spaces in SoA layout for intersecting all rays of the packet at once
 
       __forceinline CurvePrecalculationsK(const vbool<K>& valid, const RayK<K>& ray)
       {
@@ -42,6 +43,9 @@ namespace embree
           LinearSpace3fa ray_space_k = frame(depth_scale[k]*ray_dir_k);
           ray_space_k.vz *= depth_scale[k];
           ray_space[k] = ray_space_k.transposed();
+          this->ray_space_k.vx.x[k] = ray_space[k].vx.x; this->ray_space_k.vx.y[k] = ray_space[k].vx.y; this->ray_space_k.vx.z[k] = ray_space[k].vx.z;
+          this->ray_space_k.vy.x[k] = ray_space[k].vy.x; this->ray_space_k.vy.y[k] = ray_space[k].vy.y; this->ray_space_k.vy.z[k] = ray_space[k].vy.z;
+          this->ray_space_k.vz.x[k] = ray_space[k].vz.x; this->ray_space_k.vz.y[k] = ray_space[k].vz.y; this->ray_space_k.vz.z[k] = ray_space[k].vz.z;
         }
       }
     };
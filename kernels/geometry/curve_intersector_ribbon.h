@@ -165,6 +165,108 @@ namespace embree
       return ishit;
     }
         
+    /* intersects all rays of a packet with the ribbon of a single curve,
+     * the SIMD lanes process the rays instead of the curve segments. The
+     * hits of each ray are passed to the epilog in the same chunks of
+     * VSIZEX segments as intersect_ribbon does. */
+    template<typename NativeCurve3ff, int K, typename Epilog>
+    __forceinline vbool<K> intersect_ribbon_k(const vbool<K>& valid_i, const CurvePrecalculationsK<K>& pre, RayK<K>& ray,
+                                              IntersectContext* context, const CurveGeometry* geom,
+                                              const NativeCurve3ff& curve3D, const int N,
+                                              const Epilog& epilog)
+    {
+      typedef Vec2<vfloat<K>> Vec2vfK;
+      typedef Vec3<vfloat<K>> Vec3vfK;
+      typedef Vec4<vfloat<K>> Vec4vfK;
+
+      /* transform control points into the ray space of each ray */
+      Vec4vfK q[4];
+      const Vec3ff v[4] = { curve3D.v0, curve3D.v1, curve3D.v2, curve3D.v3 };
+      vfloat<K> eps = 0.0f;
+      for (size_t j=0; j<4; j++)
+      {
+        const Vec4vfK vj = enlargeRadiusToMinWidth(context,geom,ray.org,Vec4vfK(v[j]));
+        const Vec3vfK qj = xfmVector(pre.ray_space_k,Vec3vfK(vj.x,vj.y,vj.z)-ray.org);
+        q[j] = Vec4vfK(qj.x,qj.y,qj.z,vj.w);
+        eps = max(eps,abs(qj.x),abs(qj.y),abs(qj.z));
+      }
+      eps *= 4.0f*float(ulp);
+
+      /* the basis functions of the curve are obtained by evaluating unit curves */
+      const Vec3ff one(1.0f), zero3(0.0f);
+      const NativeCurve3ff e0(one,zero3,zero3,zero3), e1(zero3,one,zero3,zero3), e2(zero3,zero3,one,zero3), e3(zero3,zero3,zero3,one);
+
+      vbool<K> ishit = false;
+      for (int i=0; i<N; i+=VSIZEX)
+      {
+        const vfloatx c00 = e0.template eval0<VSIZEX>(i,N).x, c01 = e1.template eval0<VSIZEX>(i,N).x, c02 = e2.template eval0<VSIZEX>(i,N).x, c03 = e3.template eval0<VSIZEX>(i,N).x;
+        const vfloatx c10 = e0.template eval1<VSIZEX>(i,N).x, c11 = e1.template eval1<VSIZEX>(i,N).x, c12 = e2.template eval1<VSIZEX>(i,N).x, c13 = e3.template eval1<VSIZEX>(i,N).x;
+        const vfloatx d00 = e0.template derivative0<VSIZEX>(i,N).x, d01 = e1.template derivative0<VSIZEX>(i,N).x, d02 = e2.template derivative0<VSIZEX>(i,N).x, d03 = e3.template derivative0<VSIZEX>(i,N).x;
+        const vfloatx d10 = e0.template derivative1<VSIZEX>(i,N).x, d11 = e1.template derivative1<VSIZEX>(i,N).x, d12 = e2.template derivative1<VSIZEX>(i,N).x, d13 = e3.template derivative1<VSIZEX>(i,N).x;
+
+        /* intersect each segment of this chunk with all rays */
+        vfloat<K> su[VSIZEX], sv[VSIZEX], st[VSIZEX];
+        size_t smask[VSIZEX];
+        size_t mask = 0;
+        for (int j=0; j<VSIZEX; j++)
+        {
+          smask[j] = 0;
+          if (i+j >= N) continue;
+          
+          const Vec4vfK p0 = madd(vfloat<K>(c00[j]),q[0],madd(vfloat<K>(c01[j]),q[1],madd(vfloat<K>(c02[j]),q[2],vfloat<K>(c03[j])*q[3])));
+          const Vec4vfK p1 = madd(vfloat<K>(c10[j]),q[0],madd(vfloat<K>(c11[j]),q[1],madd(vfloat<K>(c12[j]),q[2],vfloat<K>(c13[j])*q[3])));
+          const Vec2vfK p0xy(p0.x,p0.y), p1xy(p1.x,p1.y);
+          const vfloat<K> r = max(p0.w,p1.w);
+          const vfloat<K> num = det(p1xy-p0xy,p0xy);
+          vbool<K> valid = valid_i & (num*num <= r*r*dot(p1xy-p0xy,p1xy-p0xy));
+          if (none(valid)) continue;
+
+          Vec3vfK dp0dt = Vec3vfK(madd(vfloat<K>(d00[j]),q[0],madd(vfloat<K>(d01[j]),q[1],madd(vfloat<K>(d02[j]),q[2],vfloat<K>(d03[j])*q[3]))));
+          Vec3vfK dp1dt = Vec3vfK(madd(vfloat<K>(d10[j]),q[0],madd(vfloat<K>(d11[j]),q[1],madd(vfloat<K>(d12[j]),q[2],vfloat<K>(d13[j])*q[3]))));
+          dp0dt = select(reduce_max(abs(dp0dt)) < eps,Vec3vfK(p1-p0),dp0dt);
+          dp1dt = select(reduce_max(abs(dp1dt)) < eps,Vec3vfK(p1-p0),dp1dt);
+          const Vec3vfK n0(dp0dt.y,-dp0dt.x,0.0f);
+          const Vec3vfK n1(dp1dt.y,-dp1dt.x,0.0f);
+          const Vec3vfK nn0 = normalize(n0);
+          const Vec3vfK nn1 = normalize(n1);
+          const Vec3vfK lp0 = madd(p0.w,nn0,Vec3vfK(p0));
+          const Vec3vfK lp1 = madd(p1.w,nn1,Vec3vfK(p1));
+          const Vec3vfK up0 = nmadd(p0.w,nn0,Vec3vfK(p0));
+          const Vec3vfK up1 = nmadd(p1.w,nn1,Vec3vfK(p1));
+
+          vfloat<K> vu,vv,vt;
+          valid = intersect_quad_backface_culling<K>(valid,zero,Vec3fa(0,0,1),ray.tnear(),ray.tfar,lp0,lp1,up1,up0,vu,vv,vt);
+
+          /* ignore self intersections */
+          if (EMBREE_CURVE_SELF_INTERSECTION_AVOIDANCE_FACTOR != 0.0f) {
+            vfloat<K> r = lerp(p0.w, p1.w, vu);
+            valid &= vt > float(EMBREE_CURVE_SELF_INTERSECTION_AVOIDANCE_FACTOR)*r*pre.depth_scale;
+          }
+          
+          su[j] = vu; sv[j] = madd(2.0f,vv,vfloat<K>(-1.0f)); st[j] = vt;
+          smask[j] = movemask(valid);
+          mask |= smask[j];
+        }
+
+        /* report the hits of this chunk per ray */
+        while (mask)
+        {
+          const size_t k = bscf(mask);
+          vboolx valid = false;
+          vfloatx U = zero, V = zero, T = zero;
+          for (int j=0; j<VSIZEX; j++) {
+            if (((smask[j] >> k) & 1) == 0) continue;
+            set(valid,j);
+            U[j] = su[j][k]; V[j] = sv[j][k]; T[j] = st[j][k];
+          }
+          RibbonHit<NativeCurve3ff,VSIZEX> bhit(valid,U,V,T,i,N,curve3D);
+          if (epilog(k,bhit.valid,bhit))
+            set(ishit,k);
+        }
+      }
+      return ishit;
+    }
+        
     template<template<typename Ty> class NativeCurve>
     struct RibbonCurve1Intersector1
     {
@@ -177,7 +279,7 @@ namespace embree
                                    const Vec3ff& v0, const Vec3ff& v1, const Vec3ff& v2, const Vec3ff& v3,
                                    const Epilog& epilog)
       {
-        const int N = geom->tessellationRate;
+        const int N = geom->tessellationRateOf(primID);
         NativeCurve3ff curve(v0,v1,v2,v3);
         curve = enlargeRadiusToMinWidth(context,geom,ray.org,curve);
         return intersect_ribbon<NativeCurve3ff>(ray.org,ray.dir,ray.tnear(),ray.tfar,
@@ -199,7 +301,7 @@ namespace embree
                                    const Vec3ff& v0, const Vec3ff& v1, const Vec3ff& v2, const Vec3ff& v3,
                                    const Epilog& epilog)
       {
-        const int N = geom->tessellationRate;
+        const int N = geom->tessellationRateOf(primID);
         const Vec3fa ray_org(ray.org.x[k],ray.org.y[k],ray.org.z[k]);
         const Vec3fa ray_dir(ray.dir.x[k],ray.dir.y[k],ray.dir.z[k]);
         NativeCurve3ff curve(v0,v1,v2,v3);
@@ -209,6 +311,19 @@ namespace embree
                                                 curve,N,
                                                 epilog);
       }
+
+      template<typename Epilog, typename Ray>
+      __forceinline vbool<K> intersect(const vbool<K>& valid, const CurvePrecalculationsK<K>& pre, Ray& ray,
+                                       IntersectContext* context,
+                                       const CurveGeometry* geom, const unsigned int geomID, const unsigned int primID,
+                                       const Vec3ff& v0, const Vec3ff& v1, const Vec3ff& v2, const Vec3ff& v3)
+      {
+        const int N = geom->tessellationRateOf(primID);
+        const NativeCurve3ff curve(v0,v1,v2,v3);
+        return intersect_ribbon_k<NativeCurve3ff>(valid,pre,ray,context,geom,curve,N,[&] (const size_t k, const vboolx& valid, RibbonHit<NativeCurve3ff,VSIZEX>& hit) {
+            return Epilog(ray,k,context,geomID,primID)(valid,hit);
+          });
+      }
     };
   }
 }
@@ -134,7 +134,7 @@ namespace embree
 
     template<typename NativeCurve3ff, typename Ray, typename Epilog>
     bool intersect_bezier_recursive_jacobian(const Ray& ray, const float dt, const NativeCurve3ff& curve,
-                                             float u0, float u1, unsigned int depth, const Epilog& epilog)
+                                             float u0, float u1, unsigned int depth, unsigned int numSegments, const Epilog& epilog)
     {
 #if defined(__AVX__)
       typedef vbool8 vboolx; // maximally 8-wide to work around KNL issues
@@ -148,7 +148,10 @@ namespace embree
       typedef Vec3<vfloatx> Vec3vfx;
       typedef Vec4<vfloatx> Vec4vfx;
     
-      unsigned int maxDepth = numBezierSubdivisions;
+      /* curves that are well approximated by few linear segments require less subdivisions */
+      unsigned int maxDepth = 1;
+      for (unsigned int n=vfloatx::size-1; maxDepth<numBezierSubdivisions && (numSegments == 0 || n < numSegments); n*=vfloatx::size-1)
+        maxDepth++;
       bool found = false;
       const Vec3fa org = zero;
       const Vec3fa dir = ray.dir;
@@ -313,7 +316,7 @@ namespace embree
         const float dt = dot(curve0.center()-ray.org,ray.dir)*rcp(dot(ray.dir,ray.dir));
         const Vec3ff ref(madd(Vec3fa(dt),ray.dir,ray.org),0.0f);
         const NativeCurve3ff curve1 = curve0-ref;
-        return intersect_bezier_recursive_jacobian(ray,dt,curve1,0.0f,1.0f,1,epilog);
+        return intersect_bezier_recursive_jacobian(ray,dt,curve1,0.0f,1.0f,1,geom->numSegments(primID),epilog);
       }
     };
 
@@ -355,7 +358,24 @@ namespace embree
         const float dt = dot(curve0.center()-ray.org,ray.dir)*rcp(dot(ray.dir,ray.dir));
         const Vec3ff ref(madd(Vec3fa(dt),ray.dir,ray.org),0.0f);
         const NativeCurve3ff curve1 = curve0-ref;
-        return intersect_bezier_recursive_jacobian(ray,dt,curve1,0.0f,1.0f,1,epilog);
+        return intersect_bezier_recursive_jacobian(ray,dt,curve1,0.0f,1.0f,1,geom->numSegments(primID),epilog);
+      }
+
+      /* the recursive subdivision is data dependent per ray, thus the rays of the packet get processed one after the other */
+      template<typename Epilog, typename Ray>
+      __forceinline vbool<K> intersect(const vbool<K>& valid, const CurvePrecalculationsK<K>& pre, Ray& ray,
+                                       IntersectContext* context,
+                                       const CurveGeometry* geom, const unsigned int geomID, const unsigned int primID,
+                                       const Vec3ff& v0, const Vec3ff& v1, const Vec3ff& v2, const Vec3ff& v3)
+      {
+        vbool<K> valid_o = false;
+        size_t mask = movemask(valid);
+        while (mask) {
+          const size_t k = bscf(mask);
+          if (intersect(pre,ray,k,context,geom,primID,v0,v1,v2,v3,Epilog(ray,k,context,geomID,primID)))
+            set(valid_o,k);
+        }
+        return valid_o;
       }
     };
   }
@@ -87,6 +87,25 @@ namespace embree
       return &function_local_static_prim;
     }
 
+    VirtualCurveIntersector* VirtualCurveIntersector4c()
+    {
+      static VirtualCurveIntersector function_local_static_prim;
+      AddVirtualCurvePointInterector4v(function_local_static_prim);
+      AddVirtualCurveLinearCurveInterector4v(function_local_static_prim);
+      AddVirtualCurveBezierCurveInterector4c(function_local_static_prim);
+      AddVirtualCurveBSplineCurveInterector4c(function_local_static_prim);
+      AddVirtualCurveHermiteCurveInterector4v(function_local_static_prim);
+      AddVirtualCurveCatmullRomCurveInterector4v(function_local_static_prim);
+      return &function_local_static_prim;
+    }
+
+    VirtualCurveIntersector* VirtualPointIntersector4v()
+    {
+      static VirtualCurveIntersector function_local_static_prim;
+      AddVirtualPointInterector4v(function_local_static_prim);
+      return &function_local_static_prim;
+    }
+
     VirtualCurveIntersector* VirtualCurveIntersector4iMB()
     {
       static VirtualCurveIntersector function_local_static_prim;
@@ -19,6 +19,7 @@
 
 #include "spherei_intersector.h"
 #include "disci_intersector.h"
+#include "pointv_intersector.h"
 
 #include "linei_intersector.h"
 #include "roundlinei_intersector.h"
@@ -26,6 +27,7 @@
 
 #include "curveNi_intersector.h"
 #include "curveNv_intersector.h"
+#include "curveNc_intersector.h"
 #include "curveNi_mb_intersector.h"
 
 #include "curve_intersector_distance.h"
@@ -49,6 +51,9 @@ namespace embree
     typedef void (*Intersect16Ty)(void* pre, void* ray, size_t k, IntersectContext* context, const void* primitive);
     typedef bool (*Occluded16Ty) (void* pre, void* ray, size_t k, IntersectContext* context, const void* primitive);
 
+    typedef void (*IntersectKTy)(const void* valid, void* pre, void* ray, IntersectContext* context, const void* primitive);
+    typedef void (*OccludedKTy) (const void* valid, void* valid_o, void* pre, void* ray, IntersectContext* context, const void* primitive);
+
   public:
     struct Intersectors
     {
@@ -72,6 +77,26 @@ namespace embree
     };
     
     Intersectors vtbl[Geometry::GTY_END];
+
+  public:
+    /* intersectors that process all rays of a packet with a curve at once */
+    struct PacketIntersectors
+    {
+      PacketIntersectors() {} // WARNING: Do not zero initialize this, see Intersectors above.
+
+      template<int K> bool intersect(const vbool<K>& valid, void* pre, void* ray, IntersectContext* context, const void* primitive);
+      template<int K> bool occluded (const vbool<K>& valid, vbool<K>& valid_o, void* pre, void* ray, IntersectContext* context, const void* primitive);
+
+    public:
+      IntersectKTy intersect4;
+      OccludedKTy  occluded4;
+      IntersectKTy intersect8;
+      OccludedKTy  occluded8;
+      IntersectKTy intersect16;
+      OccludedKTy  occluded16;
+    };
+
+    PacketIntersectors vtblK[Geometry::GTY_END]; //!< optional packet intersectors, null if the rays of a packet have to get processed one after the other
   };
 
   template<> __forceinline void VirtualCurveIntersector::Intersectors::intersect<1> (void* pre, void* ray, IntersectContext* context, const void* primitive) { assert(intersect1); intersect1(pre,ray,context,primitive); }
@@ -90,6 +115,31 @@ namespace embree
   template<> __forceinline bool VirtualCurveIntersector::Intersectors::occluded<16> (void* pre, void* ray, size_t k, IntersectContext* context, const void* primitive) { assert(occluded16); return occluded16(pre,ray,k,context,primitive); }
 #endif
   
+  template<> __forceinline bool VirtualCurveIntersector::PacketIntersectors::intersect<4>(const vbool4& valid, void* pre, void* ray, IntersectContext* context, const void* primitive) {
+    if (!intersect4) return false; intersect4(&valid,pre,ray,context,primitive); return true;
+  }
+  template<> __forceinline bool VirtualCurveIntersector::PacketIntersectors::occluded<4> (const vbool4& valid, vbool4& valid_o, void* pre, void* ray, IntersectContext* context, const void* primitive) {
+    if (!occluded4) return false; occluded4(&valid,&valid_o,pre,ray,context,primitive); return true;
+  }
+
+#if defined(__AVX__)
+  template<> __forceinline bool VirtualCurveIntersector::PacketIntersectors::intersect<8>(const vbool8& valid, void* pre, void* ray, IntersectContext* context, const void* primitive) {
+    if (!intersect8) return false; intersect8(&valid,pre,ray,context,primitive); return true;
+  }
+  template<> __forceinline bool VirtualCurveIntersector::PacketIntersectors::occluded<8> (const vbool8& valid, vbool8& valid_o, void* pre, void* ray, IntersectContext* context, const void* primitive) {
+    if (!occluded8) return false; occluded8(&valid,&valid_o,pre,ray,context,primitive); return true;
+  }
+#endif
+
+#if defined(__AVX512F__)
+  template<> __forceinline bool VirtualCurveIntersector::PacketIntersectors::intersect<16>(const vbool16& valid, void* pre, void* ray, IntersectContext* context, const void* primitive) {
+    if (!intersect16) return false; intersect16(&valid,pre,ray,context,primitive); return true;
+  }
+  template<> __forceinline bool VirtualCurveIntersector::PacketIntersectors::occluded<16> (const vbool16& valid, vbool16& valid_o, void* pre, void* ray, IntersectContext* context, const void* primitive) {
+    if (!occluded16) return false; occluded16(&valid,&valid_o,pre,ray,context,primitive); return true;
+  }
+#endif
+
   namespace isa
   {
     struct VirtualCurveIntersector1
@@ -130,6 +180,8 @@ namespace embree
           assert(num == 1);
           RTCGeometryType ty = (RTCGeometryType)(*prim);
           assert(This->leafIntersector);
+          VirtualCurveIntersector::PacketIntersectors& packetIntersector = ((VirtualCurveIntersector*) This->leafIntersector)->vtblK[ty];
+          if (packetIntersector.intersect<K>(valid_i,&pre,&ray,context,prim)) return;
           VirtualCurveIntersector::Intersectors& leafIntersector = ((VirtualCurveIntersector*) This->leafIntersector)->vtbl[ty];
           size_t mask = movemask(valid_i);
           while (mask) leafIntersector.intersect<K>(&pre,&ray,bscf(mask),context,prim);
@@ -141,8 +193,10 @@ namespace embree
           assert(num == 1);
           RTCGeometryType ty = (RTCGeometryType)(*prim);
           assert(This->leafIntersector);
-          VirtualCurveIntersector::Intersectors& leafIntersector = ((VirtualCurveIntersector*) This->leafIntersector)->vtbl[ty];
           vbool<K> valid_o = false;
+          VirtualCurveIntersector::PacketIntersectors& packetIntersector = ((VirtualCurveIntersector*) This->leafIntersector)->vtblK[ty];
+          if (packetIntersector.occluded<K>(valid_i,valid_o,&pre,&ray,context,prim)) return valid_o;
+          VirtualCurveIntersector::Intersectors& leafIntersector = ((VirtualCurveIntersector*) This->leafIntersector)->vtbl[ty];
           size_t mask = movemask(valid_i);
           while (mask) {
             size_t k = bscf(mask);
@@ -402,6 +456,63 @@ namespace embree
       return intersectors;
     }
     
+    template<int N>
+      static VirtualCurveIntersector::Intersectors SphereNvIntersectors()
+    {
+      VirtualCurveIntersector::Intersectors intersectors;
+      intersectors.intersect1 = (VirtualCurveIntersector::Intersect1Ty) &SphereMvIntersector1<N,true>::intersect;
+      intersectors.occluded1  = (VirtualCurveIntersector::Occluded1Ty)  &SphereMvIntersector1<N,true>::occluded;
+      intersectors.intersect4 = (VirtualCurveIntersector::Intersect4Ty) &SphereMvIntersectorK<N,4,true>::intersect;
+      intersectors.occluded4  = (VirtualCurveIntersector::Occluded4Ty)  &SphereMvIntersectorK<N,4,true>::occluded;
+#if defined(__AVX__)
+      intersectors.intersect8 = (VirtualCurveIntersector::Intersect8Ty)&SphereMvIntersectorK<N,8,true>::intersect;
+      intersectors.occluded8  = (VirtualCurveIntersector::Occluded8Ty) &SphereMvIntersectorK<N,8,true>::occluded;
+#endif
+#if defined(__AVX512F__)
+      intersectors.intersect16 = (VirtualCurveIntersector::Intersect16Ty)&SphereMvIntersectorK<N,16,true>::intersect;
+      intersectors.occluded16  = (VirtualCurveIntersector::Occluded16Ty) &SphereMvIntersectorK<N,16,true>::occluded;
+#endif
+      return intersectors;
+    }
+    
+    template<int N>
+      static VirtualCurveIntersector::Intersectors DiscNvIntersectors()
+    {
+      VirtualCurveIntersector::Intersectors intersectors;
+      intersectors.intersect1 = (VirtualCurveIntersector::Intersect1Ty) &DiscMvIntersector1<N,true>::intersect;
+      intersectors.occluded1  = (VirtualCurveIntersector::Occluded1Ty)  &DiscMvIntersector1<N,true>::occluded;
+      intersectors.intersect4 = (VirtualCurveIntersector::Intersect4Ty) &DiscMvIntersectorK<N,4,true>::intersect;
+      intersectors.occluded4  = (VirtualCurveIntersector::Occluded4Ty)  &DiscMvIntersectorK<N,4,true>::occluded;
+#if defined(__AVX__)
+      intersectors.intersect8 = (VirtualCurveIntersector::Intersect8Ty)&DiscMvIntersectorK<N,8,true>::intersect;
+      intersectors.occluded8  = (VirtualCurveIntersector::Occluded8Ty) &DiscMvIntersectorK<N,8,true>::occluded;
+#endif
+#if defined(__AVX512F__)
+      intersectors.intersect16 = (VirtualCurveIntersector::Intersect16Ty)&DiscMvIntersectorK<N,16,true>::intersect;
+      intersectors.occluded16  = (VirtualCurveIntersector::Occluded16Ty) &DiscMvIntersectorK<N,16,true>::occluded;
+#endif
+      return intersectors;
+    }
+    
+    template<int N>
+      static VirtualCurveIntersector::Intersectors OrientedDiscNvIntersectors()
+    {
+      VirtualCurveIntersector::Intersectors intersectors;
+      intersectors.intersect1 = (VirtualCurveIntersector::Intersect1Ty) &OrientedDiscMvIntersector1<N,true>::intersect;
+      intersectors.occluded1  = (VirtualCurveIntersector::Occluded1Ty)  &OrientedDiscMvIntersector1<N,true>::occluded;
+      intersectors.intersect4 = (VirtualCurveIntersector::Intersect4Ty) &OrientedDiscMvIntersectorK<N,4,true>::intersect;
+      intersectors.occluded4  = (VirtualCurveIntersector::Occluded4Ty)  &OrientedDiscMvIntersectorK<N,4,true>::occluded;
+#if defined(__AVX__)
+      intersectors.intersect8 = (VirtualCurveIntersector::Intersect8Ty)&OrientedDiscMvIntersectorK<N,8,true>::intersect;
+      intersectors.occluded8  = (VirtualCurveIntersector::Occluded8Ty) &OrientedDiscMvIntersectorK<N,8,true>::occluded;
+#endif
+#if defined(__AVX512F__)
+      intersectors.intersect16 = (VirtualCurveIntersector::Intersect16Ty)&OrientedDiscMvIntersectorK<N,16,true>::intersect;
+      intersectors.occluded16  = (VirtualCurveIntersector::Occluded16Ty) &OrientedDiscMvIntersectorK<N,16,true>::occluded;
+#endif
+      return intersectors;
+    }
+    
     template<template<typename Ty> class Curve, int N>
       static VirtualCurveIntersector::Intersectors RibbonNiIntersectors()
     {
@@ -440,6 +551,25 @@ namespace embree
       return intersectors;
     }
     
+    template<template<typename Ty> class Curve, int N>
+      static VirtualCurveIntersector::Intersectors RibbonNcIntersectors()
+    {
+      VirtualCurveIntersector::Intersectors intersectors;
+      intersectors.intersect1 = (VirtualCurveIntersector::Intersect1Ty) &CurveNcIntersector1<N>::template intersect_t<RibbonCurve1Intersector1<Curve>, Intersect1EpilogMU<VSIZEX,true> >;
+      intersectors.occluded1  = (VirtualCurveIntersector::Occluded1Ty)  &CurveNcIntersector1<N>::template occluded_t <RibbonCurve1Intersector1<Curve>, Occluded1EpilogMU<VSIZEX,true> >;
+      intersectors.intersect4 = (VirtualCurveIntersector::Intersect4Ty) &CurveNcIntersectorK<N,4>::template intersect_t<RibbonCurve1IntersectorK<Curve,4>, Intersect1KEpilogMU<VSIZEX,4,true> >;
+      intersectors.occluded4  = (VirtualCurveIntersector::Occluded4Ty)  &CurveNcIntersectorK<N,4>::template occluded_t <RibbonCurve1IntersectorK<Curve,4>, Occluded1KEpilogMU<VSIZEX,4,true> >;
+#if defined(__AVX__)
+      intersectors.intersect8 = (VirtualCurveIntersector::Intersect8Ty)&CurveNcIntersectorK<N,8>::template intersect_t<RibbonCurve1IntersectorK<Curve,8>, Intersect1KEpilogMU<VSIZEX,8,true> >;
+      intersectors.occluded8  = (VirtualCurveIntersector::Occluded8Ty) &CurveNcIntersectorK<N,8>::template occluded_t <RibbonCurve1IntersectorK<Curve,8>, Occluded1KEpilogMU<VSIZEX,8,true> >;
+#endif
+#if defined(__AVX512F__)
+      intersectors.intersect16 = (VirtualCurveIntersector::Intersect16Ty)&CurveNcIntersectorK<N,16>::template intersect_t<RibbonCurve1IntersectorK<Curve,16>, Intersect1KEpilogMU<VSIZEX,16,true> >;
+      intersectors.occluded16  = (VirtualCurveIntersector::Occluded16Ty) &CurveNcIntersectorK<N,16>::template occluded_t <RibbonCurve1IntersectorK<Curve,16>, Occluded1KEpilogMU<VSIZEX,16,true> >;
+#endif
+      return intersectors;
+    }
+    
     template<template<typename Ty> class Curve, int N>
       static VirtualCurveIntersector::Intersectors RibbonNiMBIntersectors()
     {
@@ -497,6 +627,25 @@ namespace embree
       return intersectors;
     }
     
+    template<template<typename Ty> class Curve, int N>
+      static VirtualCurveIntersector::Intersectors CurveNcIntersectors()
+    {
+      VirtualCurveIntersector::Intersectors intersectors;
+      intersectors.intersect1 = (VirtualCurveIntersector::Intersect1Ty) &CurveNcIntersector1<N>::template intersect_t<SweepCurve1Intersector1<Curve>, Intersect1Epilog1<true> >;
+      intersectors.occluded1  = (VirtualCurveIntersector::Occluded1Ty)  &CurveNcIntersector1<N>::template occluded_t <SweepCurve1Intersector1<Curve>, Occluded1Epilog1<true> >;
+      intersectors.intersect4 = (VirtualCurveIntersector::Intersect4Ty)&CurveNcIntersectorK<N,4>::template intersect_t<SweepCurve1IntersectorK<Curve,4>, Intersect1KEpilog1<4,true> >;
+      intersectors.occluded4  = (VirtualCurveIntersector::Occluded4Ty) &CurveNcIntersectorK<N,4>::template occluded_t <SweepCurve1IntersectorK<Curve,4>, Occluded1KEpilog1<4,true> >;
+#if defined(__AVX__)
+      intersectors.intersect8 = (VirtualCurveIntersector::Intersect8Ty)&CurveNcIntersectorK<N,8>::template intersect_t<SweepCurve1IntersectorK<Curve,8>, Intersect1KEpilog1<8,true> >;
+      intersectors.occluded8  = (VirtualCurveIntersector::Occluded8Ty) &CurveNcIntersectorK<N,8>::template occluded_t <SweepCurve1IntersectorK<Curve,8>, Occluded1KEpilog1<8,true> >;
+#endif
+#if defined(__AVX512F__)
+      intersectors.intersect16 = (VirtualCurveIntersector::Intersect16Ty)&CurveNcIntersectorK<N,16>::template intersect_t<SweepCurve1IntersectorK<Curve,16>, Intersect1KEpilog1<16,true> >;
+      intersectors.occluded16  = (VirtualCurveIntersector::Occluded16Ty) &CurveNcIntersectorK<N,16>::template occluded_t <SweepCurve1IntersectorK<Curve,16>, Occluded1KEpilog1<16,true> >;
+#endif
+      return intersectors;
+    }
+    
     template<template<typename Ty> class Curve, int N>
       static VirtualCurveIntersector::Intersectors CurveNiMBIntersectors()
     {
@@ -664,6 +813,108 @@ namespace embree
 #if defined(__AVX512F__)
       intersectors.intersect16 = (VirtualCurveIntersector::Intersect16Ty)&CurveNiMBIntersectorK<N,16>::template intersect_hn<OrientedCurve1IntersectorK<Curve,16>, Intersect1KEpilog1<16,true> >;
       intersectors.occluded16  = (VirtualCurveIntersector::Occluded16Ty) &CurveNiMBIntersectorK<N,16>::template occluded_hn <OrientedCurve1IntersectorK<Curve,16>, Occluded1KEpilog1<16,true> >;
+#endif
+      return intersectors;
+    }
+
+    template<template<typename Ty> class Curve, int N>
+      static VirtualCurveIntersector::PacketIntersectors RibbonNiPacketIntersectors()
+    {
+      VirtualCurveIntersector::PacketIntersectors intersectors;
+      intersectors.intersect4 = (VirtualCurveIntersector::IntersectKTy)&CurveNiIntersectorK<N,4>::template intersect_packet_t<RibbonCurve1IntersectorK<Curve,4>, Intersect1KEpilogMU<VSIZEX,4,true> >;
+      intersectors.occluded4  = (VirtualCurveIntersector::OccludedKTy) &CurveNiIntersectorK<N,4>::template occluded_packet_t <RibbonCurve1IntersectorK<Curve,4>, Occluded1KEpilogMU<VSIZEX,4,true> >;
+#if defined(__AVX__)
+      intersectors.intersect8 = (VirtualCurveIntersector::IntersectKTy)&CurveNiIntersectorK<N,8>::template intersect_packet_t<RibbonCurve1IntersectorK<Curve,8>, Intersect1KEpilogMU<VSIZEX,8,true> >;
+      intersectors.occluded8  = (VirtualCurveIntersector::OccludedKTy) &CurveNiIntersectorK<N,8>::template occluded_packet_t <RibbonCurve1IntersectorK<Curve,8>, Occluded1KEpilogMU<VSIZEX,8,true> >;
+#endif
+#if defined(__AVX512F__)
+      intersectors.intersect16 = (VirtualCurveIntersector::IntersectKTy)&CurveNiIntersectorK<N,16>::template intersect_packet_t<RibbonCurve1IntersectorK<Curve,16>, Intersect1KEpilogMU<VSIZEX,16,true> >;
+      intersectors.occluded16  = (VirtualCurveIntersector::OccludedKTy) &CurveNiIntersectorK<N,16>::template occluded_packet_t <RibbonCurve1IntersectorK<Curve,16>, Occluded1KEpilogMU<VSIZEX,16,true> >;
+#endif
+      return intersectors;
+    }
+
+    template<template<typename Ty> class Curve, int N>
+      static VirtualCurveIntersector::PacketIntersectors RibbonNvPacketIntersectors()
+    {
+      VirtualCurveIntersector::PacketIntersectors intersectors;
+      intersectors.intersect4 = (VirtualCurveIntersector::IntersectKTy)&CurveNvIntersectorK<N,4>::template intersect_packet_t<RibbonCurve1IntersectorK<Curve,4>, Intersect1KEpilogMU<VSIZEX,4,true> >;
+      intersectors.occluded4  = (VirtualCurveIntersector::OccludedKTy) &CurveNvIntersectorK<N,4>::template occluded_packet_t <RibbonCurve1IntersectorK<Curve,4>, Occluded1KEpilogMU<VSIZEX,4,true> >;
+#if defined(__AVX__)
+      intersectors.intersect8 = (VirtualCurveIntersector::IntersectKTy)&CurveNvIntersectorK<N,8>::template intersect_packet_t<RibbonCurve1IntersectorK<Curve,8>, Intersect1KEpilogMU<VSIZEX,8,true> >;
+      intersectors.occluded8  = (VirtualCurveIntersector::OccludedKTy) &CurveNvIntersectorK<N,8>::template occluded_packet_t <RibbonCurve1IntersectorK<Curve,8>, Occluded1KEpilogMU<VSIZEX,8,true> >;
+#endif
+#if defined(__AVX512F__)
+      intersectors.intersect16 = (VirtualCurveIntersector::IntersectKTy)&CurveNvIntersectorK<N,16>::template intersect_packet_t<RibbonCurve1IntersectorK<Curve,16>, Intersect1KEpilogMU<VSIZEX,16,true> >;
+      intersectors.occluded16  = (VirtualCurveIntersector::OccludedKTy) &CurveNvIntersectorK<N,16>::template occluded_packet_t <RibbonCurve1IntersectorK<Curve,16>, Occluded1KEpilogMU<VSIZEX,16,true> >;
+#endif
+      return intersectors;
+    }
+
+    template<template<typename Ty> class Curve, int N>
+      static VirtualCurveIntersector::PacketIntersectors RibbonNcPacketIntersectors()
+    {
+      VirtualCurveIntersector::PacketIntersectors intersectors;
+      intersectors.intersect4 = (VirtualCurveIntersector::IntersectKTy)&CurveNcIntersectorK<N,4>::template intersect_packet_t<RibbonCurve1IntersectorK<Curve,4>, Intersect1KEpilogMU<VSIZEX,4,true> >;
+      intersectors.occluded4  = (VirtualCurveIntersector::OccludedKTy) &CurveNcIntersectorK<N,4>::template occluded_packet_t <RibbonCurve1IntersectorK<Curve,4>, Occluded1KEpilogMU<VSIZEX,4,true> >;
+#if defined(__AVX__)
+      intersectors.intersect8 = (VirtualCurveIntersector::IntersectKTy)&CurveNcIntersectorK<N,8>::template intersect_packet_t<RibbonCurve1IntersectorK<Curve,8>, Intersect1KEpilogMU<VSIZEX,8,true> >;
+      intersectors.occluded8  = (VirtualCurveIntersector::OccludedKTy) &CurveNcIntersectorK<N,8>::template occluded_packet_t <RibbonCurve1IntersectorK<Curve,8>, Occluded1KEpilogMU<VSIZEX,8,true> >;
+#endif
+#if defined(__AVX512F__)
+      intersectors.intersect16 = (VirtualCurveIntersector::IntersectKTy)&CurveNcIntersectorK<N,16>::template intersect_packet_t<RibbonCurve1IntersectorK<Curve,16>, Intersect1KEpilogMU<VSIZEX,16,true> >;
+      intersectors.occluded16  = (VirtualCurveIntersector::OccludedKTy) &CurveNcIntersectorK<N,16>::template occluded_packet_t <RibbonCurve1IntersectorK<Curve,16>, Occluded1KEpilogMU<VSIZEX,16,true> >;
+#endif
+      return intersectors;
+    }
+
+    template<template<typename Ty> class Curve, int N>
+      static VirtualCurveIntersector::PacketIntersectors CurveNiPacketIntersectors()
+    {
+      VirtualCurveIntersector::PacketIntersectors intersectors;
+      intersectors.intersect4 = (VirtualCurveIntersector::IntersectKTy)&CurveNiIntersectorK<N,4>::template intersect_packet_t<SweepCurve1IntersectorK<Curve,4>, Intersect1KEpilog1<4,true> >;
+      intersectors.occluded4  = (VirtualCurveIntersector::OccludedKTy) &CurveNiIntersectorK<N,4>::template occluded_packet_t <SweepCurve1IntersectorK<Curve,4>, Occluded1KEpilog1<4,true> >;
+#if defined(__AVX__)
+      intersectors.intersect8 = (VirtualCurveIntersector::IntersectKTy)&CurveNiIntersectorK<N,8>::template intersect_packet_t<SweepCurve1IntersectorK<Curve,8>, Intersect1KEpilog1<8,true> >;
+      intersectors.occluded8  = (VirtualCurveIntersector::OccludedKTy) &CurveNiIntersectorK<N,8>::template occluded_packet_t <SweepCurve1IntersectorK<Curve,8>, Occluded1KEpilog1<8,true> >;
+#endif
+#if defined(__AVX512F__)
+      intersectors.intersect16 = (VirtualCurveIntersector::IntersectKTy)&CurveNiIntersectorK<N,16>::template intersect_packet_t<SweepCurve1IntersectorK<Curve,16>, Intersect1KEpilog1<16,true> >;
+      intersectors.occluded16  = (VirtualCurveIntersector::OccludedKTy) &CurveNiIntersectorK<N,16>::template occluded_packet_t <SweepCurve1IntersectorK<Curve,16>, Occluded1KEpilog1<16,true> >;
+#endif
+      return intersectors;
+    }
+
+    template<template<typename Ty> class Curve, int N>
+      static VirtualCurveIntersector::PacketIntersectors CurveNvPacketIntersectors()
+    {
+      VirtualCurveIntersector::PacketIntersectors intersectors;
+      intersectors.intersect4 = (VirtualCurveIntersector::IntersectKTy)&CurveNvIntersectorK<N,4>::template intersect_packet_t<SweepCurve1IntersectorK<Curve,4>, Intersect1KEpilog1<4,true> >;
+      intersectors.occluded4  = (VirtualCurveIntersector::OccludedKTy) &CurveNvIntersectorK<N,4>::template occluded_packet_t <SweepCurve1IntersectorK<Curve,4>, Occluded1KEpilog1<4,true> >;
+#if defined(__AVX__)
+      intersectors.intersect8 = (VirtualCurveIntersector::IntersectKTy)&CurveNvIntersectorK<N,8>::template intersect_packet_t<SweepCurve1IntersectorK<Curve,8>, Intersect1KEpilog1<8,true> >;
+      intersectors.occluded8  = (VirtualCurveIntersector::OccludedKTy) &CurveNvIntersectorK<N,8>::template occluded_packet_t <SweepCurve1IntersectorK<Curve,8>, Occluded1KEpilog1<8,true> >;
+#endif
+#if defined(__AVX512F__)
+      intersectors.intersect16 = (VirtualCurveIntersector::IntersectKTy)&CurveNvIntersectorK<N,16>::template intersect_packet_t<SweepCurve1IntersectorK<Curve,16>, Intersect1KEpilog1<16,true> >;
+      intersectors.occluded16  = (VirtualCurveIntersector::OccludedKTy) &CurveNvIntersectorK<N,16>::template occluded_packet_t <SweepCurve1IntersectorK<Curve,16>, Occluded1KEpilog1<16,true> >;
+#endif
+      return intersectors;
+    }
+
+    template<template<typename Ty> class Curve, int N>
+      static VirtualCurveIntersector::PacketIntersectors CurveNcPacketIntersectors()
+    {
+      VirtualCurveIntersector::PacketIntersectors intersectors;
+      intersectors.intersect4 = (VirtualCurveIntersector::IntersectKTy)&CurveNcIntersectorK<N,4>::template intersect_packet_t<SweepCurve1IntersectorK<Curve,4>, Intersect1KEpilog1<4,true> >;
+      intersectors.occluded4  = (VirtualCurveIntersector::OccludedKTy) &CurveNcIntersectorK<N,4>::template occluded_packet_t <SweepCurve1IntersectorK<Curve,4>, Occluded1KEpilog1<4,true> >;
+#if defined(__AVX__)
+      intersectors.intersect8 = (VirtualCurveIntersector::IntersectKTy)&CurveNcIntersectorK<N,8>::template intersect_packet_t<SweepCurve1IntersectorK<Curve,8>, Intersect1KEpilog1<8,true> >;
+      intersectors.occluded8  = (VirtualCurveIntersector::OccludedKTy) &CurveNcIntersectorK<N,8>::template occluded_packet_t <SweepCurve1IntersectorK<Curve,8>, Occluded1KEpilog1<8,true> >;
+#endif
+#if defined(__AVX512F__)
+      intersectors.intersect16 = (VirtualCurveIntersector::IntersectKTy)&CurveNcIntersectorK<N,16>::template intersect_packet_t<SweepCurve1IntersectorK<Curve,16>, Intersect1KEpilog1<16,true> >;
+      intersectors.occluded16  = (VirtualCurveIntersector::OccludedKTy) &CurveNcIntersectorK<N,16>::template occluded_packet_t <SweepCurve1IntersectorK<Curve,16>, Occluded1KEpilog1<16,true> >;
 #endif
       return intersectors;
     }
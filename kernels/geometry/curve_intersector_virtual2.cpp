@@ -96,6 +96,13 @@ namespace embree
       return &function_local_static_prim;
     }
     
+    VirtualCurveIntersector* VirtualPointIntersector8v()
+    {
+      static VirtualCurveIntersector function_local_static_prim;
+      AddVirtualPointInterector8v(function_local_static_prim);
+      return &function_local_static_prim;
+    }
+
     VirtualCurveIntersector* VirtualCurveIntersector8iMB()
     {
       static VirtualCurveIntersector function_local_static_prim;
@@ -11,11 +11,22 @@ namespace embree
       prim.vtbl[Geometry::GTY_ROUND_BEZIER_CURVE] = CurveNiIntersectors <BezierCurveT,4>();
       prim.vtbl[Geometry::GTY_FLAT_BEZIER_CURVE ] = RibbonNiIntersectors<BezierCurveT,4>();
       prim.vtbl[Geometry::GTY_ORIENTED_BEZIER_CURVE] = OrientedCurveNiIntersectors<BezierCurveT,4>();
+      prim.vtblK[Geometry::GTY_ROUND_BEZIER_CURVE] = CurveNiPacketIntersectors <BezierCurveT,4>();
+      prim.vtblK[Geometry::GTY_FLAT_BEZIER_CURVE ] = RibbonNiPacketIntersectors<BezierCurveT,4>();
     }
     void AddVirtualCurveBezierCurveInterector4v(VirtualCurveIntersector &prim) {
       prim.vtbl[Geometry::GTY_ROUND_BEZIER_CURVE] = CurveNvIntersectors <BezierCurveT,4>();
       prim.vtbl[Geometry::GTY_FLAT_BEZIER_CURVE ] = RibbonNvIntersectors<BezierCurveT,4>();
       prim.vtbl[Geometry::GTY_ORIENTED_BEZIER_CURVE] = OrientedCurveNiIntersectors<BezierCurveT,4>();
+      prim.vtblK[Geometry::GTY_ROUND_BEZIER_CURVE] = CurveNvPacketIntersectors <BezierCurveT,4>();
+      prim.vtblK[Geometry::GTY_FLAT_BEZIER_CURVE ] = RibbonNvPacketIntersectors<BezierCurveT,4>();
+    }
+    void AddVirtualCurveBezierCurveInterector4c(VirtualCurveIntersector &prim) {
+      prim.vtbl[Geometry::GTY_ROUND_BEZIER_CURVE] = CurveNcIntersectors <BezierCurveT,4>();
+      prim.vtbl[Geometry::GTY_FLAT_BEZIER_CURVE ] = RibbonNcIntersectors<BezierCurveT,4>();
+      prim.vtbl[Geometry::GTY_ORIENTED_BEZIER_CURVE] = OrientedCurveNiIntersectors<BezierCurveT,4>();
+      prim.vtblK[Geometry::GTY_ROUND_BEZIER_CURVE] = CurveNcPacketIntersectors <BezierCurveT,4>();
+      prim.vtblK[Geometry::GTY_FLAT_BEZIER_CURVE ] = RibbonNcPacketIntersectors<BezierCurveT,4>();
     }
 
     void AddVirtualCurveBezierCurveInterector4iMB(VirtualCurveIntersector &prim) {
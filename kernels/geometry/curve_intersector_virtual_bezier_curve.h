@@ -11,6 +11,7 @@ namespace embree
   {
     void AddVirtualCurveBezierCurveInterector4i(VirtualCurveIntersector &prim);
     void AddVirtualCurveBezierCurveInterector4v(VirtualCurveIntersector &prim);
+    void AddVirtualCurveBezierCurveInterector4c(VirtualCurveIntersector &prim);
     void AddVirtualCurveBezierCurveInterector4iMB(VirtualCurveIntersector &prim);
 #if defined(__AVX__)
     void AddVirtualCurveBezierCurveInterector8i(VirtualCurveIntersector &prim);
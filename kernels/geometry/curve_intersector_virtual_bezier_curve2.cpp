@@ -12,11 +12,15 @@ namespace embree
       prim.vtbl[Geometry::GTY_ROUND_BEZIER_CURVE] = CurveNiIntersectors <BezierCurveT,8>();
       prim.vtbl[Geometry::GTY_FLAT_BEZIER_CURVE ] = RibbonNiIntersectors<BezierCurveT,8>();
       prim.vtbl[Geometry::GTY_ORIENTED_BEZIER_CURVE] = OrientedCurveNiIntersectors<BezierCurveT,8>();
+      prim.vtblK[Geometry::GTY_ROUND_BEZIER_CURVE] = CurveNiPacketIntersectors <BezierCurveT,8>();
+      prim.vtblK[Geometry::GTY_FLAT_BEZIER_CURVE ] = RibbonNiPacketIntersectors<BezierCurveT,8>();
     }
     void AddVirtualCurveBezierCurveInterector8v(VirtualCurveIntersector &prim) {
       prim.vtbl[Geometry::GTY_ROUND_BEZIER_CURVE] = CurveNvIntersectors <BezierCurveT,8>();
       prim.vtbl[Geometry::GTY_FLAT_BEZIER_CURVE ] = RibbonNvIntersectors<BezierCurveT,8>();
       prim.vtbl[Geometry::GTY_ORIENTED_BEZIER_CURVE] = OrientedCurveNiIntersectors<BezierCurveT,8>();
+      prim.vtblK[Geometry::GTY_ROUND_BEZIER_CURVE] = CurveNvPacketIntersectors <BezierCurveT,8>();
+      prim.vtblK[Geometry::GTY_FLAT_BEZIER_CURVE ] = RibbonNvPacketIntersectors<BezierCurveT,8>();
     }
 
     void AddVirtualCurveBezierCurveInterector8iMB(VirtualCurveIntersector &prim) {
@@ -11,11 +11,22 @@ namespace embree
       prim.vtbl[Geometry::GTY_ROUND_BSPLINE_CURVE] = CurveNiIntersectors <BSplineCurveT,4>();
       prim.vtbl[Geometry::GTY_FLAT_BSPLINE_CURVE ] = RibbonNiIntersectors<BSplineCurveT,4>();
       prim.vtbl[Geometry::GTY_ORIENTED_BSPLINE_CURVE] = OrientedCurveNiIntersectors<BSplineCurveT,4>();
+      prim.vtblK[Geometry::GTY_ROUND_BSPLINE_CURVE] = CurveNiPacketIntersectors <BSplineCurveT,4>();
+      prim.vtblK[Geometry::GTY_FLAT_BSPLINE_CURVE ] = RibbonNiPacketIntersectors<BSplineCurveT,4>();
     }
     void AddVirtualCurveBSplineCurveInterector4v(VirtualCurveIntersector &prim) {
       prim.vtbl[Geometry::GTY_ROUND_BSPLINE_CURVE] = CurveNvIntersectors <BSplineCurveT,4>();
       prim.vtbl[Geometry::GTY_FLAT_BSPLINE_CURVE ] = RibbonNvIntersectors<BSplineCurveT,4>();
       prim.vtbl[Geometry::GTY_ORIENTED_BSPLINE_CURVE] = OrientedCurveNiIntersectors<BSplineCurveT,4>();
+      prim.vtblK[Geometry::GTY_ROUND_BSPLINE_CURVE] = CurveNvPacketIntersectors <BSplineCurveT,4>();
+      prim.vtblK[Geometry::GTY_FLAT_BSPLINE_CURVE ] = RibbonNvPacketIntersectors<BSplineCurveT,4>();
+    }
+    void AddVirtualCurveBSplineCurveInterector4c(VirtualCurveIntersector &prim) {
+      prim.vtbl[Geometry::GTY_ROUND_BSPLINE_CURVE] = CurveNcIntersectors <BSplineCurveT,4>();
+      prim.vtbl[Geometry::GTY_FLAT_BSPLINE_CURVE ] = RibbonNcIntersectors<BSplineCurveT,4>();
+      prim.vtbl[Geometry::GTY_ORIENTED_BSPLINE_CURVE] = OrientedCurveNiIntersectors<BSplineCurveT,4>();
+      prim.vtblK[Geometry::GTY_ROUND_BSPLINE_CURVE] = CurveNcPacketIntersectors <BSplineCurveT,4>();
+      prim.vtblK[Geometry::GTY_FLAT_BSPLINE_CURVE ] = RibbonNcPacketIntersectors<BSplineCurveT,4>();
     }
 
     void AddVirtualCurveBSplineCurveInterector4iMB(VirtualCurveIntersector &prim) {
@@ -11,6 +11,7 @@ namespace embree
   {
     void AddVirtualCurveBSplineCurveInterector4i(VirtualCurveIntersector &prim);
     void AddVirtualCurveBSplineCurveInterector4v(VirtualCurveIntersector &prim);
+    void AddVirtualCurveBSplineCurveInterector4c(VirtualCurveIntersector &prim);
     void AddVirtualCurveBSplineCurveInterector4iMB(VirtualCurveIntersector &prim);
 #if defined(__AVX__)
     void AddVirtualCurveBSplineCurveInterector8i(VirtualCurveIntersector &prim);
@@ -12,11 +12,15 @@ namespace embree
       prim.vtbl[Geometry::GTY_ROUND_BSPLINE_CURVE] = CurveNiIntersectors <BSplineCurveT,8>();
       prim.vtbl[Geometry::GTY_FLAT_BSPLINE_CURVE ] = RibbonNiIntersectors<BSplineCurveT,8>();
       prim.vtbl[Geometry::GTY_ORIENTED_BSPLINE_CURVE] = OrientedCurveNiIntersectors<BSplineCurveT,8>();
+      prim.vtblK[Geometry::GTY_ROUND_BSPLINE_CURVE] = CurveNiPacketIntersectors <BSplineCurveT,8>();
+      prim.vtblK[Geometry::GTY_FLAT_BSPLINE_CURVE ] = RibbonNiPacketIntersectors<BSplineCurveT,8>();
     }
     void AddVirtualCurveBSplineCurveInterector8v(VirtualCurveIntersector &prim) {
       prim.vtbl[Geometry::GTY_ROUND_BSPLINE_CURVE] = CurveNvIntersectors <BSplineCurveT,8>();
       prim.vtbl[Geometry::GTY_FLAT_BSPLINE_CURVE ] = RibbonNvIntersectors<BSplineCurveT,8>();
       prim.vtbl[Geometry::GTY_ORIENTED_BSPLINE_CURVE] = OrientedCurveNiIntersectors<BSplineCurveT,8>();
+      prim.vtblK[Geometry::GTY_ROUND_BSPLINE_CURVE] = CurveNvPacketIntersectors <BSplineCurveT,8>();
+      prim.vtblK[Geometry::GTY_FLAT_BSPLINE_CURVE ] = RibbonNvPacketIntersectors<BSplineCurveT,8>();
     }
 
     void AddVirtualCurveBSplineCurveInterector8iMB(VirtualCurveIntersector &prim) {
@@ -23,5 +23,11 @@ namespace embree
       prim.vtbl[Geometry::GTY_DISC_POINT] = DiscNiMBIntersectors<4>();
       prim.vtbl[Geometry::GTY_ORIENTED_DISC_POINT] = OrientedDiscNiMBIntersectors<4>();
     }
+
+    void AddVirtualPointInterector4v(VirtualCurveIntersector &prim) {
+      prim.vtbl[Geometry::GTY_SPHERE_POINT] = SphereNvIntersectors<4>();
+      prim.vtbl[Geometry::GTY_DISC_POINT] = DiscNvIntersectors<4>();
+      prim.vtbl[Geometry::GTY_ORIENTED_DISC_POINT] = OrientedDiscNvIntersectors<4>();
+    }
   }
 }
@@ -12,11 +12,13 @@ namespace embree
     void AddVirtualCurvePointInterector4i(VirtualCurveIntersector &prim);
     void AddVirtualCurvePointInterector4v(VirtualCurveIntersector &prim);
     void AddVirtualCurvePointInterector4iMB(VirtualCurveIntersector &prim);
+    void AddVirtualPointInterector4v(VirtualCurveIntersector &prim);
 
 #if defined (__AVX__)
     void AddVirtualCurvePointInterector8i(VirtualCurveIntersector &prim);
     void AddVirtualCurvePointInterector8v(VirtualCurveIntersector &prim);
     void AddVirtualCurvePointInterector8iMB(VirtualCurveIntersector &prim);
+    void AddVirtualPointInterector8v(VirtualCurveIntersector &prim);
 #endif
   }
 }
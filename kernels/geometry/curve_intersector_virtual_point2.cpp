@@ -24,6 +24,12 @@ namespace embree
       prim.vtbl[Geometry::GTY_DISC_POINT] = DiscNiMBIntersectors<8>();
       prim.vtbl[Geometry::GTY_ORIENTED_DISC_POINT] = OrientedDiscNiMBIntersectors<8>();
     }
+
+    void AddVirtualPointInterector8v(VirtualCurveIntersector &prim) {
+      prim.vtbl[Geometry::GTY_SPHERE_POINT] = SphereNvIntersectors<8>();
+      prim.vtbl[Geometry::GTY_DISC_POINT] = DiscNvIntersectors<8>();
+      prim.vtbl[Geometry::GTY_ORIENTED_DISC_POINT] = OrientedDiscNvIntersectors<8>();
+    }
 #endif
   }
 }
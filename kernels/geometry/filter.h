@@ -17,6 +17,7 @@ namespace embree
       if (geometry->intersectionFilterN)
       {
         assert(context->scene->hasGeometryFilterFunction());
+        TRAV_STAT(context,filterCount,1);
         geometry->intersectionFilterN(args);
 
         if (args->valid[0] == 0)
@@ -25,6 +26,7 @@ namespace embree
             
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
+        TRAV_STAT(context,filterCount,1);
         context->user->filter(args);
 
         if (args->valid[0] == 0)
@@ -55,6 +57,7 @@ namespace embree
       const Geometry* const geometry = args->geometry;
       if (geometry->intersectionFilterN) {
         assert(context->scene->hasGeometryFilterFunction());
+        TRAV_STAT(context,filterCount,1);
         geometry->intersectionFilterN(filter_args);
       }
       
@@ -63,6 +66,7 @@ namespace embree
 
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
+        TRAV_STAT(context,filterCount,1);
         context->user->filter(filter_args);
       }
 #endif
@@ -73,6 +77,7 @@ namespace embree
       if (geometry->occlusionFilterN)
       {
         assert(context->scene->hasGeometryFilterFunction());
+        TRAV_STAT(context,filterCount,1);
         geometry->occlusionFilterN(args);
 
         if (args->valid[0] == 0)
@@ -81,6 +86,7 @@ namespace embree
       
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
+        TRAV_STAT(context,filterCount,1);
         context->user->filter(args);
 
         if (args->valid[0] == 0)
@@ -109,6 +115,7 @@ namespace embree
       const Geometry* const geometry = args->geometry;
       if (geometry->occlusionFilterN) {
         assert(context->scene->hasGeometryFilterFunction());
+        TRAV_STAT(context,filterCount,1);
         geometry->occlusionFilterN(filter_args);
       }
       
@@ -117,6 +124,7 @@ namespace embree
       
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
+        TRAV_STAT(context,filterCount,1);
         context->user->filter(filter_args);
       }
 #endif
@@ -129,6 +137,7 @@ namespace embree
       if (geometry->intersectionFilterN)
       {
         assert(context->scene->hasGeometryFilterFunction());
+        TRAV_STAT(context,filterCount,1);
         geometry->intersectionFilterN(args);
       }
 
@@ -137,6 +146,7 @@ namespace embree
 
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
+        TRAV_STAT(context,filterCount,1);
         context->user->filter(args);
       }
 
@@ -168,6 +178,7 @@ namespace embree
       if (geometry->occlusionFilterN)
       {
         assert(context->scene->hasGeometryFilterFunction());
+        TRAV_STAT(context,filterCount,1);
         geometry->occlusionFilterN(args);
       }
 
@@ -177,6 +188,7 @@ namespace embree
 
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
+        TRAV_STAT(context,filterCount,1);
         context->user->filter(args);
       }
 
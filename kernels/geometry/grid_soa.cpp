@@ -9,7 +9,8 @@ namespace embree
   {  
     GridSOA::GridSOA(const SubdivPatch1Base* patches, unsigned time_steps,
                      const unsigned x0, const unsigned x1, const unsigned y0, const unsigned y1, const unsigned swidth, const unsigned sheight,
-                     const SubdivMesh* const geom, const size_t gridOffset, const size_t gridBytes, BBox3fa* bounds_o)
+                     const SubdivMesh* const geom, const size_t gridOffset, const size_t gridBytes, BBox3fa* bounds_o,
+                     const PatchGrid* pgrid)
       : troot(BVH4::emptyNode),
         time_steps(time_steps), width(x1-x0+1), height(y1-y0+1), dim_offset(width*height),
         _geomID(patches->geomID()), _primID(patches->primID()), 
@@ -27,9 +28,26 @@ namespace embree
       /* first create the grids for each time step */
       for (size_t t=0; t<time_steps; t++)
       {
+        /* copy pre-tessellated vertex grid */
+        if (pgrid)
+        {
+          assert(time_steps == 1);
+          for (unsigned i=0; i<temp_size; i++)
+          {
+            const unsigned j = min(i,dim_offset-1);
+            const size_t k = size_t(y0+j/width)*pgrid->width + x0+j%width;
+            local_grid_x[i] = pgrid->x[k];
+            local_grid_y[i] = pgrid->y[k];
+            local_grid_z[i] = pgrid->z[k];
+            local_grid_u[i] = pgrid->u[k];
+            local_grid_v[i] = pgrid->v[k];
+          }
+        }
+
         /* compute vertex grid (+displacement) */
-        evalGrid(patches[t],x0,x1,y0,y1,swidth,sheight,
-                 local_grid_x,local_grid_y,local_grid_z,local_grid_u,local_grid_v,geom);
+        else
+          evalGrid(patches[t],x0,x1,y0,y1,swidth,sheight,
+                   local_grid_x,local_grid_y,local_grid_z,local_grid_u,local_grid_v,geom);
         
         /* encode UVs */
         for (unsigned i=0; i<dim_offset; i+=VSIZEX) {
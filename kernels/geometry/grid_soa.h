@@ -18,16 +18,28 @@ namespace embree
     {
     public:
 
+      /*! vertex grid of an entire sub-patch that got tessellated upfront */
+      struct PatchGrid
+      {
+        const float* x;
+        const float* y;
+        const float* z;
+        const float* u;
+        const float* v;
+        unsigned width;   //!< number of vertices of each row
+      };
+
       /*! GridSOA constructor */
       GridSOA(const SubdivPatch1Base* patches, const unsigned time_steps,
               const unsigned x0, const unsigned x1, const unsigned y0, const unsigned y1, const unsigned swidth, const unsigned sheight,
-              const SubdivMesh* const geom, const size_t totalBvhBytes, const size_t gridBytes, BBox3fa* bounds_o = nullptr);
+              const SubdivMesh* const geom, const size_t totalBvhBytes, const size_t gridBytes, BBox3fa* bounds_o = nullptr,
+              const PatchGrid* pgrid = nullptr);
 
       /*! Subgrid creation */
       template<typename Allocator>
         static GridSOA* create(const SubdivPatch1Base* patches, const unsigned time_steps,
                                unsigned x0, unsigned x1, unsigned y0, unsigned y1, 
-                               const Scene* scene, Allocator& alloc, BBox3fa* bounds_o = nullptr)
+                               const Scene* scene, Allocator& alloc, BBox3fa* bounds_o = nullptr, const PatchGrid* pgrid = nullptr)
       {
         const unsigned width = x1-x0+1;  
         const unsigned height = y1-y0+1; 
@@ -46,7 +58,7 @@ namespace embree
 #endif
         void* data = alloc(offsetof(GridSOA,data)+bvhBytes+time_steps*gridBytes+rootBytes);
         assert(data);
-        return new (data) GridSOA(patches,time_steps,x0,x1,y0,y1,patches->grid_u_res,patches->grid_v_res,scene->get<SubdivMesh>(patches->geomID()),bvhBytes,gridBytes,bounds_o);
+        return new (data) GridSOA(patches,time_steps,x0,x1,y0,y1,patches->grid_u_res,patches->grid_v_res,scene->get<SubdivMesh>(patches->geomID()),bvhBytes,gridBytes,bounds_o,pgrid);
       }
 
       /*! Grid creation */
@@ -10,6 +10,20 @@ namespace embree
   namespace isa
   {
 
+    /* Returns the low-order part of the ray origin. It is only known in world
+       space, thus it is ignored for nested instances. */
+    RTC_FORCEINLINE Vec3fa getOrgLow(const RTCIntersectContext* context)
+    {
+#if RTC_MAX_INSTANCE_LEVEL_COUNT > 1
+      if (context->instStackSize > 1)
+        return Vec3fa(zero);
+#endif
+      const float* org_lo = context->orgLow;
+      if (likely(org_lo == nullptr))
+        return Vec3fa(zero);
+      return Vec3fa(org_lo[0],org_lo[1],org_lo[2]);
+    }
+
     /* Push an instance to the stack. */
     RTC_FORCEINLINE bool pushInstance(RTCPointQueryContext* context,
                       unsigned int instanceId,
@@ -57,12 +71,13 @@ namespace embree
       RTCIntersectContext* user_context = context->user;
       if (likely(instance_id_stack::push(user_context, prim.instID_)))
       {
+        TRAV_STAT(context,instanceCount,1);
         const AffineSpace3fa world2local = instance->getWorld2Local();
         const Vec3ff ray_org = ray.org;
         const Vec3ff ray_dir = ray.dir;
-        ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
+        ray.org = Vec3ff(xfmPoint(world2local, instance->rebaseOrigin(ray_org, getOrgLow(user_context))), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
-        IntersectContext newcontext((Scene*)instance->object, user_context);
+        IntersectContext newcontext((Scene*)instance->object, user_context, context->multiHit);
         instance->object->intersectors.intersect((RTCRayHit&)ray, &newcontext);
         ray.org = ray_org;
         ray.dir = ray_dir;
@@ -84,10 +99,11 @@ namespace embree
       bool occluded = false;
       if (likely(instance_id_stack::push(user_context, prim.instID_)))
       {
+        TRAV_STAT(context,instanceCount,1);
         const AffineSpace3fa world2local = instance->getWorld2Local();
         const Vec3ff ray_org = ray.org;
         const Vec3ff ray_dir = ray.dir;
-        ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
+        ray.org = Vec3ff(xfmPoint(world2local, instance->rebaseOrigin(ray_org, getOrgLow(user_context))), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
         IntersectContext newcontext((Scene*)instance->object, user_context);
         instance->object->intersectors.occluded((RTCRay&)ray, &newcontext);
@@ -146,12 +162,13 @@ namespace embree
       RTCIntersectContext* user_context = context->user;
       if (likely(instance_id_stack::push(user_context, prim.instID_)))
       {
+        TRAV_STAT(context,instanceCount,1);
         const AffineSpace3fa world2local = instance->getWorld2Local(ray.time());
         const Vec3ff ray_org = ray.org;
         const Vec3ff ray_dir = ray.dir;
-        ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
+        ray.org = Vec3ff(xfmPoint(world2local, instance->rebaseOrigin(ray_org, getOrgLow(user_context))), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
-        IntersectContext newcontext((Scene*)instance->object, user_context);
+        IntersectContext newcontext((Scene*)instance->object, user_context, context->multiHit);
         instance->object->intersectors.intersect((RTCRayHit&)ray, &newcontext);
         ray.org = ray_org;
         ray.dir = ray_dir;
@@ -173,10 +190,11 @@ namespace embree
       bool occluded = false;
       if (likely(instance_id_stack::push(user_context, prim.instID_)))
       {
+        TRAV_STAT(context,instanceCount,1);
         const AffineSpace3fa world2local = instance->getWorld2Local(ray.time());
         const Vec3ff ray_org = ray.org;
         const Vec3ff ray_dir = ray.dir;
-        ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
+        ray.org = Vec3ff(xfmPoint(world2local, instance->rebaseOrigin(ray_org, getOrgLow(user_context))), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
         IntersectContext newcontext((Scene*)instance->object, user_context);
         instance->object->intersectors.occluded((RTCRay&)ray, &newcontext);
@@ -237,10 +255,11 @@ namespace embree
       RTCIntersectContext* user_context = context->user;
       if (likely(instance_id_stack::push(user_context, prim.instID_)))
       {
+        TRAV_STAT(context,instanceCount,1);
         AffineSpace3vf<K> world2local = instance->getWorld2Local();
         const Vec3vf<K> ray_org = ray.org;
         const Vec3vf<K> ray_dir = ray.dir;
-        ray.org = xfmPoint(world2local, ray_org);
+        ray.org = xfmPoint(world2local, instance->rebaseOrigin(ray_org, getOrgLow(user_context)));
         ray.dir = xfmVector(world2local, ray_dir);
         IntersectContext newcontext((Scene*)instance->object, user_context);
         instance->object->intersectors.intersect(valid, ray, &newcontext);
@@ -266,10 +285,11 @@ namespace embree
       vbool<K> occluded = false;
       if (likely(instance_id_stack::push(user_context, prim.instID_)))
       {
+        TRAV_STAT(context,instanceCount,1);
         AffineSpace3vf<K> world2local = instance->getWorld2Local();
         const Vec3vf<K> ray_org = ray.org;
         const Vec3vf<K> ray_dir = ray.dir;
-        ray.org = xfmPoint(world2local, ray_org);
+        ray.org = xfmPoint(world2local, instance->rebaseOrigin(ray_org, getOrgLow(user_context)));
         ray.dir = xfmVector(world2local, ray_dir);
         IntersectContext newcontext((Scene*)instance->object, user_context);
         instance->object->intersectors.occluded(valid, ray, &newcontext);
@@ -296,10 +316,11 @@ namespace embree
       RTCIntersectContext* user_context = context->user;
       if (likely(instance_id_stack::push(user_context, prim.instID_)))
       {
+        TRAV_STAT(context,instanceCount,1);
         AffineSpace3vf<K> world2local = instance->getWorld2Local<K>(valid, ray.time());
         const Vec3vf<K> ray_org = ray.org;
         const Vec3vf<K> ray_dir = ray.dir;
-        ray.org = xfmPoint(world2local, ray_org);
+        ray.org = xfmPoint(world2local, instance->rebaseOrigin(ray_org, getOrgLow(user_context)));
         ray.dir = xfmVector(world2local, ray_dir);
         IntersectContext newcontext((Scene*)instance->object, user_context);
         instance->object->intersectors.intersect(valid, ray, &newcontext);
@@ -325,10 +346,11 @@ namespace embree
       vbool<K> occluded = false;
       if (likely(instance_id_stack::push(user_context, prim.instID_)))
       {
+        TRAV_STAT(context,instanceCount,1);
         AffineSpace3vf<K> world2local = instance->getWorld2Local<K>(valid, ray.time());
         const Vec3vf<K> ray_org = ray.org;
         const Vec3vf<K> ray_dir = ray.dir;
-        ray.org = xfmPoint(world2local, ray_org);
+        ray.org = xfmPoint(world2local, instance->rebaseOrigin(ray_org, getOrgLow(user_context)));
         ray.dir = xfmVector(world2local, ray_dir);
         IntersectContext newcontext((Scene*)instance->object, user_context);
         instance->object->intersectors.occluded(valid, ray, &newcontext);
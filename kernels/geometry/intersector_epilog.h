@@ -16,6 +16,29 @@ namespace embree
       __forceinline void operator() (vfloat<M>& u, vfloat<M>& v) const {}
     };
 
+    /*! gathers a hit of a multi-hit query, returns true if the ray got shortened */
+    template<bool filter>
+    __forceinline bool multiHitEpilog1(RayHit& ray, IntersectContext* context, const Geometry* geometry,
+                                       float t, const Vec3fa& Ng, const Vec2f& uv, unsigned int geomID, unsigned int primID)
+    {
+#if defined(EMBREE_FILTER_FUNCTION)
+      if (filter) {
+        if (unlikely(context->hasContextFilter() || geometry->hasIntersectionFilter())) {
+          HitK<1> h(context->user,geomID,primID,uv.x,uv.y,Ng);
+          const float old_t = ray.tfar;
+          ray.tfar = t;
+          const bool found = runIntersectionFilter1(geometry,ray,context,h);
+          ray.tfar = old_t;
+          if (!found) return false;
+        }
+      }
+#endif
+      const float tfar = context->recordHit(ray.tfar,t,Ng,uv.x,uv.y,geomID,primID);
+      if (tfar >= ray.tfar) return false;
+      ray.tfar = tfar;
+      return true;
+    }
+
 
     template<bool filter>
     struct Intersect1Epilog1
@@ -42,6 +65,10 @@ namespace embree
 #endif
         hit.finalize();
 
+        /* gather hit for multi-hit queries */
+        if (unlikely(context->multiHit))
+          return multiHitEpilog1<filter>(ray,context,geometry,hit.t,hit.Ng,Vec2f(hit.u,hit.v),geomID,primID);
+
         /* intersection filter test */
 #if defined(EMBREE_FILTER_FUNCTION)
         if (filter) {
@@ -232,6 +259,25 @@ namespace embree
         vbool<Mx> valid = valid_i;
         if (Mx > M) valid &= (1<<M)-1;
         hit.finalize();
+
+        /* gather all hits for multi-hit queries */
+        if (unlikely(context->multiHit))
+        {
+          bool foundhit = false;
+          while (any(valid))
+          {
+            const size_t j = select_min(valid,hit.vt);
+            clear(valid,j);
+            Geometry* geometry = scene->get(geomIDs[j]);
+#if defined(EMBREE_RAY_MASK)
+            if ((geometry->mask & ray.mask) == 0) continue;
+#endif
+            foundhit |= multiHitEpilog1<filter>(ray,context,geometry,hit.t(j),hit.Ng(j),hit.uv(j),geomIDs[j],primIDs[j]);
+            valid &= hit.vt <= ray.tfar;
+          }
+          return foundhit;
+        }
+
         size_t i = select_min(valid,hit.vt);
         unsigned int geomID = geomIDs[i];
 
@@ -469,6 +515,20 @@ namespace embree
         vbool<M> valid = valid_i;
         hit.finalize();
 
+        /* gather all hits for multi-hit queries */
+        if (unlikely(context->multiHit))
+        {
+          bool foundhit = false;
+          while (any(valid))
+          {
+            const size_t j = select_min(valid,hit.vt);
+            clear(valid,j);
+            foundhit |= multiHitEpilog1<filter>(ray,context,geometry,hit.t(j),hit.Ng(j),hit.uv(j),geomID,primID);
+            valid &= hit.vt <= ray.tfar;
+          }
+          return foundhit;
+        }
+
         size_t i = select_min(valid,hit.vt);
 
         /* intersection filter test */
@@ -32,6 +32,17 @@ namespace embree
           return;
 #endif
 
+        /* user geometries report their closest hit through the ray, which gets gathered for multi-hit queries */
+        if (unlikely(context->multiHit))
+        {
+          const float old_t = ray.tfar;
+          const unsigned int totalHitCount = context->multiHit->totalHitCount;
+          accel->intersect(ray,prim.geomID(),prim.primID(),context,reportIntersection1);
+          if (ray.tfar < old_t && context->multiHit->totalHitCount == totalHitCount)
+            ray.tfar = context->recordHit(old_t,ray.tfar,Vec3fa(ray.Ng),ray.u,ray.v,ray.geomID,ray.primID);
+          return;
+        }
+
         accel->intersect(ray,prim.geomID(),prim.primID(),context,reportIntersection1);
       }
       
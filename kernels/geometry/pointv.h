@@ -0,0 +1,190 @@
+// Copyright 2009-2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "primitive.h"
+
+namespace embree
+{
+  /* Point leaf that stores the centers and radii of M spheres or discs
+   * of one geometry in SoA layout, thus the intersectors do not have to
+   * gather the points from the vertex buffer. If all points of the leaf
+   * have the same radius, the radius is stored only once and the per
+   * point radius array is not allocated. Normals of oriented discs are
+   * still fetched from the geometry. */
+  template<int M>
+  struct PointMv
+  {
+    /* Virtual interface to query information about the point type */
+    struct Type : public PrimitiveType
+    {
+      const char* name() const;
+      size_t sizeActive(const char* This) const;
+      size_t sizeTotal(const char* This) const;
+      size_t getBytes(const char* This) const;
+    };
+    static Type type;
+
+   public:
+
+    /* Returns maximum number of stored points */
+    static __forceinline size_t max_size() {
+      return M;
+    }
+
+    /* Returns required number of primitive blocks for N points */
+    static __forceinline size_t blocks(size_t N) {
+      return (N + max_size() - 1) / max_size();
+    }
+
+    /* Returns required number of bytes for N points */
+    static __forceinline size_t bytes(size_t N) {
+      return blocks(N) * sizeof(PointMv);
+    }
+
+    /* Returns the number of bytes used by this leaf */
+    __forceinline size_t bytes() const {
+      return sharedRadius ? sizeof(PointMv) - sizeof(vfloat<M>) : sizeof(PointMv);
+    }
+
+   public:
+    /* Default constructor */
+    __forceinline PointMv() {}
+
+    /* Returns a mask that tells which points are valid */
+    __forceinline vbool<M> valid() const {
+      return vint<M>(step) < vint<M>(numPrimitives);
+    }
+
+    /* Returns if the specified point is valid */
+    __forceinline bool valid(const size_t i) const
+    {
+      assert(i < M);
+      return i < numPrimitives;
+    }
+
+    /* Returns the number of stored points */
+    __forceinline size_t size() const {
+      return numPrimitives;
+    }
+
+    __forceinline unsigned int geomID(unsigned int i = 0) const {
+      return sharedGeomID;
+    }
+
+    __forceinline const vuint<M>& primID() const {
+      return primIDs;
+    }
+    __forceinline unsigned int primID(const size_t i) const {
+      assert(i < M);
+      return primIDs[i];
+    }
+
+    /* Returns the radii of all points */
+    __forceinline vfloat<M> radii() const {
+      return sharedRadius ? vfloat<M>(radius) : r;
+    }
+
+    /* gather the points */
+    __forceinline void gather(Vec4vf<M>& p0) const {
+      p0 = Vec4vf<M>(x,y,z,radii());
+    }
+
+    __forceinline void gather(Vec4vf<M>& p0, Vec3vf<M>& n0, const Points* geom) const
+    {
+      gather(p0);
+      for (size_t i=0; i<M; i++) {
+        const Vec3fa n = geom->normal(primID(i));
+        n0.x[i] = n.x; n0.y[i] = n.y; n0.z[i] = n.z;
+      }
+    }
+
+    /* Calculate the bounds of the points */
+    __forceinline const BBox3fa bounds(const Scene* scene) const
+    {
+      const Points* geom = scene->get<Points>(geomID());
+      BBox3fa bounds = empty;
+      for (size_t i = 0; i < M && valid(i); i++)
+        bounds.extend(geom->bounds(primID(i)));
+      return bounds;
+    }
+
+    /* Fill leaf with the specified points of a geometry, returns the bounds of the points */
+    __forceinline BBox3fa fill(const Points* geom, unsigned int geomID, const unsigned int* ids, size_t num)
+    {
+      assert(num > 0 && num <= M);
+      gtype = (unsigned char) geom->getType();
+      numPrimitives = (unsigned char) num;
+      sharedGeomID = geomID;
+
+      BBox3fa bounds = empty;
+      vfloat<M> rs;
+      for (size_t i=0; i<M; i++)
+      {
+        const unsigned int primID = ids[min(i,num-1)];
+        const Vec3ff v = geom->vertex(primID);
+        x[i] = v.x; y[i] = v.y; z[i] = v.z; rs[i] = v.w;
+        primIDs[i] = primID;
+        if (i < num) bounds.extend(geom->bounds(v));
+      }
+
+      /* the radius array is only written if the leaf was allocated large enough */
+      radius = rs[0];
+      sharedRadius = all(rs == vfloat<M>(radius));
+      if (!sharedRadius) r = rs;
+      return bounds;
+    }
+
+    /* Fill leaf from point list */
+    __forceinline void fill(const PrimRef* prims, size_t& begin, size_t end, Scene* scene)
+    {
+      unsigned int ids[M];
+      size_t num = 0;
+      const unsigned int geomID = prims[begin].geomID();
+      for (; num<M && begin<end; num++, begin++) {
+        assert(prims[begin].geomID() == geomID);
+        ids[num] = prims[begin].primID();
+      }
+      fill(scene->get<Points>(geomID),geomID,ids,num);
+    }
+
+    template<typename BVH, typename Allocator>
+    __forceinline static typename BVH::NodeRef createLeaf(BVH* bvh, const PrimRef* prims, const range<size_t>& set, const Allocator& alloc)
+    {
+      size_t start    = set.begin();
+      size_t items    = PointMv::blocks(set.size());
+      size_t numbytes = PointMv::bytes(set.size());
+      PointMv* accel  = (PointMv*)alloc.malloc1(numbytes, M * sizeof(float));
+      for (size_t i = 0; i < items; i++) {
+        accel[i].fill(prims, start, set.end(), bvh->scene);
+      }
+      return bvh->encodeLeaf((char*)accel, items);
+    };
+
+    /*! output operator */
+    friend __forceinline embree_ostream operator<<(embree_ostream cout, const PointMv& point) {
+      return cout << "Point" << M << "v {" << point.x << ", " << point.y << ", " << point.z << ", " << point.radii() << ", " << point.geomID() << ", " << point.primID() << "}";
+    }
+
+   public:
+    unsigned char gtype;
+    unsigned char numPrimitives;
+    bool sharedRadius;          // all points have the same radius
+    unsigned int sharedGeomID;
+    float radius;               // radius of all points if sharedRadius is set
+
+   private:
+    vfloat<M> x;                // x coordinates of centers
+    vfloat<M> y;                // y coordinates of centers
+    vfloat<M> z;                // z coordinates of centers
+    vuint<M> primIDs;           // primitive IDs
+    vfloat<M> r;                // per point radii, not allocated if sharedRadius is set
+  };
+
+  template<int M>
+  typename PointMv<M>::Type PointMv<M>::type;
+
+  typedef PointMv<4> Point4v;
+  typedef PointMv<8> Point8v;
+}
@@ -3,9 +3,11 @@
 
 #include "primitive.h"
 #include "curveNv.h"
+#include "curveNc.h"
 #include "curveNi.h"
 #include "curveNi_mb.h"
 #include "linei.h"
+#include "pointv.h"
 #include "triangle.h"
 #include "trianglev.h"
 #include "trianglev_mb.h"
@@ -53,6 +55,42 @@ namespace embree
         return Curve4v::bytes(sizeActive(This));
   }
 
+  /********************** Curve4c **************************/
+
+  template<>
+  const char* Curve4c::Type::name () const {
+    return "curve4c";
+  }
+
+  template<>
+  size_t Curve4c::Type::sizeActive(const char* This) const
+  {
+    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+      return ((Line4i*)This)->size();
+    else
+      return ((Curve4c*)This)->N;
+  }
+
+  template<>
+  size_t Curve4c::Type::sizeTotal(const char* This) const
+  {
+    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+      return 4;
+    else
+      return ((Curve4c*)This)->N;
+  }
+
+  template<>
+  size_t Curve4c::Type::getBytes(const char* This) const
+  {
+    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+      return Line4i::bytes(sizeActive(This));
+    else if (!Curve4c::compressed(*This))
+      return Curve4i::bytes(sizeActive(This));
+    else
+      return Curve4c::bytes(sizeActive(This));
+  }
+
   /********************** Curve4i **************************/
 
   template<>
@@ -143,6 +181,28 @@ namespace embree
     return sizeof(Line4i);
   }
 
+  /********************** Point4v **************************/
+
+  template<>
+  const char* Point4v::Type::name () const {
+    return "point4v";
+  }
+
+  template<>
+  size_t Point4v::Type::sizeActive(const char* This) const {
+    return ((Point4v*)This)->size();
+  }
+
+  template<>
+  size_t Point4v::Type::sizeTotal(const char* This) const {
+    return 4;
+  }
+
+  template<>
+  size_t Point4v::Type::getBytes(const char* This) const {
+    return ((Point4v*)This)->bytes();
+  }
+
   /********************** Triangle4 **************************/
 
   template<>
@@ -374,6 +434,6 @@ namespace embree
 
   template<>
   size_t SubGridQBVH4::Type::getBytes(const char* This) const {
-    return sizeof(SubGridQBVH4);
+    return SubGridQBVH4::bytes(((SubGridQBVH4*)This)->compressed());
   }
 }
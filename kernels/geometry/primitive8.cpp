@@ -6,6 +6,7 @@
 #include "curveNi.h"
 #include "curveNi_mb.h"
 #include "linei.h"
+#include "pointv.h"
 #include "triangle.h"
 #include "trianglev.h"
 #include "trianglev_mb.h"
@@ -121,6 +122,28 @@ namespace embree
        return Curve8iMB::bytes(sizeActive(This));
   }
 
+  /********************** Point8v **************************/
+
+  template<>
+  const char* Point8v::Type::name () const {
+    return "point8v";
+  }
+
+  template<>
+  size_t Point8v::Type::sizeActive(const char* This) const {
+    return ((Point8v*)This)->size();
+  }
+
+  template<>
+  size_t Point8v::Type::sizeTotal(const char* This) const {
+    return 8;
+  }
+
+  template<>
+  size_t Point8v::Type::getBytes(const char* This) const {
+    return ((Point8v*)This)->bytes();
+  }
+
   /********************** SubGridQBVH8 **************************/
 
   template<>
@@ -140,6 +163,6 @@ namespace embree
 
   template<>
   size_t SubGridQBVH8::Type::getBytes(const char* This) const {
-    return sizeof(SubGridQBVH8);
+    return SubGridQBVH8::bytes(((SubGridQBVH8*)This)->compressed());
   }
 }
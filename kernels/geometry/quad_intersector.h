@@ -15,8 +15,8 @@ namespace embree
     __forceinline vbool<N> intersect_quad_backface_culling(const vbool<N>& valid0,
                                                            const Vec3fa& ray_org,
                                                            const Vec3fa& ray_dir,
-                                                           const float ray_tnear,
-                                                           const float ray_tfar,
+                                                           const vfloat<N>& ray_tnear,
+                                                           const vfloat<N>& ray_tfar,
                                                            const Vec3vf<N>& quad_v0,
                                                            const Vec3vf<N>& quad_v1,
                                                            const Vec3vf<N>& quad_v2,
@@ -57,7 +57,7 @@ namespace embree
 
       /* perform depth test */
       const vfloat<N> t = rcpDen*dot(v0,Ng);
-      valid &= vfloat<N>(ray_tnear) <= t & t <= vfloat<N>(ray_tfar);
+      valid &= ray_tnear <= t & t <= ray_tfar;
       if (unlikely(none(valid))) return false;
 
       /* avoid division by 0 */
@@ -72,5 +72,22 @@ namespace embree
       v_o = select(WW <= 0.0f,v_o,1.0f-v_o);
       return valid;
     }
+
+    template<int N>
+    __forceinline vbool<N> intersect_quad_backface_culling(const vbool<N>& valid0,
+                                                           const Vec3fa& ray_org,
+                                                           const Vec3fa& ray_dir,
+                                                           const float ray_tnear,
+                                                           const float ray_tfar,
+                                                           const Vec3vf<N>& quad_v0,
+                                                           const Vec3vf<N>& quad_v1,
+                                                           const Vec3vf<N>& quad_v2,
+                                                           const Vec3vf<N>& quad_v3,
+                                                           vfloat<N>& u_o,
+                                                           vfloat<N>& v_o,
+                                                           vfloat<N>& t_o)
+    {
+      return intersect_quad_backface_culling<N>(valid0,ray_org,ray_dir,vfloat<N>(ray_tnear),vfloat<N>(ray_tfar),quad_v0,quad_v1,quad_v2,quad_v3,u_o,v_o,t_o);
+    }
   }
 }
@@ -9,6 +9,78 @@
 
 namespace embree
 {
+    /* Vertices of a 3x3 subgrid quantized to 16 bit. The origin is a
+     * multiple of the power of two quantization step, which is the same
+     * for all subgrids of an acceleration structure. Thus vertices
+     * shared by neighbouring subgrids decode to identical positions. */
+      struct SubGridQuantizedVertices
+      {
+        /* Quantizes the 9 vertices of a subgrid, stored in the order of SubGrid::gather */
+        __forceinline void encode(const Vec3fa vtx[16], const float step)
+        {
+          const Vec3fa v[9] = { vtx[0], vtx[1], vtx[5], vtx[3], vtx[2], vtx[6], vtx[11], vtx[10], vtx[14] };
+          BBox3fa bounds = empty;
+          for (size_t i=0; i<9; i++) bounds.extend(v[i]);
+          const float rcp_step = 1.0f/step;
+          const Vec3fa k = floor(bounds.lower*rcp_step);
+          origin = Vec3f(k.x*step,k.y*step,k.z*step);
+          scale = step;
+          for (size_t i=0; i<9; i++)
+          {
+            const Vec3fa q = floor(v[i]*rcp_step+Vec3fa(0.5f))-k;
+            assert(reduce_min(q) >= 0.0f && reduce_max(q) <= 65535.0f);
+            vertices[i][0] = (unsigned short) q.x;
+            vertices[i][1] = (unsigned short) q.y;
+            vertices[i][2] = (unsigned short) q.z;
+          }
+        }
+
+        /* Decodes the i'th vertex */
+        __forceinline vfloat4 vertex(size_t i) const
+        {
+          const vfloat4 q(vint4(vertices[i][0],vertices[i][1],vertices[i][2],0));
+          return madd(q,vfloat4(scale),vfloat4(origin.x,origin.y,origin.z,0.0f));
+        }
+
+        /* Calculates the bounds of the decoded vertices */
+        __forceinline BBox3fa bounds() const
+        {
+          BBox3fa b = empty;
+          for (size_t i=0; i<9; i++) b.extend(Vec3fa(vertex(i)));
+          return b;
+        }
+
+        /* Gather the quads */
+        __forceinline void gather(Vec3vf4& p0, Vec3vf4& p1, Vec3vf4& p2, Vec3vf4& p3) const
+        {
+          const vfloat4 vtx00 = vertex(0), vtx01 = vertex(1), vtx02 = vertex(2);
+          const vfloat4 vtx10 = vertex(3), vtx11 = vertex(4), vtx12 = vertex(5);
+          const vfloat4 vtx20 = vertex(6), vtx21 = vertex(7), vtx22 = vertex(8);
+          transpose(vtx00,vtx01,vtx11,vtx10,p0.x,p0.y,p0.z);
+          transpose(vtx01,vtx02,vtx12,vtx11,p1.x,p1.y,p1.z);
+          transpose(vtx11,vtx12,vtx22,vtx21,p2.x,p2.y,p2.z);
+          transpose(vtx10,vtx11,vtx21,vtx20,p3.x,p3.y,p3.z);
+        }
+
+        /* Gather the quads */
+        __forceinline void gather(Vec3fa vtx[16]) const
+        {
+          const Vec3fa vtx00 = Vec3fa(vertex(0)), vtx01 = Vec3fa(vertex(1)), vtx02 = Vec3fa(vertex(2));
+          const Vec3fa vtx10 = Vec3fa(vertex(3)), vtx11 = Vec3fa(vertex(4)), vtx12 = Vec3fa(vertex(5));
+          const Vec3fa vtx20 = Vec3fa(vertex(6)), vtx21 = Vec3fa(vertex(7)), vtx22 = Vec3fa(vertex(8));
+          vtx[ 0] = vtx00; vtx[ 1] = vtx01; vtx[ 2] = vtx11; vtx[ 3] = vtx10;
+          vtx[ 4] = vtx01; vtx[ 5] = vtx02; vtx[ 6] = vtx12; vtx[ 7] = vtx11;
+          vtx[ 8] = vtx10; vtx[ 9] = vtx11; vtx[10] = vtx21; vtx[11] = vtx20;
+          vtx[12] = vtx11; vtx[13] = vtx12; vtx[14] = vtx22; vtx[15] = vtx21;
+        }
+
+      public:
+        Vec3f origin;                      // origin of the subgrid, a multiple of scale
+        float scale;                       // quantization step
+        unsigned short vertices[9][3];     // vertices in units of scale relative to origin
+        unsigned short align;
+      };
+
     /* Stores M quads from an indexed face set */
       struct SubGrid
       {
@@ -158,6 +230,18 @@ namespace embree
           gather(p0,p1,p2,p3,mesh,g);
         }
 
+        /* Gather the quads, either from the quantized vertices stored in the leaf or from the grid mesh */
+        __forceinline void gather(Vec3vf4& p0,
+                                  Vec3vf4& p1,
+                                  Vec3vf4& p2,
+                                  Vec3vf4& p3,
+                                  const Scene *const scene,
+                                  const SubGridQuantizedVertices* qv) const
+        {
+          if (qv) qv->gather(p0,p1,p2,p3);
+          else    gather(p0,p1,p2,p3,scene);
+        }
+
         /* Gather the quads in the motion blur case */
         __forceinline void gatherMB(Vec3vf4& p0,
                                     Vec3vf4& p1,
@@ -212,6 +296,13 @@ namespace embree
           vtx[12] = vtx11; vtx[13] = vtx12; vtx[14] = vtx22; vtx[15] = vtx21;
         }
 
+        /* Gather the quads, either from the quantized vertices stored in the leaf or from the grid mesh */
+        __forceinline void gather(Vec3fa vtx[16], const Scene *const scene, const SubGridQuantizedVertices* qv) const
+        {
+          if (qv) qv->gather(vtx);
+          else    gather(vtx,scene);
+        }
+
         /* Gather the quads */
         __forceinline void gatherMB(vfloat4 vtx[16], const Scene *const scene, const size_t itime, const float ftime) const
         {
@@ -361,9 +452,31 @@ namespace embree
           qnode.init_dim(node);
         }
 
+        /* Returns required number of bytes for a leaf block, including the quantized vertices if requested */
+        static __forceinline size_t bytes(bool compressed) {
+          return sizeof(SubGridQBVHN) + (compressed ? N*sizeof(SubGridQuantizedVertices) : 0);
+        }
+
+        /* subgrids start at even x coordinates, thus bit 0 of the first
+         * x coordinate marks leaves that store quantized vertices */
+        __forceinline bool compressed() const { return subgridIDs[0].x & 1; }
+        __forceinline void setCompressed() { subgridIDs[0].x |= 1; }
+
+        /* The quantized vertices of all blocks of a leaf are stored behind the blocks */
+        static __forceinline const SubGridQuantizedVertices* quantizedVertices(const SubGridQBVHN* prim, size_t num, size_t i, size_t ID)
+        {
+          assert(i < num && ID < N);
+          if (likely(!prim[i].compressed())) return nullptr;
+          return (const SubGridQuantizedVertices*)(prim+num) + i*N + ID;
+        }
+
+        static __forceinline SubGridQuantizedVertices* quantizedVertices(SubGridQBVHN* prim, size_t num, size_t i, size_t ID) {
+          return (SubGridQuantizedVertices*)(prim+num) + i*N + ID;
+        }
+
         __forceinline unsigned int geomID() const { return _geomID; }
         __forceinline unsigned int primID(const size_t i) const { assert(i < N); return subgridIDs[i].primID; }
-        __forceinline unsigned int x(const size_t i) const { assert(i < N); return subgridIDs[i].x; }
+        __forceinline unsigned int x(const size_t i) const { assert(i < N); return subgridIDs[i].x & ~1u; }
         __forceinline unsigned int y(const size_t i) const { assert(i < N); return subgridIDs[i].y; }
 
         __forceinline SubGrid subgrid(const size_t i) const {
@@ -23,23 +23,23 @@ namespace embree
       typedef SubGridQBVHN<N> Primitive;
       typedef SubGridQuadMIntersector1MoellerTrumbore<4,filter> Precalculations;
 
-      static __forceinline void intersect(const Precalculations& pre, RayHit& ray, IntersectContext* context, const SubGrid& subgrid)
+      static __forceinline void intersect(const Precalculations& pre, RayHit& ray, IntersectContext* context, const SubGrid& subgrid, const SubGridQuantizedVertices* qv)
       {
         STAT3(normal.trav_prims,1,1,1);
         const GridMesh* mesh    = context->scene->get<GridMesh>(subgrid.geomID());
         const GridMesh::Grid &g = mesh->grid(subgrid.primID());
 
-        Vec3vf4 v0,v1,v2,v3; subgrid.gather(v0,v1,v2,v3,context->scene);
+        Vec3vf4 v0,v1,v2,v3; subgrid.gather(v0,v1,v2,v3,context->scene,qv);
         pre.intersect(ray,context,v0,v1,v2,v3,g,subgrid);
       }
 
-      static __forceinline bool occluded(const Precalculations& pre, Ray& ray, IntersectContext* context, const SubGrid& subgrid)
+      static __forceinline bool occluded(const Precalculations& pre, Ray& ray, IntersectContext* context, const SubGrid& subgrid, const SubGridQuantizedVertices* qv)
       {
         STAT3(shadow.trav_prims,1,1,1);
         const GridMesh* mesh    = context->scene->get<GridMesh>(subgrid.geomID());
         const GridMesh::Grid &g = mesh->grid(subgrid.primID());
 
-        Vec3vf4 v0,v1,v2,v3; subgrid.gather(v0,v1,v2,v3,context->scene);
+        Vec3vf4 v0,v1,v2,v3; subgrid.gather(v0,v1,v2,v3,context->scene,qv);
         return pre.occluded(ray,context,v0,v1,v2,v3,g,subgrid);
       }
       
@@ -71,7 +71,7 @@ namespace embree
             assert(((size_t)1 << ID) & movemask(prim[i].qnode.validMask()));
 
             if (unlikely(dist[ID] > ray.tfar)) continue;
-            intersect(pre,ray,context,prim[i].subgrid(ID));
+            intersect(pre,ray,context,prim[i].subgrid(ID),Primitive::quantizedVertices(prim,num,i,ID));
           }
         }
       }
@@ -90,7 +90,7 @@ namespace embree
             const size_t ID = bscf(mask); 
             assert(((size_t)1 << ID) & movemask(prim[i].qnode.validMask()));
 
-            if (occluded(pre,ray,context,prim[i].subgrid(ID)))
+            if (occluded(pre,ray,context,prim[i].subgrid(ID),Primitive::quantizedVertices(prim,num,i,ID)))
               return true;
           }
         }
@@ -126,23 +126,23 @@ namespace embree
       typedef SubGridQBVHN<N> Primitive;
       typedef SubGridQuadMIntersector1Pluecker<4,filter> Precalculations;
 
-      static __forceinline void intersect(const Precalculations& pre, RayHit& ray, IntersectContext* context, const SubGrid& subgrid)
+      static __forceinline void intersect(const Precalculations& pre, RayHit& ray, IntersectContext* context, const SubGrid& subgrid, const SubGridQuantizedVertices* qv)
       {
         STAT3(normal.trav_prims,1,1,1);
         const GridMesh* mesh    = context->scene->get<GridMesh>(subgrid.geomID());
         const GridMesh::Grid &g = mesh->grid(subgrid.primID());
 
-        Vec3vf4 v0,v1,v2,v3; subgrid.gather(v0,v1,v2,v3,context->scene);
+        Vec3vf4 v0,v1,v2,v3; subgrid.gather(v0,v1,v2,v3,context->scene,qv);
         pre.intersect(ray,context,v0,v1,v2,v3,g,subgrid);
       }
 
-      static __forceinline bool occluded(const Precalculations& pre, Ray& ray, IntersectContext* context, const SubGrid& subgrid)
+      static __forceinline bool occluded(const Precalculations& pre, Ray& ray, IntersectContext* context, const SubGrid& subgrid, const SubGridQuantizedVertices* qv)
       {
         STAT3(shadow.trav_prims,1,1,1);
         const GridMesh* mesh    = context->scene->get<GridMesh>(subgrid.geomID());
         const GridMesh::Grid &g = mesh->grid(subgrid.primID());
 
-        Vec3vf4 v0,v1,v2,v3; subgrid.gather(v0,v1,v2,v3,context->scene);
+        Vec3vf4 v0,v1,v2,v3; subgrid.gather(v0,v1,v2,v3,context->scene,qv);
         return pre.occluded(ray,context,v0,v1,v2,v3,g,subgrid);
       }
       
@@ -173,7 +173,7 @@ namespace embree
             assert(((size_t)1 << ID) & movemask(prim[i].qnode.validMask()));
 
             if (unlikely(dist[ID] > ray.tfar)) continue;
-            intersect(pre,ray,context,prim[i].subgrid(ID));
+            intersect(pre,ray,context,prim[i].subgrid(ID),Primitive::quantizedVertices(prim,num,i,ID));
           }
         }
       }
@@ -192,7 +192,7 @@ namespace embree
             const size_t ID = bscf(mask); 
             assert(((size_t)1 << ID) & movemask(prim[i].qnode.validMask()));
 
-            if (occluded(pre,ray,context,prim[i].subgrid(ID)))
+            if (occluded(pre,ray,context,prim[i].subgrid(ID),Primitive::quantizedVertices(prim,num,i,ID)))
               return true;
           }
         }
@@ -231,13 +231,13 @@ namespace embree
       typedef SubGridQBVHN<N> Primitive;
       typedef SubGridQuadMIntersectorKMoellerTrumbore<4,K,filter> Precalculations;
 
-      static __forceinline void intersect(const vbool<K>& valid_i, Precalculations& pre, RayHitK<K>& ray, IntersectContext* context, const SubGrid& subgrid)
+      static __forceinline void intersect(const vbool<K>& valid_i, Precalculations& pre, RayHitK<K>& ray, IntersectContext* context, const SubGrid& subgrid, const SubGridQuantizedVertices* qv)
       {
         Vec3fa vtx[16];
         const GridMesh* mesh    = context->scene->get<GridMesh>(subgrid.geomID());
         const GridMesh::Grid &g = mesh->grid(subgrid.primID());
 
-        subgrid.gather(vtx,context->scene);
+        subgrid.gather(vtx,context->scene,qv);
         for (unsigned int i=0; i<4; i++)
         {
           const Vec3vf<K> p0 = vtx[i*4+0];
@@ -249,14 +249,14 @@ namespace embree
         }
       }
 
-      static __forceinline vbool<K> occluded(const vbool<K>& valid_i, Precalculations& pre, RayK<K>& ray, IntersectContext* context, const SubGrid& subgrid)
+      static __forceinline vbool<K> occluded(const vbool<K>& valid_i, Precalculations& pre, RayK<K>& ray, IntersectContext* context, const SubGrid& subgrid, const SubGridQuantizedVertices* qv)
       {
         vbool<K> valid0 = valid_i;
         Vec3fa vtx[16];
         const GridMesh* mesh    = context->scene->get<GridMesh>(subgrid.geomID());
         const GridMesh::Grid &g = mesh->grid(subgrid.primID());
 
-        subgrid.gather(vtx,context->scene);
+        subgrid.gather(vtx,context->scene,qv);
         for (unsigned int i=0; i<4; i++)
         {
           const Vec3vf<K> p0 = vtx[i*4+0];
@@ -270,22 +270,22 @@ namespace embree
         return !valid0;
       }
       
-      static __forceinline void intersect(Precalculations& pre, RayHitK<K>& ray, size_t k, IntersectContext* context, const SubGrid& subgrid)
+      static __forceinline void intersect(Precalculations& pre, RayHitK<K>& ray, size_t k, IntersectContext* context, const SubGrid& subgrid, const SubGridQuantizedVertices* qv)
       {
         STAT3(normal.trav_prims,1,1,1);
         const GridMesh* mesh    = context->scene->get<GridMesh>(subgrid.geomID());
         const GridMesh::Grid &g = mesh->grid(subgrid.primID());
 
-        Vec3vf4 v0,v1,v2,v3; subgrid.gather(v0,v1,v2,v3,context->scene);
+        Vec3vf4 v0,v1,v2,v3; subgrid.gather(v0,v1,v2,v3,context->scene,qv);
         pre.intersect1(ray,k,context,v0,v1,v2,v3,g,subgrid);
       }
 
-      static __forceinline bool occluded(Precalculations& pre, RayK<K>& ray, size_t k, IntersectContext* context, const SubGrid& subgrid)
+      static __forceinline bool occluded(Precalculations& pre, RayK<K>& ray, size_t k, IntersectContext* context, const SubGrid& subgrid, const SubGridQuantizedVertices* qv)
       {
         STAT3(shadow.trav_prims,1,1,1);
         const GridMesh* mesh    = context->scene->get<GridMesh>(subgrid.geomID());
         const GridMesh::Grid &g = mesh->grid(subgrid.primID());
-        Vec3vf4 v0,v1,v2,v3; subgrid.gather(v0,v1,v2,v3,context->scene);
+        Vec3vf4 v0,v1,v2,v3; subgrid.gather(v0,v1,v2,v3,context->scene,qv);
         return pre.occluded1(ray,k,context,v0,v1,v2,v3,g,subgrid);
       }
 
@@ -301,7 +301,7 @@ namespace embree
             {
               const size_t i = bscf(m_valid);
               if (none(valid & isecK.intersectK(&prim[j].qnode,i,tray,dist))) continue;
-              intersect(valid,pre,ray,context,prim[j].subgrid(i));
+              intersect(valid,pre,ray,context,prim[j].subgrid(i),Primitive::quantizedVertices(prim,num,j,i));
             }
           }
         }
@@ -319,7 +319,7 @@ namespace embree
             {
               const size_t i = bscf(m_valid);
               if (none(valid0 & isecK.intersectK(&prim[j].qnode,i,tray,dist))) continue;
-              valid0 &= !occluded(valid0,pre,ray,context,prim[j].subgrid(i));
+              valid0 &= !occluded(valid0,pre,ray,context,prim[j].subgrid(i),Primitive::quantizedVertices(prim,num,j,i));
               if (none(valid0)) break;
             }
           }
@@ -341,7 +341,7 @@ namespace embree
               assert(((size_t)1 << ID) & movemask(prim[i].qnode.validMask()));
 
               if (unlikely(dist[ID] > ray.tfar[k])) continue;
-              intersect(pre,ray,k,context,prim[i].subgrid(ID));
+              intersect(pre,ray,k,context,prim[i].subgrid(ID),Primitive::quantizedVertices(prim,num,i,ID));
             }
           }
         }
@@ -360,7 +360,7 @@ namespace embree
               const size_t ID = bscf(mask); 
               assert(((size_t)1 << ID) & movemask(prim[i].qnode.validMask()));
 
-              if (occluded(pre,ray,k,context,prim[i].subgrid(ID)))
+              if (occluded(pre,ray,k,context,prim[i].subgrid(ID),Primitive::quantizedVertices(prim,num,i,ID)))
                 return true;
             }
           }
@@ -375,13 +375,13 @@ namespace embree
       typedef SubGridQBVHN<N> Primitive;
       typedef SubGridQuadMIntersectorKPluecker<4,K,filter> Precalculations;
 
-      static __forceinline void intersect(const vbool<K>& valid_i, Precalculations& pre, RayHitK<K>& ray, IntersectContext* context, const SubGrid& subgrid)
+      static __forceinline void intersect(const vbool<K>& valid_i, Precalculations& pre, RayHitK<K>& ray, IntersectContext* context, const SubGrid& subgrid, const SubGridQuantizedVertices* qv)
       {
         Vec3fa vtx[16];
         const GridMesh* mesh    = context->scene->get<GridMesh>(subgrid.geomID());
         const GridMesh::Grid &g = mesh->grid(subgrid.primID());
 
-        subgrid.gather(vtx,context->scene);
+        subgrid.gather(vtx,context->scene,qv);
         for (unsigned int i=0; i<4; i++)
         {
           const Vec3vf<K> p0 = vtx[i*4+0];
@@ -393,14 +393,14 @@ namespace embree
         }
       }
 
-      static __forceinline vbool<K> occluded(const vbool<K>& valid_i, Precalculations& pre, RayK<K>& ray, IntersectContext* context, const SubGrid& subgrid)
+      static __forceinline vbool<K> occluded(const vbool<K>& valid_i, Precalculations& pre, RayK<K>& ray, IntersectContext* context, const SubGrid& subgrid, const SubGridQuantizedVertices* qv)
       {
         vbool<K> valid0 = valid_i;
         Vec3fa vtx[16];
         const GridMesh* mesh    = context->scene->get<GridMesh>(subgrid.geomID());
         const GridMesh::Grid &g = mesh->grid(subgrid.primID());
 
-        subgrid.gather(vtx,context->scene);
+        subgrid.gather(vtx,context->scene,qv);
         for (unsigned int i=0; i<4; i++)
         {
           const Vec3vf<K> p0 = vtx[i*4+0];
@@ -414,22 +414,22 @@ namespace embree
         return !valid0;
       }
       
-      static __forceinline void intersect(Precalculations& pre, RayHitK<K>& ray, size_t k, IntersectContext* context, const SubGrid& subgrid)
+      static __forceinline void intersect(Precalculations& pre, RayHitK<K>& ray, size_t k, IntersectContext* context, const SubGrid& subgrid, const SubGridQuantizedVertices* qv)
       {
         STAT3(normal.trav_prims,1,1,1);
         const GridMesh* mesh    = context->scene->get<GridMesh>(subgrid.geomID());
         const GridMesh::Grid &g = mesh->grid(subgrid.primID());
 
-        Vec3vf4 v0,v1,v2,v3; subgrid.gather(v0,v1,v2,v3,context->scene);
+        Vec3vf4 v0,v1,v2,v3; subgrid.gather(v0,v1,v2,v3,context->scene,qv);
         pre.intersect1(ray,k,context,v0,v1,v2,v3,g,subgrid);
       }
 
-      static __forceinline bool occluded(Precalculations& pre, RayK<K>& ray, size_t k, IntersectContext* context, const SubGrid& subgrid)
+      static __forceinline bool occluded(Precalculations& pre, RayK<K>& ray, size_t k, IntersectContext* context, const SubGrid& subgrid, const SubGridQuantizedVertices* qv)
       {
         STAT3(shadow.trav_prims,1,1,1);
         const GridMesh* mesh    = context->scene->get<GridMesh>(subgrid.geomID());
         const GridMesh::Grid &g = mesh->grid(subgrid.primID());
-        Vec3vf4 v0,v1,v2,v3; subgrid.gather(v0,v1,v2,v3,context->scene);
+        Vec3vf4 v0,v1,v2,v3; subgrid.gather(v0,v1,v2,v3,context->scene,qv);
         return pre.occluded1(ray,k,context,v0,v1,v2,v3,g,subgrid);
       }
       
@@ -445,7 +445,7 @@ namespace embree
             {
               const size_t i = bscf(m_valid);
               if (none(valid & isecK.intersectK(&prim[j].qnode,i,tray,dist))) continue;
-              intersect(valid,pre,ray,context,prim[j].subgrid(i));
+              intersect(valid,pre,ray,context,prim[j].subgrid(i),Primitive::quantizedVertices(prim,num,j,i));
             }
           }
         }
@@ -463,7 +463,7 @@ namespace embree
             {
               const size_t i = bscf(m_valid);
               if (none(valid0 & isecK.intersectK(&prim[j].qnode,i,tray,dist))) continue;
-              valid0 &= !occluded(valid0,pre,ray,context,prim[j].subgrid(i));
+              valid0 &= !occluded(valid0,pre,ray,context,prim[j].subgrid(i),Primitive::quantizedVertices(prim,num,j,i));
               if (none(valid0)) break;
             }
           }
@@ -485,7 +485,7 @@ namespace embree
               assert(((size_t)1 << ID) & movemask(prim[i].qnode.validMask()));
 
               if (unlikely(dist[ID] > ray.tfar[k])) continue;
-              intersect(pre,ray,k,context,prim[i].subgrid(ID));
+              intersect(pre,ray,k,context,prim[i].subgrid(ID),Primitive::quantizedVertices(prim,num,i,ID));
             }
           }
         }
@@ -504,7 +504,7 @@ namespace embree
               const size_t ID = bscf(mask); 
               assert(((size_t)1 << ID) & movemask(prim[i].qnode.validMask()));
 
-              if (occluded(pre,ray,k,context,prim[i].subgrid(ID)))
+              if (occluded(pre,ray,k,context,prim[i].subgrid(ID),Primitive::quantizedVertices(prim,num,i,ID)))
                 return true;
             }
           }
@@ -180,7 +180,7 @@ namespace embree
         const Vec3fa p2 = mesh->vertex(tri.v[2]);
         bounds.extend(merge(BBox3fa(p0),BBox3fa(p1),BBox3fa(p2)));
       }
-      return bounds;
+      return mesh->enlargeQuantized(bounds);
     }
 
   protected:
@@ -209,6 +209,13 @@ namespace embree
     using embree::TriangleMi<M>::geomID;
     using embree::TriangleMi<M>::primID;
     using embree::TriangleMi<M>::valid;
+
+    /* loads a vertex at a 4 byte offset of the vertex buffer, decodes quantized vertices */
+    static __forceinline Vec3fa loadVertex(const TriangleMesh* mesh, const float* vertices, const unsigned int ofs)
+    {
+      if (unlikely(mesh->isQuantized())) return mesh->dequantize((const char*)(vertices + ofs));
+      return Vec3fa::loadu(vertices + ofs);
+    }
         
     /* loads a single vertex */
     template<int vid>
@@ -217,10 +224,14 @@ namespace embree
 #if defined(EMBREE_COMPACT_POLYS)
       const TriangleMesh* mesh = scene->get<TriangleMesh>(geomID(index));
       const TriangleMesh::Triangle& tri = mesh->triangle(primID(index));
-      return (Vec3f) mesh->vertices[0][tri.v[vid]];
+      return (Vec3f) mesh->vertex(tri.v[vid]);
 #else
       const vuint<M>& v = getVertexOffset<vid>();
       const float* vertices = scene->vertices[geomID(index)];
+      if (unlikely(vertices == nullptr)) {
+        const TriangleMesh* mesh = scene->get<TriangleMesh>(geomID(index));
+        return (Vec3f) loadVertex(mesh,(const float*) mesh->vertexPtr(0),v[index]);
+      }
       return (Vec3f&) vertices[v[index]];
 #endif
     }
@@ -231,15 +242,15 @@ namespace embree
 #if defined(EMBREE_COMPACT_POLYS)
       const TriangleMesh* mesh = scene->get<TriangleMesh>(geomID(index));
       const TriangleMesh::Triangle& tri = mesh->triangle(primID(index));
-      const Vec3fa v0 = mesh->vertices[itime+0][tri.v[vid]];
-      const Vec3fa v1 = mesh->vertices[itime+1][tri.v[vid]];
+      const Vec3fa v0 = mesh->vertex(tri.v[vid],itime+0);
+      const Vec3fa v1 = mesh->vertex(tri.v[vid],itime+1);
 #else
       const vuint<M>& v = getVertexOffset<vid>();
       const TriangleMesh* mesh = scene->get<TriangleMesh>(geomID(index));
       const float* vertices0 = (const float*) mesh->vertexPtr(0,itime+0);
       const float* vertices1 = (const float*) mesh->vertexPtr(0,itime+1);
-      const Vec3fa v0 = Vec3fa::loadu(vertices0+v[index]);
-      const Vec3fa v1 = Vec3fa::loadu(vertices1+v[index]);
+      const Vec3fa v0 = loadVertex(mesh,vertices0,v[index]);
+      const Vec3fa v1 = loadVertex(mesh,vertices1,v[index]);
 #endif
       const Vec3<T> p0(v0.x,v0.y,v0.z);
       const Vec3<T> p1(v1.x,v1.y,v1.z);
@@ -256,14 +267,14 @@ namespace embree
       {
 #if defined(EMBREE_COMPACT_POLYS)
         const TriangleMesh::Triangle& tri = mesh->triangle(primID(index));
-        const Vec3fa v0 = mesh->vertices[itime[i]+0][tri.v[vid]];
-        const Vec3fa v1 = mesh->vertices[itime[i]+1][tri.v[vid]];
+        const Vec3fa v0 = mesh->vertex(tri.v[vid],itime[i]+0);
+        const Vec3fa v1 = mesh->vertex(tri.v[vid],itime[i]+1);
 #else
         const vuint<M>& v = getVertexOffset<vid>();
         const float* vertices0 = (const float*) mesh->vertexPtr(0,itime[i]+0);
         const float* vertices1 = (const float*) mesh->vertexPtr(0,itime[i]+1);
-        const Vec3fa v0 = Vec3fa::loadu(vertices0+v[index]);
-        const Vec3fa v1 = Vec3fa::loadu(vertices1+v[index]);
+        const Vec3fa v0 = loadVertex(mesh,vertices0,v[index]);
+        const Vec3fa v1 = loadVertex(mesh,vertices1,v[index]);
 #endif
         p0.x[i] = v0.x; p0.y[i] = v0.y; p0.z[i] = v0.z;
         p1.x[i] = v1.x; p1.y[i] = v1.y; p1.z[i] = v1.z;
@@ -284,9 +295,9 @@ namespace embree
       if (unlikely(primID == -1)) return { zero, zero, zero };
       const TriangleMesh* mesh = scene->get<TriangleMesh>(geomID);
       const TriangleMesh::Triangle& tri = mesh->triangle(primID);
-      const vfloat4 v0 = (vfloat4) mesh->vertices0[tri.v[0]];
-      const vfloat4 v1 = (vfloat4) mesh->vertices0[tri.v[1]];
-      const vfloat4 v2 = (vfloat4) mesh->vertices0[tri.v[2]];
+      const vfloat4 v0 = (vfloat4) mesh->vertex(tri.v[0]);
+      const vfloat4 v1 = (vfloat4) mesh->vertex(tri.v[1]);
+      const vfloat4 v2 = (vfloat4) mesh->vertex(tri.v[2]);
       return { v0, v1, v2 };
     }
 
@@ -295,9 +306,9 @@ namespace embree
       const unsigned int primID = primIDs[i];
       if (unlikely(primID == -1)) return { zero, zero, zero };
       const TriangleMesh::Triangle& tri = mesh->triangle(primID);
-      const vfloat4 v0 = (vfloat4) mesh->vertices[itime][tri.v[0]];
-      const vfloat4 v1 = (vfloat4) mesh->vertices[itime][tri.v[1]];
-      const vfloat4 v2 = (vfloat4) mesh->vertices[itime][tri.v[2]];
+      const vfloat4 v0 = (vfloat4) mesh->vertex(tri.v[0],itime);
+      const vfloat4 v1 = (vfloat4) mesh->vertex(tri.v[1],itime);
+      const vfloat4 v2 = (vfloat4) mesh->vertex(tri.v[2],itime);
       return { v0, v1, v2 };
     }
     
@@ -306,6 +317,8 @@ namespace embree
     __forceinline Triangle loadTriangle(const int i, const Scene* const scene) const 
     {
       const float* vertices = scene->vertices[geomID(i)];
+      if (unlikely(vertices == nullptr))
+        return loadTriangle(i,0,scene->get<TriangleMesh>(geomID(i)));
       const vfloat4 v0 = vfloat4::loadu(vertices + v0_[i]);
       const vfloat4 v1 = vfloat4::loadu(vertices + v1_[i]);
       const vfloat4 v2 = vfloat4::loadu(vertices + v2_[i]);
@@ -315,6 +328,12 @@ namespace embree
     __forceinline Triangle loadTriangle(const int i, const int itime, const TriangleMesh* const mesh) const 
     {
       const float* vertices = (const float*) mesh->vertexPtr(0,itime);
+      if (unlikely(mesh->isQuantized())) {
+        const vfloat4 v0 = (vfloat4) mesh->dequantize((const char*)(vertices + v0_[i]));
+        const vfloat4 v1 = (vfloat4) mesh->dequantize((const char*)(vertices + v1_[i]));
+        const vfloat4 v2 = (vfloat4) mesh->dequantize((const char*)(vertices + v2_[i]));
+        return { v0, v1, v2 };
+      }
       const vfloat4 v0 = vfloat4::loadu(vertices + v0_[i]);
       const vfloat4 v1 = vfloat4::loadu(vertices + v1_[i]);
       const vfloat4 v2 = vfloat4::loadu(vertices + v2_[i]);
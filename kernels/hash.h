@@ -0,0 +1,4 @@
+// Copyright 2009-2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#define RTC_HASH "b217fd347575c0fafdf741fd1735287a7af7ef12"
@@ -0,0 +1,61 @@
+// Copyright 2009-2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "../common/default.h"
+
+namespace embree
+{
+  /*! Precalculated limit surface stencil of the tessellation grid of
+   *  one sub-patch. Each grid position is a weighted sum of the
+   *  control vertices of the patch, thus animated vertex positions
+   *  can get evaluated with a sparse matrix vector product instead of
+   *  subdividing the patch again. */
+  struct GridStencil
+  {
+    __forceinline GridStencil ()
+      : swidth(0), sheight(0), numSamples(0) {}
+
+    /*! allocates the stencil for a grid and the specified control vertices */
+    void init(const unsigned swidth_i, const unsigned sheight_i, const float level_i[4], const std::vector<unsigned>& vertexIDs_i)
+    {
+      swidth = swidth_i;
+      sheight = sheight_i;
+      for (size_t i=0; i<4; i++) level[i] = level_i[i];
+      vertexIDs = vertexIDs_i;
+
+      /* pad each row of weights such that SIMD loads never cross into the next row */
+      numSamples = swidth*sheight+16;
+      u.resize(numSamples,0.0f);
+      v.resize(numSamples,0.0f);
+      weights.resize(vertexIDs.size()*numSamples,0.0f);
+    }
+
+    /*! checks if the stencil got calculated for the specified grid */
+    __forceinline bool matches(const unsigned w, const unsigned h, const float l[4]) const
+    {
+      return swidth == w && sheight == h &&
+        level[0] == l[0] && level[1] == l[1] && level[2] == l[2] && level[3] == l[3];
+    }
+
+    /*! returns the weights of the k'th control vertex for all grid positions */
+    __forceinline       float* weight(size_t k)       { return &weights[k*numSamples]; }
+    __forceinline const float* weight(size_t k) const { return &weights[k*numSamples]; }
+
+    /*! returns the number of bytes used by the stencil */
+    __forceinline size_t bytes() const {
+      return sizeof(GridStencil) + vertexIDs.size()*sizeof(unsigned) + (u.size()+v.size()+weights.size())*sizeof(float);
+    }
+
+  public:
+    unsigned swidth;                  //!< width of the tessellation grid
+    unsigned sheight;                 //!< height of the tessellation grid
+    float level[4];                   //!< edge levels the grid got calculated for
+    size_t numSamples;                //!< padded number of grid positions
+    std::vector<unsigned> vertexIDs;  //!< control vertices of the patch
+    std::vector<float> u;             //!< sub-patch u coordinate of each grid position
+    std::vector<float> v;             //!< sub-patch v coordinate of each grid position
+    std::vector<float> weights;       //!< weight of each control vertex for each grid position
+  };
+}
@@ -61,6 +61,71 @@ namespace embree
       return Vec3<simdf>( zero );
     }
 
+    /* evaluates the grid as weighted sum of the control vertices using a precalculated stencil */
+    static void evalGridStencil(const GridStencil& stencil, const BufferView<Vec3fa>& vertices,
+                                const unsigned x0, const unsigned x1,
+                                const unsigned y0, const unsigned y1,
+                                float *__restrict__ const grid_x,
+                                float *__restrict__ const grid_y,
+                                float *__restrict__ const grid_z,
+                                float *__restrict__ const grid_u,
+                                float *__restrict__ const grid_v)
+    {
+      const unsigned dwidth = x1-x0+1;
+      const unsigned K = unsigned(stencil.vertexIDs.size());
+      dynamic_large_stack_array(Vec3fa,vtx,K,64*sizeof(Vec3fa));
+      for (unsigned k=0; k<K; k++)
+        vtx[k] = vertices[stencil.vertexIDs[k]];
+
+      /* SIMD blocks may write past the end of a row, which gets overwritten by the next row */
+      for (unsigned y=y0; y<=y1; y++)
+      {
+        for (unsigned x=x0; x<=x1; x+=VSIZEX)
+        {
+          const size_t s = y*stencil.swidth+x;
+          const size_t d = (y-y0)*dwidth+(x-x0);
+          vfloatx px(zero), py(zero), pz(zero);
+          for (unsigned k=0; k<K; k++)
+          {
+            const vfloatx w = vfloatx::loadu(stencil.weight(k)+s);
+            px = madd(w,vfloatx(vtx[k].x),px);
+            py = madd(w,vfloatx(vtx[k].y),py);
+            pz = madd(w,vfloatx(vtx[k].z),pz);
+          }
+          vfloatx::storeu(&grid_x[d],px);
+          vfloatx::storeu(&grid_y[d],py);
+          vfloatx::storeu(&grid_z[d],pz);
+          vfloatx::storeu(&grid_u[d],vfloatx::loadu(&stencil.u[s]));
+          vfloatx::storeu(&grid_v[d],vfloatx::loadu(&stencil.v[s]));
+        }
+      }
+    }
+
+    /* calls the displacement shader for all N points of a grid */
+    static __forceinline void displaceGrid(const SubdivPatch1Base& patch, const unsigned N,
+                                           float* grid_x, float* grid_y, float* grid_z,
+                                           const float* grid_u, const float* grid_v,
+                                           const float* grid_Ng_x, const float* grid_Ng_y, const float* grid_Ng_z,
+                                           const SubdivMesh* const geom)
+    {
+      RTCDisplacementFunctionNArguments args;
+      args.geometryUserPtr = geom->userPtr;
+      args.geometry = (RTCGeometry)geom;
+      //args.geomID = patch.geomID();
+      args.primID = patch.primID();
+      args.timeStep = patch.time();
+      args.u = grid_u;
+      args.v = grid_v;
+      args.Ng_x = grid_Ng_x;
+      args.Ng_y = grid_Ng_y;
+      args.Ng_z = grid_Ng_z;
+      args.P_x = grid_x;
+      args.P_y = grid_y;
+      args.P_z = grid_z;
+      args.N = N;
+      geom->displFunc(&args);
+    }
+
     /* eval grid over patch and stich edges when required */      
     void evalGrid(const SubdivPatch1Base& patch,
                   const unsigned x0, const unsigned x1,
@@ -86,7 +151,13 @@ namespace embree
         dynamic_large_stack_array(float,grid_Ng_y,N,32*32*sizeof(float));
         dynamic_large_stack_array(float,grid_Ng_z,N,32*32*sizeof(float));
         
-        if (geom->patch_eval_trees.size())
+        const GridStencil* stencil = displ ? nullptr : geom->getStencil(patch.primID(),patch.subPatch());
+        if (stencil && stencil->matches(swidth,sheight,patch.level))
+        {
+          evalGridStencil(*stencil,geom->getVertexBuffer(patch.time()),x0,x1,y0,y1,
+                          grid_x,grid_y,grid_z,grid_u,grid_v);
+        }
+        else if (geom->patch_eval_trees.size())
         {
           feature_adaptive_eval_grid<PatchEvalGrid> 
             (geom->patch_eval_trees[geom->numTimeSteps*patch.primID()+patch.time()], patch.subPatch(), patch.needsStitching() ? patch.level : nullptr,
@@ -124,22 +195,7 @@ namespace embree
 
         /* call displacement shader */
         if (unlikely(geom->displFunc)) {
-          RTCDisplacementFunctionNArguments args;
-          args.geometryUserPtr = geom->userPtr;
-          args.geometry = (RTCGeometry)geom;
-          //args.geomID = patch.geomID();
-          args.primID = patch.primID();
-          args.timeStep = patch.time();
-          args.u = grid_u;
-          args.v = grid_v;
-          args.Ng_x = grid_Ng_x;
-          args.Ng_y = grid_Ng_y;
-          args.Ng_z = grid_Ng_z;
-          args.P_x = grid_x;
-          args.P_y = grid_y;
-          args.P_z = grid_z;
-          args.N = dwidth*dheight;
-          geom->displFunc(&args);
+          displaceGrid(patch,dwidth*dheight,grid_x,grid_y,grid_z,grid_u,grid_v,grid_Ng_x,grid_Ng_y,grid_Ng_z,geom);
         }
 
         /* set last elements in u,v array to 1.0f */
@@ -175,38 +231,46 @@ namespace embree
           stitchUVGrid(patch.level,swidth,sheight,x0,y0,dwidth,dheight,grid_u,grid_v);
       
         /* iterates over all grid points */
+        const bool displ = geom->displFunc;
+        const unsigned N = displ ? M : 0;
+        dynamic_large_stack_array(float,grid_Ng_x,N,32*32*sizeof(float));
+        dynamic_large_stack_array(float,grid_Ng_y,N,32*32*sizeof(float));
+        dynamic_large_stack_array(float,grid_Ng_z,N,32*32*sizeof(float));
+
         for (unsigned i=0; i<grid_size_simd_blocks; i++)
         {
           const vfloatx u = vfloatx::load(&grid_u[i*VSIZEX]);
           const vfloatx v = vfloatx::load(&grid_v[i*VSIZEX]);
-          Vec3vfx vtx = patchEval(patch,u,v);
-        
-          /* evaluate displacement function */
-          if (unlikely(geom->displFunc != nullptr))
+          const Vec3vfx vtx = patchEval(patch,u,v);
+
+          if (unlikely(displ))
           {
             const Vec3vfx normal = normalize_safe(patchNormal(patch, u, v));
-            RTCDisplacementFunctionNArguments args;
-            args.geometryUserPtr = geom->userPtr;
-            args.geometry = (RTCGeometry)geom;
-            //args.geomID = patch.geomID();
-            args.primID = patch.primID();
-            args.timeStep = patch.time();
-            args.u = &u[0];
-            args.v = &v[0];
-            args.Ng_x = &normal.x[0];
-            args.Ng_y = &normal.y[0];
-            args.Ng_z = &normal.z[0];
-            args.P_x = &vtx.x[0];
-            args.P_y = &vtx.y[0];
-            args.P_z = &vtx.z[0];
-            args.N = VSIZEX;
-            geom->displFunc(&args);
+            vfloatx::store(&grid_Ng_x[i*VSIZEX],normal.x);
+            vfloatx::store(&grid_Ng_y[i*VSIZEX],normal.y);
+            vfloatx::store(&grid_Ng_z[i*VSIZEX],normal.z);
           }
 
           vfloatx::store(&grid_x[i*VSIZEX],vtx.x);
           vfloatx::store(&grid_y[i*VSIZEX],vtx.y);
           vfloatx::store(&grid_z[i*VSIZEX],vtx.z);
         }
+
+        /* call displacement shader once for the entire grid */
+        if (unlikely(displ))
+        {
+          displaceGrid(patch,dwidth*dheight,grid_x,grid_y,grid_z,grid_u,grid_v,grid_Ng_x,grid_Ng_y,grid_Ng_z,geom);
+
+          /* set last elements in x,y,z array to last displaced point */
+          const float last_x = grid_x[dwidth*dheight-1];
+          const float last_y = grid_y[dwidth*dheight-1];
+          const float last_z = grid_z[dwidth*dheight-1];
+          for (unsigned i=dwidth*dheight;i<grid_size_simd_blocks*VSIZEX;i++) {
+            grid_x[i] = last_x;
+            grid_y[i] = last_y;
+            grid_z[i] = last_z;
+          }
+        }
       }
     }
 
@@ -236,7 +300,13 @@ namespace embree
         dynamic_large_stack_array(float,grid_Ng_y,displ ? M : 0,64*64*sizeof(float));
         dynamic_large_stack_array(float,grid_Ng_z,displ ? M : 0,64*64*sizeof(float));
 
-        if (geom->patch_eval_trees.size())
+        const GridStencil* stencil = displ ? nullptr : geom->getStencil(patch.primID(),patch.subPatch());
+        if (stencil && stencil->matches(swidth,sheight,patch.level))
+        {
+          evalGridStencil(*stencil,geom->getVertexBuffer(patch.time()),x0,x1,y0,y1,
+                          grid_x,grid_y,grid_z,grid_u,grid_v);
+        }
+        else if (geom->patch_eval_trees.size())
         {
           feature_adaptive_eval_grid<PatchEvalGrid> 
             (geom->patch_eval_trees[geom->numTimeSteps*patch.primID()+patch.time()], patch.subPatch(), patch.needsStitching() ? patch.level : nullptr,
@@ -260,22 +330,7 @@ namespace embree
         /* call displacement shader */
         if (unlikely(geom->displFunc))
         {
-          RTCDisplacementFunctionNArguments args;
-          args.geometryUserPtr = geom->userPtr;
-          args.geometry = (RTCGeometry)geom;
-          //args.geomID = patch.geomID();
-          args.primID = patch.primID();
-          args.timeStep = patch.time();
-          args.u = grid_u;
-          args.v = grid_v;
-          args.Ng_x = grid_Ng_x;
-          args.Ng_y = grid_Ng_y;
-          args.Ng_z = grid_Ng_z;
-          args.P_x = grid_x;
-          args.P_y = grid_y;
-          args.P_z = grid_z;
-          args.N = dwidth*dheight;
-          geom->displFunc(&args);
+          displaceGrid(patch,dwidth*dheight,grid_x,grid_y,grid_z,grid_u,grid_v,grid_Ng_x,grid_Ng_y,grid_Ng_z,geom);
         }
 
         /* set last elements in u,v array to 1.0f */
@@ -323,6 +378,33 @@ namespace embree
         //b.lower.a = 0;
         //b.upper.a = 0;
       }
+      else if (unlikely(geom->displFunc))
+      {
+        /* displaced grids are evaluated at once, such that the displacement shader gets called only once */
+        dynamic_large_stack_array(float,grid_x,M,64*64*sizeof(float));
+        dynamic_large_stack_array(float,grid_y,M,64*64*sizeof(float));
+        dynamic_large_stack_array(float,grid_z,M,64*64*sizeof(float));
+        evalGrid(patch,x0,x1,y0,y1,swidth,sheight,grid_x,grid_y,grid_z,grid_u,grid_v,geom);
+
+        vfloatx bounds_min_x = pos_inf, bounds_min_y = pos_inf, bounds_min_z = pos_inf;
+        vfloatx bounds_max_x = neg_inf, bounds_max_y = neg_inf, bounds_max_z = neg_inf;
+        for (unsigned i=0; i<grid_size_simd_blocks; i++)
+        {
+          const vfloatx x = vfloatx::load(&grid_x[i*VSIZEX]);
+          const vfloatx y = vfloatx::load(&grid_y[i*VSIZEX]);
+          const vfloatx z = vfloatx::load(&grid_z[i*VSIZEX]);
+          bounds_min_x = min(bounds_min_x,x); bounds_max_x = max(bounds_max_x,x);
+          bounds_min_y = min(bounds_min_y,y); bounds_max_y = max(bounds_max_y,y);
+          bounds_min_z = min(bounds_min_z,z); bounds_max_z = max(bounds_max_z,z);
+        }
+
+        b.lower.x = reduce_min(bounds_min_x);
+        b.lower.y = reduce_min(bounds_min_y);
+        b.lower.z = reduce_min(bounds_min_z);
+        b.upper.x = reduce_max(bounds_max_x);
+        b.upper.y = reduce_max(bounds_max_y);
+        b.upper.z = reduce_max(bounds_max_z);
+      }
       else
       {
         /* grid_u, grid_v need to be padded as we write with SIMD granularity */
@@ -355,29 +437,7 @@ namespace embree
         {
           const vfloatx u = vfloatx::load(&grid_u[i*VSIZEX]);
           const vfloatx v = vfloatx::load(&grid_v[i*VSIZEX]);
-          Vec3vfx vtx = patchEval(patch,u,v);
-        
-          /* evaluate displacement function */
-          if (unlikely(geom->displFunc != nullptr))
-          {
-            const Vec3vfx normal = normalize_safe(patchNormal(patch,u,v));
-            RTCDisplacementFunctionNArguments args;
-            args.geometryUserPtr = geom->userPtr;
-            args.geometry = (RTCGeometry)geom;
-            //args.geomID = patch.geomID();
-            args.primID = patch.primID();
-            args.timeStep = patch.time();
-            args.u = &u[0];
-            args.v = &v[0];
-            args.Ng_x = &normal.x[0];
-            args.Ng_y = &normal.y[0];
-            args.Ng_z = &normal.z[0];
-            args.P_x = &vtx.x[0];
-            args.P_y = &vtx.y[0];
-            args.P_z = &vtx.z[0];
-            args.N = VSIZEX;
-            geom->displFunc(&args);
-          }
+          const Vec3vfx vtx = patchEval(patch,u,v);
 
           bounds_min[0] = min(bounds_min[0],vtx.x);
           bounds_max[0] = max(bounds_max[0],vtx.x);
@@ -13,6 +13,7 @@
 #include "../../kernels/common/scene.h"
 #include <regex>
 #include <stack>
+#include <thread>
 
 #if defined(__APPLE__)
 #include "TargetConditionals.h"
@@ -869,6 +870,600 @@ namespace embree
     }
   };
 
+  struct PrepareSceneGeometryTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    bool modify;
+
+    PrepareSceneGeometryTest (std::string name, int isa, SceneFlags sflags, bool modify)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), modify(modify) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      VerifyScene scene0(device,sflags);
+      VerifyScene scene1(device,sflags);
+      AssertNoError(device);
+
+      /* the loader thread adds geometries while a second thread prepares the already added ones */
+      static const size_t numGeometries = 8;
+      std::vector<std::thread> threads;
+      for (size_t i=0; i<numGeometries; i++)
+      {
+        Ref<SceneGraph::Node> node = SceneGraph::createTriangleSphere(Vec3fa(3.0f*float(i),0.0f,0.0f),1.0f,20+int(i));
+        scene0.addGeometry(sflags.qflags,node);
+        const unsigned int geomID = scene1.addGeometry(sflags.qflags,node);
+        RTCScene hscene = scene1;
+        threads.push_back(std::thread([hscene,geomID] () { rtcPrepareSceneGeometry(hscene,geomID); }));
+      }
+      for (auto& thread : threads) thread.join();
+      AssertNoError(device);
+
+      /* modifying a geometry after preparing it invalidates its build primitives */
+      if (modify)
+      {
+        Ref<SceneGraph::TriangleMeshNode> mesh = scene1.nodes[0].dynamicCast<SceneGraph::TriangleMeshNode>();
+        for (auto& p : mesh->positions[0]) p.y += 1.0f;
+        RTCGeometry geom = rtcGetGeometry(scene1,0);
+        rtcUpdateGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,0);
+        rtcCommitGeometry(geom);
+        rtcCommitGeometry(rtcGetGeometry(scene0,0));
+        AssertNoError(device);
+      }
+
+      rtcCommitScene (scene0);
+      rtcCommitScene (scene1);
+      AssertNoError(device);
+
+      BBox3fa bounds0; rtcGetSceneBounds(scene0,(RTCBounds*)&bounds0);
+      BBox3fa bounds1; rtcGetSceneBounds(scene1,(RTCBounds*)&bounds1);
+      bool passed = bounds0 == bounds1;
+
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+      for (size_t i=0; i<256; i++)
+      {
+        const Vec3fa org(float(i%64)*3.0f*float(numGeometries)/64.0f-1.0f,float(i/64)*0.5f-0.75f,-5.0f);
+        RTCRayHit ray0 = makeRay(org,Vec3fa(0,0,1));
+        RTCRayHit ray1 = ray0;
+        rtcIntersect1(scene0,&context,&ray0);
+        rtcIntersect1(scene1,&context,&ray1);
+        passed &= ray0.hit.geomID == ray1.hit.geomID;
+        passed &= ray0.hit.primID == ray1.hit.primID;
+        passed &= ray0.ray.tfar == ray1.ray.tfar;
+      }
+      AssertNoError(device);
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct OutOfCoreBuildTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+
+    OutOfCoreBuildTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device0 = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device0));
+      RTCDeviceRef device1 = rtcNewDevice((cfg+",out_of_core_dir=\".\",out_of_core_threshold=0").c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device1));
+
+      /* large enough for the build primitive array to get stored in a file */
+      Ref<SceneGraph::Node> node = SceneGraph::createTriangleSphere(zero,1.0f,600);
+      VerifyScene scene0(device0,sflags);
+      VerifyScene scene1(device1,sflags);
+      scene0.addGeometry(sflags.qflags,node);
+      scene1.addGeometry(sflags.qflags,node);
+      rtcCommitScene (scene0);
+      AssertNoError(device0);
+      rtcCommitScene (scene1);
+      AssertNoError(device1);
+
+      bool passed = true;
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+      for (size_t i=0; i<256; i++)
+      {
+        const Vec3fa org(float(i%16)/8.0f-1.0f,float(i/16)/8.0f-1.0f,-5.0f);
+        RTCRayHit ray0 = makeRay(org,Vec3fa(0,0,1));
+        RTCRayHit ray1 = ray0;
+        rtcIntersect1(scene0,&context,&ray0);
+        rtcIntersect1(scene1,&context,&ray1);
+        passed &= ray0.hit.geomID == ray1.hit.geomID;
+        passed &= ray0.hit.primID == ray1.hit.primID;
+        passed &= ray0.ray.tfar == ray1.ray.tfar;
+      }
+      AssertNoError(device0);
+      AssertNoError(device1);
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct QuantizedVerticesTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+
+    QuantizedVerticesTest (std::string name, int isa, SceneFlags sflags, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      Ref<SceneGraph::TriangleMeshNode> mesh = SceneGraph::createTriangleSphere(zero,1.0f,50).dynamicCast<SceneGraph::TriangleMeshNode>();
+      const size_t numVertices = mesh->positions[0].size();
+      const RTCBounds qbounds = { -1.0f, -1.0f, -1.0f, 0.0f, 1.0f, 1.0f, 1.0f, 0.0f };
+      const Vec3fa qlower(-1.0f), qscale(2.0f/65535.0f);
+
+      /* quantize vertices and store the decoded positions for the reference mesh */
+      struct QVertex { unsigned short x,y,z,pad; };
+      avector<QVertex> qvertices(numVertices);
+      avector<Vec3fa> dvertices(numVertices);
+      for (size_t i=0; i<numVertices; i++)
+      {
+        const Vec3fa p = mesh->positions[0][i];
+        const Vec3fa q = min(max(floor((p-qlower)/qscale+Vec3fa(0.5f)),Vec3fa(0.0f)),Vec3fa(65535.0f));
+        qvertices[i] = { (unsigned short)q.x, (unsigned short)q.y, (unsigned short)q.z, 0 };
+        dvertices[i] = madd(q,qscale,qlower);
+      }
+
+      VerifyScene scene0(device,sflags);
+      VerifyScene scene1(device,sflags);
+      RTCGeometry geom0 = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_TRIANGLE);
+      rtcSetSharedGeometryBuffer(geom0,RTC_BUFFER_TYPE_INDEX,0,RTC_FORMAT_UINT3,mesh->triangles.data(),0,sizeof(SceneGraph::TriangleMeshNode::Triangle),mesh->triangles.size());
+      rtcSetSharedGeometryBuffer(geom0,RTC_BUFFER_TYPE_VERTEX,0,RTC_FORMAT_FLOAT3,dvertices.data(),0,sizeof(Vec3fa),numVertices);
+      rtcCommitGeometry(geom0);
+      rtcAttachGeometry(scene0,geom0);
+      rtcReleaseGeometry(geom0);
+      RTCGeometry geom1 = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_TRIANGLE);
+      rtcSetSharedGeometryBuffer(geom1,RTC_BUFFER_TYPE_INDEX,0,RTC_FORMAT_UINT3,mesh->triangles.data(),0,sizeof(SceneGraph::TriangleMeshNode::Triangle),mesh->triangles.size());
+      rtcSetSharedGeometryBuffer(geom1,RTC_BUFFER_TYPE_VERTEX,0,RTC_FORMAT_USHORT3,qvertices.data(),0,sizeof(QVertex),numVertices);
+      rtcSetGeometryVertexQuantizationBounds(geom1,&qbounds);
+      rtcCommitGeometry(geom1);
+      rtcAttachGeometry(scene1,geom1);
+      AssertNoError(device);
+      rtcCommitScene(scene0);
+      rtcCommitScene(scene1);
+      AssertNoError(device);
+
+      bool passed = true;
+      RTCRayHit rays0[256], rays1[256];
+      for (unsigned int i=0; i<256; i++) {
+        const Vec3fa org(float(i%16)/8.0f-0.97f,float(i/16)/8.0f-0.97f,-5.0f);
+        rays0[i] = rays1[i] = makeRay(org,Vec3fa(0,0,1));
+      }
+      IntersectWithMode(imode,ivariant,scene0,rays0,256);
+      IntersectWithMode(imode,ivariant,scene1,rays1,256);
+      for (unsigned int i=0; i<256; i++)
+      {
+        passed &= rays0[i].hit.geomID == rays1[i].hit.geomID;
+        passed &= abs(rays0[i].ray.tfar-rays1[i].ray.tfar) < 1E-4f || rays0[i].ray.tfar == rays1[i].ray.tfar;
+
+        /* hit positions get interpolated from decoded vertices */
+        if ((ivariant & VARIANT_INTERSECT) && rays1[i].hit.geomID != RTC_INVALID_GEOMETRY_ID)
+        {
+          Vec3fa P0, P1;
+          rtcInterpolate0(geom1,rays1[i].hit.primID,rays1[i].hit.u,rays1[i].hit.v,RTC_BUFFER_TYPE_VERTEX,0,(float*)&P0,3);
+          const SceneGraph::TriangleMeshNode::Triangle& tri = mesh->triangles[rays1[i].hit.primID];
+          const float u = rays1[i].hit.u, v = rays1[i].hit.v;
+          P1 = (1.0f-u-v)*dvertices[tri.v0] + u*dvertices[tri.v1] + v*dvertices[tri.v2];
+          passed &= reduce_max(abs(Vec3fa(P0.x,P0.y,P0.z)-Vec3fa(P1.x,P1.y,P1.z))) < 1E-4f;
+        }
+      }
+      rtcReleaseGeometry(geom1);
+      AssertNoError(device);
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  /* compares curve intersections of two device configurations that should produce nearly identical results */
+  struct CurveConfigTest : public VerifyApplication::IntersectTest
+  {
+    std::string cfg0, cfg1;
+    SceneGraph::CurveSubtype subtype;
+
+    CurveConfigTest (std::string name, int isa, std::string cfg0, std::string cfg1, SceneGraph::CurveSubtype subtype, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), cfg0(cfg0), cfg1(cfg1), subtype(subtype) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device0 = rtcNewDevice((cfg+","+cfg0).c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device0));
+      RTCDeviceRef device1 = rtcNewDevice((cfg+","+cfg1).c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device1));
+      if (!supportsIntersectMode(device0,imode))
+        return VerifyApplication::SKIPPED;
+
+      Ref<SceneGraph::Node> node = SceneGraph::createHairyPlane(17,Vec3fa(-1.0f,-1.0f,0.0f),Vec3fa(2.0f,0.0f,0.0f),Vec3fa(0.0f,2.0f,0.0f),0.2f,0.02f,500,subtype);
+      VerifyScene scene0(device0,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      VerifyScene scene1(device1,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      scene0.addGeometry(RTC_BUILD_QUALITY_MEDIUM,node);
+      scene1.addGeometry(RTC_BUILD_QUALITY_MEDIUM,node);
+      rtcCommitScene(scene0);
+      AssertNoError(device0);
+      rtcCommitScene(scene1);
+      AssertNoError(device1);
+
+      /* approximations differ slightly, thus some grazing hits may differ */
+      const size_t N = 256;
+      size_t numHits = 0, numMismatches = 0;
+      RTCRayHit rays0[N], rays1[N];
+      for (unsigned int i=0; i<N; i++) {
+        const Vec3fa org(float(i%16)/8.0f-0.97f,float(i/16)/8.0f-0.97f,5.0f);
+        rays0[i] = rays1[i] = makeRay(org,Vec3fa(0,0,-1));
+      }
+      IntersectWithMode(imode,ivariant,scene0,rays0,N);
+      IntersectWithMode(imode,ivariant,scene1,rays1,N);
+      for (unsigned int i=0; i<N; i++)
+      {
+        numHits += rays0[i].ray.tfar != float(inf);
+        const bool equal = rays0[i].hit.geomID == rays1[i].hit.geomID && (rays0[i].ray.tfar == rays1[i].ray.tfar || abs(rays0[i].ray.tfar-rays1[i].ray.tfar) < 1E-3f);
+        numMismatches += !equal;
+      }
+      AssertNoError(device0);
+      AssertNoError(device1);
+      return (VerifyApplication::TestReturnValue) (numHits > N/8 && numMismatches <= N/100);
+    }
+  };
+
+  /* compares grid intersections of two device configurations */
+  struct GridConfigTest : public VerifyApplication::IntersectTest
+  {
+    std::string cfg0, cfg1;
+    float eps;
+
+    GridConfigTest (std::string name, int isa, std::string cfg0, std::string cfg1, float eps, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), cfg0(cfg0), cfg1(cfg1), eps(eps) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device0 = rtcNewDevice((cfg+","+cfg0).c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device0));
+      RTCDeviceRef device1 = rtcNewDevice((cfg+","+cfg1).c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device1));
+      if (!supportsIntersectMode(device0,imode))
+        return VerifyApplication::SKIPPED;
+
+      /* the sphere grids have resolutions that do not split into 2x2 blocks of subgrids evenly */
+      Ref<SceneGraph::Node> plane = SceneGraph::createGridPlane(Vec3fa(-1.0f,-1.0f,-1.0f),Vec3fa(2.0f,0.0f,0.0f),Vec3fa(0.0f,2.0f,0.0f),33,33);
+      Ref<SceneGraph::Node> sphere = SceneGraph::convert_quads_to_grids(SceneGraph::createQuadSphere(Vec3fa(0.0f,0.0f,0.0f),0.8f,8),10,7);
+      VerifyScene scene0(device0,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      VerifyScene scene1(device1,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      scene0.addGeometry(RTC_BUILD_QUALITY_MEDIUM,plane);
+      scene1.addGeometry(RTC_BUILD_QUALITY_MEDIUM,plane);
+      scene0.addGeometry(RTC_BUILD_QUALITY_MEDIUM,sphere);
+      scene1.addGeometry(RTC_BUILD_QUALITY_MEDIUM,sphere);
+      rtcCommitScene(scene0);
+      AssertNoError(device0);
+      rtcCommitScene(scene1);
+      AssertNoError(device1);
+
+      const size_t N = 256;
+      size_t numHits = 0, numMismatches = 0;
+      RTCRayHit rays0[N], rays1[N];
+      for (unsigned int i=0; i<N; i++) {
+        const Vec3fa org(float(i%16)/8.0f-0.97f,float(i/16)/8.0f-0.97f,5.0f);
+        rays0[i] = rays1[i] = makeRay(org,Vec3fa(0,0,-1));
+      }
+      IntersectWithMode(imode,ivariant,scene0,rays0,N);
+      IntersectWithMode(imode,ivariant,scene1,rays1,N);
+      for (unsigned int i=0; i<N; i++)
+      {
+        numHits += rays0[i].ray.tfar != float(inf);
+        const bool equal = rays0[i].hit.geomID == rays1[i].hit.geomID && (rays0[i].ray.tfar == rays1[i].ray.tfar || abs(rays0[i].ray.tfar-rays1[i].ray.tfar) < eps);
+        numMismatches += !equal;
+      }
+      AssertNoError(device0);
+      AssertNoError(device1);
+      return (VerifyApplication::TestReturnValue) (numHits > N/2 && numMismatches <= N/100);
+    }
+  };
+
+  /* compares subdivision surfaces with complex faces tessellated with and without limit surface stencils */
+  struct SubdivStencilTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+
+    SubdivStencilTest (std::string name, int isa, SceneFlags sflags, IntersectMode imode)
+      : VerifyApplication::IntersectTest(name,isa,imode,VARIANT_INTERSECT,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    size_t compare(RTCScene scene0, RTCScene scene1, size_t& numHits)
+    {
+      const size_t N = 256;
+      size_t numMismatches = 0;
+      RTCRayHit rays0[N], rays1[N];
+      for (unsigned int i=0; i<N; i++) {
+        const Vec3fa org(float(i%16)/8.0f-0.97f,float(i/16)/8.0f-0.97f,5.0f);
+        rays0[i] = rays1[i] = makeRay(org,Vec3fa(0,0,-1));
+      }
+      IntersectWithMode(imode,ivariant,scene0,rays0,N);
+      IntersectWithMode(imode,ivariant,scene1,rays1,N);
+      for (unsigned int i=0; i<N; i++)
+      {
+        numHits += rays0[i].ray.tfar != float(inf);
+        const bool equal = rays0[i].hit.geomID == rays1[i].hit.geomID && (rays0[i].ray.tfar == rays1[i].ray.tfar || abs(rays0[i].ray.tfar-rays1[i].ray.tfar) < 1E-4f);
+        numMismatches += !equal;
+      }
+      return numMismatches;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device0 = rtcNewDevice((cfg+",subdiv_stencils=0").c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device0));
+      RTCDeviceRef device1 = rtcNewDevice((cfg+",subdiv_stencils=1").c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device1));
+      if (!supportsIntersectMode(device0,imode))
+        return VerifyApplication::SKIPPED;
+
+      /* all faces of the mesh are triangles, thus get evaluated adaptively */
+      Ref<SceneGraph::TriangleMeshNode> tmesh = SceneGraph::createTriangleSphere(Vec3fa(0.0f),1.0f,8).dynamicCast<SceneGraph::TriangleMeshNode>();
+      Ref<SceneGraph::SubdivMeshNode> mesh = new SceneGraph::SubdivMeshNode(nullptr,BBox1f(0,1),0);
+      mesh->positions.push_back(tmesh->positions[0]);
+      for (const auto& tri : tmesh->triangles) {
+        mesh->position_indices.push_back(tri.v0);
+        mesh->position_indices.push_back(tri.v1);
+        mesh->position_indices.push_back(tri.v2);
+        mesh->verticesPerFace.push_back(3);
+      }
+      mesh->tessellationRate = 6.0f;
+
+      VerifyScene scene0(device0,sflags);
+      VerifyScene scene1(device1,sflags);
+      const unsigned int geomID0 = scene0.addGeometry(sflags.qflags,mesh.dynamicCast<SceneGraph::Node>());
+      const unsigned int geomID1 = scene1.addGeometry(sflags.qflags,mesh.dynamicCast<SceneGraph::Node>());
+      rtcCommitScene(scene0);
+      AssertNoError(device0);
+      rtcCommitScene(scene1);
+      AssertNoError(device1);
+
+      size_t numHits = 0;
+      size_t numMismatches = compare(scene0,scene1,numHits);
+
+      /* animate the vertices, the stencils stay valid as the topology does not change */
+      for (size_t i=0; i<mesh->positions[0].size(); i++) {
+        Vec3fa& p = mesh->positions[0][i];
+        p = p*(1.0f+0.2f*sin(3.0f*p.x+2.0f*p.y))+Vec3fa(0.1f,0.0f,0.0f);
+      }
+      for (auto scene : { std::make_pair((RTCScene)scene0,geomID0), std::make_pair((RTCScene)scene1,geomID1) })
+      {
+        RTCGeometry geom = rtcGetGeometry(scene.first,scene.second);
+        rtcUpdateGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,0);
+        rtcCommitGeometry(geom);
+        rtcCommitScene(scene.first);
+      }
+      AssertNoError(device0);
+      AssertNoError(device1);
+      numMismatches += compare(scene0,scene1,numHits);
+
+      AssertNoError(device0);
+      AssertNoError(device1);
+      return (VerifyApplication::TestReturnValue) (numHits > 256 && numMismatches <= 4);
+    }
+  };
+
+  /* displaces along the normal and counts the invocations of the displacement function */
+  static void countingDisplacementFunction(const RTCDisplacementFunctionNArguments* args)
+  {
+    std::atomic<size_t>* counter = (std::atomic<size_t>*) args->geometryUserPtr;
+    (*counter)++;
+    for (unsigned int i=0; i<args->N; i++)
+    {
+      const float d = 0.1f*sinf(8.0f*args->P_x[i]+4.0f*args->P_y[i]);
+      args->P_x[i] += d*args->Ng_x[i];
+      args->P_y[i] += d*args->Ng_y[i];
+      args->P_z[i] += d*args->Ng_z[i];
+    }
+  }
+
+  /* compares displaced subdivision meshes built with and without batching of displacement function calls */
+  struct SubdivDisplacementBatchTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+
+    SubdivDisplacementBatchTest (std::string name, int isa, SceneFlags sflags, IntersectMode imode)
+      : VerifyApplication::IntersectTest(name,isa,imode,VARIANT_INTERSECT,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device0 = rtcNewDevice((cfg+",subdiv_displacement_batch=0").c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device0));
+      RTCDeviceRef device1 = rtcNewDevice((cfg+",subdiv_displacement_batch=4096").c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device1));
+      if (!supportsIntersectMode(device0,imode))
+        return VerifyApplication::SKIPPED;
+
+      /* triangle faces get evaluated adaptively */
+      Ref<SceneGraph::TriangleMeshNode> tmesh = SceneGraph::createTriangleSphere(Vec3fa(0.0f),1.0f,8).dynamicCast<SceneGraph::TriangleMeshNode>();
+      Ref<SceneGraph::SubdivMeshNode> sphere = new SceneGraph::SubdivMeshNode(nullptr,BBox1f(0,1),0);
+      sphere->positions.push_back(tmesh->positions[0]);
+      for (const auto& tri : tmesh->triangles) {
+        sphere->position_indices.push_back(tri.v0);
+        sphere->position_indices.push_back(tri.v1);
+        sphere->position_indices.push_back(tri.v2);
+        sphere->verticesPerFace.push_back(3);
+      }
+      sphere->tessellationRate = 16.0f;
+
+      /* quad faces of the plane get evaluated as patches */
+      Ref<SceneGraph::SubdivMeshNode> plane = new SceneGraph::SubdivMeshNode(nullptr,BBox1f(0,1),0);
+      plane->positions.push_back(avector<Vec3fa>());
+      for (unsigned int y=0; y<4; y++)
+        for (unsigned int x=0; x<4; x++)
+          plane->positions[0].push_back(Vec3fa(float(x)-1.5f,float(y)-1.5f,-2.0f));
+      for (unsigned int y=0; y<3; y++) {
+        for (unsigned int x=0; x<3; x++) {
+          plane->position_indices.push_back(4*(y+0)+x+0);
+          plane->position_indices.push_back(4*(y+0)+x+1);
+          plane->position_indices.push_back(4*(y+1)+x+1);
+          plane->position_indices.push_back(4*(y+1)+x+0);
+          plane->verticesPerFace.push_back(4);
+        }
+      }
+      plane->tessellationRate = 16.0f;
+
+      std::atomic<size_t> numCalls0(0), numCalls1(0);
+      VerifyScene scene0(device0,sflags);
+      VerifyScene scene1(device1,sflags);
+      for (auto scene : { std::make_pair(&scene0,&numCalls0), std::make_pair(&scene1,&numCalls1) })
+      {
+        for (auto mesh : { sphere, plane })
+        {
+          RTCGeometry geom = rtcGetGeometry(*scene.first,scene.first->addGeometry(sflags.qflags,mesh.dynamicCast<SceneGraph::Node>()));
+          rtcSetGeometryUserData(geom,scene.second);
+          rtcSetGeometryDisplacementFunction(geom,countingDisplacementFunction);
+          rtcCommitGeometry(geom);
+        }
+        rtcCommitScene(*scene.first);
+      }
+      AssertNoError(device0);
+      AssertNoError(device1);
+
+      const size_t N = 256;
+      size_t numHits = 0, numMismatches = 0;
+      RTCRayHit rays0[N], rays1[N];
+      for (unsigned int i=0; i<N; i++) {
+        const Vec3fa org(float(i%16)/5.0f-1.47f,float(i/16)/5.0f-1.47f,5.0f);
+        rays0[i] = rays1[i] = makeRay(org,Vec3fa(0,0,-1));
+      }
+      IntersectWithMode(imode,ivariant,scene0,rays0,N);
+      IntersectWithMode(imode,ivariant,scene1,rays1,N);
+      for (unsigned int i=0; i<N; i++)
+      {
+        numHits += rays0[i].ray.tfar != float(inf);
+        const bool equal = rays0[i].hit.geomID == rays1[i].hit.geomID && (rays0[i].ray.tfar == rays1[i].ray.tfar || abs(rays0[i].ray.tfar-rays1[i].ray.tfar) < 1E-4f);
+        numMismatches += !equal;
+      }
+
+      AssertNoError(device0);
+      AssertNoError(device1);
+      return (VerifyApplication::TestReturnValue) (numHits > 200 && numMismatches <= 4 && numCalls1 < numCalls0);
+    }
+  };
+
+  /* compares point intersections of the hair acceleration structure and the point acceleration structure */
+  struct PointAccelTest : public VerifyApplication::IntersectTest
+  {
+    std::string point_accel;
+    SceneGraph::PointSubtype subtype;
+    bool varyingRadius;
+
+    PointAccelTest (std::string name, int isa, std::string point_accel, SceneGraph::PointSubtype subtype, bool varyingRadius, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), point_accel(point_accel), subtype(subtype), varyingRadius(varyingRadius) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device0 = rtcNewDevice((cfg+",point_accel=none").c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device0));
+      RTCDeviceRef device1 = rtcNewDevice((cfg+",point_accel="+point_accel).c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device1));
+      if (!supportsIntersectMode(device0,imode))
+        return VerifyApplication::SKIPPED;
+
+      Ref<SceneGraph::Node> node = SceneGraph::createPointSphere(Vec3fa(0.0f),1.0f,0.05f,16,subtype);
+      if (varyingRadius) {
+        Ref<SceneGraph::PointSetNode> points = node.dynamicCast<SceneGraph::PointSetNode>();
+        for (size_t i=0; i<points->positions[0].size(); i++)
+          points->positions[0][i].w = 0.03f+0.01f*float(i%5);
+      }
+      /* small geometries are stored in a single leaf */
+      Ref<SceneGraph::Node> sphere = SceneGraph::createSphere(Vec3fa(0.9f,0.9f,1.5f),0.1f);
+
+      VerifyScene scene0(device0,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      VerifyScene scene1(device1,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      scene0.addGeometry(RTC_BUILD_QUALITY_MEDIUM,node);
+      scene1.addGeometry(RTC_BUILD_QUALITY_MEDIUM,node);
+      scene0.addGeometry(RTC_BUILD_QUALITY_MEDIUM,sphere);
+      scene1.addGeometry(RTC_BUILD_QUALITY_MEDIUM,sphere);
+      rtcCommitScene(scene0);
+      AssertNoError(device0);
+      rtcCommitScene(scene1);
+      AssertNoError(device1);
+
+      /* both structures use the same intersectors, only hits at equal distances may be reported differently */
+      const size_t N = 256;
+      size_t numHits = 0, numMismatches = 0;
+      RTCRayHit rays0[N], rays1[N];
+      for (unsigned int i=0; i<N; i++) {
+        const Vec3fa org(float(i%16)/8.0f-0.97f,float(i/16)/8.0f-0.97f,5.0f);
+        rays0[i] = rays1[i] = makeRay(org,Vec3fa(0,0,-1));
+      }
+      IntersectWithMode(imode,ivariant,scene0,rays0,N);
+      IntersectWithMode(imode,ivariant,scene1,rays1,N);
+      for (unsigned int i=0; i<N; i++)
+      {
+        numHits += rays0[i].ray.tfar != float(inf);
+        const bool equal = rays0[i].hit.geomID == rays1[i].hit.geomID && (rays0[i].ray.tfar == rays1[i].ray.tfar || abs(rays0[i].ray.tfar-rays1[i].ray.tfar) < 1E-5f);
+        numMismatches += !equal;
+      }
+      AssertNoError(device0);
+      AssertNoError(device1);
+      return (VerifyApplication::TestReturnValue) (numHits > N/8 && numMismatches <= N/100);
+    }
+  };
+
+  struct PacketCurveTest : public VerifyApplication::IntersectTest
+  {
+    SceneGraph::CurveSubtype subtype;
+
+    PacketCurveTest (std::string name, int isa, SceneGraph::CurveSubtype subtype, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), subtype(subtype) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      Ref<SceneGraph::Node> node = SceneGraph::createHairyPlane(23,Vec3fa(-1.0f,-1.0f,0.0f),Vec3fa(2.0f,0.0f,0.0f),Vec3fa(0.0f,2.0f,0.0f),0.2f,0.02f,500,subtype);
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,node);
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      RandomSampler sampler;
+      RandomSampler_init(sampler,23);
+
+      /* packets and streams have to find the same hits as single rays */
+      const size_t N = 256;
+      size_t numHits = 0;
+      RTCRayHit rays0[N], rays1[N];
+      for (unsigned int i=0; i<N; i++) {
+        const Vec3fa org(float(i%16)/8.0f-0.97f,float(i/16)/8.0f-0.97f,1.0f);
+        const Vec3fa dir(0.2f*RandomSampler_get1D(sampler)-0.1f,0.2f*RandomSampler_get1D(sampler)-0.1f,-1.0f);
+        rays0[i] = rays1[i] = makeRay(org,dir);
+      }
+      IntersectWithMode(MODE_INTERSECT1,ivariant,scene,rays0,N);
+      IntersectWithMode(imode,ivariant,scene,rays1,N);
+      for (unsigned int i=0; i<N; i++)
+      {
+        numHits += rays0[i].ray.tfar != float(inf);
+        if (rays0[i].hit.geomID != rays1[i].hit.geomID) return VerifyApplication::FAILED;
+        if (rays0[i].hit.primID != rays1[i].hit.primID) return VerifyApplication::FAILED;
+        if (rays0[i].ray.tfar != rays1[i].ray.tfar && abs(rays0[i].ray.tfar-rays1[i].ray.tfar) >= 1E-5f) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+      return (VerifyApplication::TestReturnValue) (numHits > N/8);
+    }
+  };
+
   struct GetUserDataTest : public VerifyApplication::Test
   {
     GetUserDataTest (std::string name, int isa)
@@ -2055,6 +2650,82 @@ namespace embree
     }
   };
 
+  /* compares subdivision surfaces that got incrementally updated with freshly created ones */
+  struct InterpolateSubdivUpdateTest : public VerifyApplication::Test
+  {
+    RTCSubdivisionMode mode;
+
+    InterpolateSubdivUpdateTest (std::string name, int isa, RTCSubdivisionMode mode)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), mode(mode) {}
+
+    RTCGeometry createSubdiv(const RTCDeviceRef& device, float* edge_crease_weights, float* vertex_crease_weights, RTCSubdivisionMode mode)
+    {
+      RTCGeometry geom = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_SUBDIVISION);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX,                0, RTC_FORMAT_UINT,  interpolation_quad_indices,          0, sizeof(unsigned int),   num_interpolation_quad_faces*4);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_FACE,                 0, RTC_FORMAT_UINT,  interpolation_quad_faces,            0, sizeof(unsigned int),   num_interpolation_quad_faces);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_EDGE_CREASE_INDEX,    0, RTC_FORMAT_UINT2, interpolation_edge_crease_indices,   0, 2*sizeof(unsigned int), 3);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_EDGE_CREASE_WEIGHT,   0, RTC_FORMAT_FLOAT, edge_crease_weights,                 0, sizeof(float),          3);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX_CREASE_INDEX,  0, RTC_FORMAT_UINT,  interpolation_vertex_crease_indices, 0, sizeof(unsigned int),   2);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX_CREASE_WEIGHT, 0, RTC_FORMAT_FLOAT, vertex_crease_weights,               0, sizeof(float),          2);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX,               0, RTC_FORMAT_FLOAT3, interpolation_vertices,             0, 3*sizeof(float),        num_interpolation_vertices);
+      rtcSetGeometrySubdivisionMode(geom,0,mode);
+      rtcCommitGeometry(geom);
+      return geom;
+    }
+
+    bool compare(RTCGeometry geom0, RTCGeometry geom1)
+    {
+      bool passed = true;
+      for (unsigned int primID=0; primID<num_interpolation_quad_faces; primID++)
+      {
+        for (float u=0.0f; u<=1.0f; u+=0.25f)
+        {
+          for (float v=0.0f; v<=1.0f; v+=0.25f)
+          {
+            float P0[3], P1[3];
+            rtcInterpolate0(geom0,primID,u,v,RTC_BUFFER_TYPE_VERTEX,0,P0,3);
+            rtcInterpolate0(geom1,primID,u,v,RTC_BUFFER_TYPE_VERTEX,0,P1,3);
+            for (size_t i=0; i<3; i++)
+              passed &= fabsf(P0[i]-P1[i]) < 1E-5f;
+          }
+        }
+      }
+      return passed;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      float edge_crease_weights[3] = { 0.0f, 0.0f, 0.0f };
+      float vertex_crease_weights[2] = { 0.0f, 0.0f };
+      float edge_crease_weights1[3] = { 2.0f, inf, 0.5f };
+      float vertex_crease_weights1[2] = { inf, 1.0f };
+      RTCGeometry geom0 = createSubdiv(device,edge_crease_weights,vertex_crease_weights,RTC_SUBDIVISION_MODE_PIN_ALL);
+      AssertNoError(device);
+
+      /* only change crease weights and subdivision mode, which does not require recalculating the topology */
+      for (size_t i=0; i<3; i++) edge_crease_weights[i] = edge_crease_weights1[i];
+      for (size_t i=0; i<2; i++) vertex_crease_weights[i] = vertex_crease_weights1[i];
+      rtcUpdateGeometryBuffer(geom0,RTC_BUFFER_TYPE_EDGE_CREASE_WEIGHT,0);
+      rtcUpdateGeometryBuffer(geom0,RTC_BUFFER_TYPE_VERTEX_CREASE_WEIGHT,0);
+      rtcSetGeometrySubdivisionMode(geom0,0,mode);
+      rtcCommitGeometry(geom0);
+      AssertNoError(device);
+
+      RTCGeometry geom1 = createSubdiv(device,edge_crease_weights1,vertex_crease_weights1,mode);
+      AssertNoError(device);
+
+      bool passed = compare(geom0,geom1);
+      rtcReleaseGeometry(geom0);
+      rtcReleaseGeometry(geom1);
+      AssertNoError(device);
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
   struct InterpolateTrianglesTest : public VerifyApplication::Test
   {
     size_t N;
@@ -2223,6 +2894,126 @@ namespace embree
     }
   };
   
+  struct InterpolateBatchTest : public VerifyApplication::Test
+  {
+    unsigned int N;
+    
+    InterpolateBatchTest (std::string name, int isa, unsigned int N)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), N(N) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      RTCSceneRef scene = rtcNewScene(device);
+      AssertNoError(device);
+
+      size_t M = num_interpolation_vertices*N+16; // padds the arrays with some valid data
+      std::vector<float> vertices0(M);
+      for (size_t i=0; i<M; i++) vertices0[i] = random_float();
+      std::vector<float> user_vertices0(M);
+      for (size_t i=0; i<M; i++) user_vertices0[i] = random_float();
+
+      /* one geometry of each type that supports interpolation of vertex attributes */
+      RTCGeometry geoms[4];
+      unsigned int numPrims[4];
+      geoms[0] = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_TRIANGLE);
+      rtcSetSharedGeometryBuffer(geoms[0], RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT3, interpolation_triangle_indices, 0, 3*sizeof(unsigned int), num_interpolation_triangle_faces);
+      numPrims[0] = num_interpolation_triangle_faces;
+
+      geoms[1] = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_QUAD);
+      rtcSetSharedGeometryBuffer(geoms[1], RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT4, interpolation_quad_indices, 0, 4*sizeof(unsigned int), num_interpolation_quad_faces);
+      numPrims[1] = num_interpolation_quad_faces;
+
+      geoms[2] = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_GRID);
+      interpolation_grids[0].startVertexID = 0;
+      interpolation_grids[0].stride = 4;
+      interpolation_grids[0].width = 4;
+      interpolation_grids[0].height = 4;
+      rtcSetSharedGeometryBuffer(geoms[2], RTC_BUFFER_TYPE_GRID, 0, RTC_FORMAT_GRID, interpolation_grids, 0, sizeof(RTCGrid), 1);
+      numPrims[2] = 1;
+
+      geoms[3] = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_SUBDIVISION);
+      rtcSetSharedGeometryBuffer(geoms[3], RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT, interpolation_quad_indices, 0, sizeof(unsigned int), num_interpolation_quad_faces*4);
+      rtcSetSharedGeometryBuffer(geoms[3], RTC_BUFFER_TYPE_FACE,  0, RTC_FORMAT_UINT, interpolation_quad_faces,   0, sizeof(unsigned int), num_interpolation_quad_faces);
+      numPrims[3] = num_interpolation_quad_faces;
+      AssertNoError(device);
+
+      for (size_t g=0; g<4; g++)
+      {
+        rtcSetGeometryVertexAttributeCount(geoms[g],1);
+        rtcSetSharedGeometryBuffer(geoms[g], RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, vertices0.data(), 0, N*sizeof(float), num_interpolation_vertices);
+        rtcSetSharedGeometryBuffer(geoms[g], RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE, 0, RTCFormat(RTC_FORMAT_FLOAT+N), user_vertices0.data(), 0, N*sizeof(float), num_interpolation_vertices);
+        rtcCommitGeometry(geoms[g]);
+        rtcAttachGeometryByID(scene,geoms[g],(unsigned int)g);
+        rtcReleaseGeometry(geoms[g]);
+        AssertNoError(device);
+      }
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      /* random hits of all geometries, some of them invalid */
+      const unsigned int K = 1000;
+      std::vector<int> valid(K);
+      std::vector<unsigned int> geomIDs(K), primIDs(K);
+      std::vector<float> u(K), v(K);
+      for (unsigned int i=0; i<K; i++)
+      {
+        valid[i] = (i%7) ? -1 : 0;
+        geomIDs[i] = (unsigned int)random_int() % 4;
+        primIDs[i] = (unsigned int)random_int() % numPrims[geomIDs[i]];
+        u[i] = random_float();
+        v[i] = random_float();
+        if (geomIDs[i] == 0 && u[i]+v[i] > 1.0f) { u[i] = 1.0f-u[i]; v[i] = 1.0f-v[i]; }
+      }
+
+      bool passed = true;
+      for (auto bufferType : { RTC_BUFFER_TYPE_VERTEX, RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE })
+      {
+        const unsigned int valueCount = bufferType == RTC_BUFFER_TYPE_VERTEX ? 3 : N;
+        std::vector<float> P(K*valueCount,-1.0f), dPdu(K*valueCount,-1.0f), dPdv(K*valueCount,-1.0f);
+        
+        RTCInterpolateBatchArguments args;
+        args.scene = scene;
+        args.valid = valid.data();
+        args.geomIDs = geomIDs.data();
+        args.primIDs = primIDs.data();
+        args.u = u.data();
+        args.v = v.data();
+        args.N = K;
+        args.bufferType = bufferType;
+        args.bufferSlot = 0;
+        args.P = P.data();
+        args.dPdu = dPdu.data();
+        args.dPdv = dPdv.data();
+        args.ddPdudu = nullptr;
+        args.ddPdvdv = nullptr;
+        args.ddPdudv = nullptr;
+        args.valueCount = valueCount;
+        rtcInterpolateBatch(&args);
+        AssertNoError(device);
+
+        for (unsigned int i=0; i<K; i++)
+        {
+          float P1[256], dPdu1[256], dPdv1[256];
+          for (size_t j=0; j<valueCount; j++) P1[j] = dPdu1[j] = dPdv1[j] = -1.0f;
+          if (valid[i]) {
+            RTCGeometry geom = rtcGetGeometry(scene,geomIDs[i]);
+            rtcInterpolate1(geom,primIDs[i],u[i],v[i],bufferType,0,P1,dPdu1,dPdv1,valueCount);
+          }
+          for (size_t j=0; j<valueCount; j++) {
+            passed &= fabsf(P1[j]-P[j*K+i]) < 1E-4f;
+            passed &= fabsf(dPdu1[j]-dPdu[j*K+i]) < 1E-3f;
+            passed &= fabsf(dPdv1[j]-dPdv[j*K+i]) < 1E-3f;
+          }
+        }
+      }
+
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
   const size_t num_interpolation_hair_vertices = 13;
   const size_t num_interpolation_hairs = 4;
 
@@ -2462,19 +3253,137 @@ namespace embree
       rtcCommitGeometry(geom);
       rtcAttachGeometry(scene,geom);
       rtcReleaseGeometry(geom);
-      rtcCommitScene (scene);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      float u[256], v[256];
+      RTCRayHit rays[256];
+      for (size_t i=0; i<256; i++)
+      {
+        u[i] = random_float(); 
+        v[i] = random_float();
+        if (u[i] < 0.001f || v[i] < 0.001f || u[i] > 0.999f || v[i] > 0.999f) { u[i] = 0.333f; v[i] = 0.333f; } // avoid hitting edges
+        Vec3fa from(0.0f,0.0f,-1.0f);
+        Vec3fa to = vertices[0] + u[i]*(vertices[1]-vertices[0]) + v[i]*(vertices[3]-vertices[0]);
+        rays[i] = makeRay(from,to-from);
+      }
+      IntersectWithMode(imode,ivariant,scene,rays,256);
+
+      for (size_t i=0; i<256; i++)
+      {
+        if (!(ivariant & VARIANT_INTERSECT))
+        {
+          if (rays[i].ray.tfar != float(neg_inf)) return VerifyApplication::FAILED;          
+          continue;
+        }
+        if (rays[i].hit.primID != 0) return VerifyApplication::FAILED;
+        if (abs(rays[i].hit.u - u[i]) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+        if (abs(rays[i].hit.v - v[i]) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+        if (abs(rays[i].ray.tfar - 1.0f) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+
+        const Vec3fa org(rays[i].ray.org_x,rays[i].ray.org_y,rays[i].ray.org_z);
+        const Vec3fa dir(rays[i].ray.dir_x,rays[i].ray.dir_y,rays[i].ray.dir_z);
+        const Vec3fa ht  = org + rays[i].ray.tfar*dir;
+        const Vec3fa huv = vertices[0] + rays[i].hit.u*(vertices[1]-vertices[0]) + rays[i].hit.v*(vertices[3]-vertices[0]);
+        if (reduce_max(abs(ht-huv)) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+        const Vec3fa Ng = Vec3fa(rays[i].hit.Ng_x,rays[i].hit.Ng_y,rays[i].hit.Ng_z);
+        if (reduce_max(abs(Ng - Vec3fa(0.0f,0.0f,1.0f))) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+      
+      return VerifyApplication::PASSED;
+    }
+  };
+  
+  struct NonUniformTimeStepsTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+    GeometryType gtype;
+
+    NonUniformTimeStepsTest (std::string name, int isa, SceneFlags sflags, GeometryType gtype, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), gtype(gtype) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      /* plane that moves fast in z at the beginning and slowly later */
+      const unsigned int numTimeSteps = 4;
+      const float times[numTimeSteps] = { 0.0f, 0.1f, 0.3f, 1.0f };
+      const float heights[numTimeSteps] = { 0.0f, 2.0f, -1.0f, 0.5f };
+      const unsigned int width = 17;
+
+      RTCSceneRef scene = rtcNewScene(device);
+      rtcSetSceneFlags(scene,sflags.sflags);
+      rtcSetSceneBuildQuality(scene,sflags.qflags);
+
+      RTCGeometry geom = nullptr;
+      switch (gtype) {
+      case TRIANGLE_MESH_MB: geom = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_TRIANGLE); break;
+      case QUAD_MESH_MB    : geom = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_QUAD); break;
+      case GRID_MESH_MB    : geom = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_GRID); break;
+      default              : return VerifyApplication::SKIPPED;
+      }
+      rtcSetGeometryTimeStepCount(geom,numTimeSteps);
+
+      /* times have to start at 0, end at 1, and have to increase */
+      const float invalid_times[numTimeSteps] = { 0.0f, 0.3f, 0.3f, 1.0f };
+      rtcSetGeometryTimeSteps(geom,invalid_times,numTimeSteps);
+      AssertError(device,RTC_ERROR_INVALID_ARGUMENT);
+      rtcSetGeometryTimeSteps(geom,times,numTimeSteps);
+
+      for (unsigned int t=0; t<numTimeSteps; t++) {
+        Vec3f* vertices = (Vec3f*) rtcSetNewGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,t,RTC_FORMAT_FLOAT3,sizeof(Vec3f),width*width);
+        for (unsigned int y=0; y<width; y++)
+          for (unsigned int x=0; x<width; x++)
+            vertices[y*width+x] = Vec3f(float(x)/float(width-1),float(y)/float(width-1),heights[t]);
+      }
+
+      const unsigned int cells = (width-1)*(width-1);
+      if (gtype == TRIANGLE_MESH_MB) {
+        Triangle* triangles = (Triangle*) rtcSetNewGeometryBuffer(geom,RTC_BUFFER_TYPE_INDEX,0,RTC_FORMAT_UINT3,sizeof(Triangle),2*cells);
+        for (unsigned int y=0; y<width-1; y++)
+          for (unsigned int x=0; x<width-1; x++) {
+            const unsigned int i = y*width+x;
+            triangles[2*(y*(width-1)+x)+0] = Triangle(i,i+1,i+width);
+            triangles[2*(y*(width-1)+x)+1] = Triangle(i+1,i+width+1,i+width);
+          }
+      }
+      else if (gtype == QUAD_MESH_MB) {
+        unsigned int* quads = (unsigned int*) rtcSetNewGeometryBuffer(geom,RTC_BUFFER_TYPE_INDEX,0,RTC_FORMAT_UINT4,4*sizeof(unsigned int),cells);
+        for (unsigned int y=0; y<width-1; y++)
+          for (unsigned int x=0; x<width-1; x++) {
+            const unsigned int i = y*width+x;
+            unsigned int* q = &quads[4*(y*(width-1)+x)];
+            q[0] = i; q[1] = i+1; q[2] = i+width+1; q[3] = i+width;
+          }
+      }
+      else {
+        RTCGrid* grid = (RTCGrid*) rtcSetNewGeometryBuffer(geom,RTC_BUFFER_TYPE_GRID,0,RTC_FORMAT_GRID,sizeof(RTCGrid),1);
+        grid->startVertexID = 0; grid->stride = width;
+        grid->width = width; grid->height = width;
+      }
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(scene,geom);
+      rtcReleaseGeometry(geom);
+      rtcCommitScene(scene);
       AssertNoError(device);
 
-      float u[256], v[256];
+      float height[256];
       RTCRayHit rays[256];
       for (size_t i=0; i<256; i++)
       {
-        u[i] = random_float(); 
-        v[i] = random_float();
-        if (u[i] < 0.001f || v[i] < 0.001f || u[i] > 0.999f || v[i] > 0.999f) { u[i] = 0.333f; v[i] = 0.333f; } // avoid hitting edges
-        Vec3fa from(0.0f,0.0f,-1.0f);
-        Vec3fa to = vertices[0] + u[i]*(vertices[1]-vertices[0]) + v[i]*(vertices[3]-vertices[0]);
-        rays[i] = makeRay(from,to-from);
+        const float time = i%16 == 0 ? times[(i/16)%numTimeSteps] : random_float();
+        size_t itime = 0; while (itime+2 < numTimeSteps && times[itime+1] <= time) itime++;
+        const float f = (time-times[itime])/(times[itime+1]-times[itime]);
+        height[i] = (1.0f-f)*heights[itime] + f*heights[itime+1];
+        const Vec3fa org(0.01f+0.98f*random_float(),0.01f+0.98f*random_float(),10.0f);
+        rays[i] = makeRay(org,Vec3fa(0.0f,0.0f,-1.0f));
+        rays[i].ray.time = time;
       }
       IntersectWithMode(imode,ivariant,scene,rays,256);
 
@@ -2482,28 +3391,18 @@ namespace embree
       {
         if (!(ivariant & VARIANT_INTERSECT))
         {
-          if (rays[i].ray.tfar != float(neg_inf)) return VerifyApplication::FAILED;          
+          if (rays[i].ray.tfar != float(neg_inf)) return VerifyApplication::FAILED;
           continue;
         }
-        if (rays[i].hit.primID != 0) return VerifyApplication::FAILED;
-        if (abs(rays[i].hit.u - u[i]) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
-        if (abs(rays[i].hit.v - v[i]) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
-        if (abs(rays[i].ray.tfar - 1.0f) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
-
-        const Vec3fa org(rays[i].ray.org_x,rays[i].ray.org_y,rays[i].ray.org_z);
-        const Vec3fa dir(rays[i].ray.dir_x,rays[i].ray.dir_y,rays[i].ray.dir_z);
-        const Vec3fa ht  = org + rays[i].ray.tfar*dir;
-        const Vec3fa huv = vertices[0] + rays[i].hit.u*(vertices[1]-vertices[0]) + rays[i].hit.v*(vertices[3]-vertices[0]);
-        if (reduce_max(abs(ht-huv)) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
-        const Vec3fa Ng = Vec3fa(rays[i].hit.Ng_x,rays[i].hit.Ng_y,rays[i].hit.Ng_z);
-        if (reduce_max(abs(Ng - Vec3fa(0.0f,0.0f,1.0f))) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+        if (rays[i].hit.geomID != 0) return VerifyApplication::FAILED;
+        if (abs(rays[i].ray.tfar - (10.0f-height[i])) > 1E-4f) return VerifyApplication::FAILED;
       }
       AssertNoError(device);
-      
+
       return VerifyApplication::PASSED;
     }
   };
-  
+
   struct RayMasksTest : public VerifyApplication::IntersectTest
   {
     SceneFlags sflags; 
@@ -2736,6 +3635,246 @@ namespace embree
     }
   };
 
+  struct MultiHitTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCMultiHitMode mode;
+
+    MultiHitTest (std::string name, int isa, SceneFlags sflags, RTCMultiHitMode mode)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), mode(mode) {}
+
+    static void rejectAllFilterN(const RTCFilterFunctionNArguments* const args)
+    {
+      for (unsigned int i=0; i<args->N; i++)
+        args->valid[i] = 0;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      const bool filter = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_FILTER_FUNCTION_SUPPORTED);
+
+      /* stack of planes at z=1,2,3,... of different geometry types, every 4th plane is instanced */
+      VerifyScene scene(device,sflags);
+      const unsigned int numPlanes = 20;
+      const Vec3fa dx(1,0,0), dy(0,1,0);
+      for (unsigned int i=0; i<numPlanes; i++)
+      {
+        const Vec3fa p0(0.0f,0.0f,float(i+1));
+        Ref<SceneGraph::Node> node;
+        switch (i%4) {
+        case 0: node = SceneGraph::createTrianglePlane(p0,dx,dy,4,4); break;
+        case 1: node = SceneGraph::createQuadPlane(p0,dx,dy,4,4); break;
+        case 2: node = SceneGraph::createGridPlane(p0,dx,dy,4,4); break;
+        case 3: node = new SceneGraph::TransformNode(AffineSpace3fa::translate(p0),SceneGraph::createQuadPlane(zero,dx,dy,4,4)); break;
+        }
+        scene.addGeometry(sflags.qflags,node);
+      }
+
+      /* filter function rejects all hits of plane 4 */
+      if (filter) {
+        rtcSetGeometryIntersectFilterFunction(rtcGetGeometry(scene,4),rejectAllFilterN);
+        rtcCommitGeometry(rtcGetGeometry(scene,4));
+      }
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      std::vector<unsigned int> planes;
+      for (unsigned int i=0; i<numPlanes; i++)
+        if (!filter || i != 4) planes.push_back(i);
+
+      const float tfar = mode == RTC_MULTI_HIT_MODE_ALL ? 12.5f : float(inf);
+      size_t numExpected = 0;
+      while (numExpected < planes.size() && float(planes[numExpected]+1) < tfar) numExpected++;
+
+      for (size_t i=0; i<64; i++)
+      {
+        RTCRayMultiHit rayhit;
+        const RTCRayHit rh = makeRay(Vec3fa(0.01f+0.98f*random_float(),0.01f+0.98f*random_float(),0.0f),Vec3fa(0,0,1),0.0f,tfar);
+        rayhit.ray = rh.ray;
+        rayhit.mode = mode;
+        rayhit.maxHitCount = 1+random_int()%RTC_MAX_HIT_COUNT;
+        RTCIntersectContext context;
+        rtcInitIntersectContext(&context);
+        rtcIntersectMultiHit1(scene,&context,&rayhit);
+        AssertNoError(device);
+
+        if (rayhit.hitCount != min(size_t(rayhit.maxHitCount),numExpected)) return VerifyApplication::FAILED;
+        if (mode == RTC_MULTI_HIT_MODE_ALL && rayhit.totalHitCount != numExpected) return VerifyApplication::FAILED;
+        if (rayhit.ray.tfar != tfar) return VerifyApplication::FAILED;
+        
+        for (unsigned int j=0; j<rayhit.hitCount; j++)
+        {
+          const unsigned int plane = planes[j];
+          const bool instanced = plane%4 == 3;
+          if (abs(rayhit.t[j]-float(plane+1)) > 16.0f*float(ulp)*float(plane+1)) return VerifyApplication::FAILED;
+          if (rayhit.hits[j].geomID != (instanced ? 0 : plane)) return VerifyApplication::FAILED;
+          if (rayhit.hits[j].instID[0] != (instanced ? plane : RTC_INVALID_GEOMETRY_ID)) return VerifyApplication::FAILED;
+        }
+      }
+
+      /* the number of hits to gather has to be in range */
+      RTCRayMultiHit rayhit;
+      rayhit.ray = makeRay(zero,Vec3fa(0,0,1)).ray;
+      rayhit.mode = mode;
+      rayhit.maxHitCount = RTC_MAX_HIT_COUNT+1;
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+      rtcIntersectMultiHit1(scene,&context,&rayhit);
+      AssertError(device,RTC_ERROR_INVALID_ARGUMENT);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct TraversalStatisticsTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+
+    TraversalStatisticsTest (std::string name, int isa, SceneFlags sflags, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    struct IntersectContext {
+      RTCIntersectContext context;
+      unsigned int numFilterCalls;
+    };
+
+    static void countFilterN(const RTCFilterFunctionNArguments* const args) {
+      ((IntersectContext*)args->context)->numFilterCalls++;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+      const bool filter = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_FILTER_FUNCTION_SUPPORTED);
+
+      /* triangle plane next to an instanced quad plane */
+      VerifyScene scene(device,sflags);
+      const Vec3fa dx(1,0,0), dy(0,1,0);
+      scene.addGeometry(sflags.qflags,SceneGraph::createTrianglePlane(Vec3fa(0,0,1),dx,dy,64,64));
+      scene.addGeometry(sflags.qflags,new SceneGraph::TransformNode(AffineSpace3fa::translate(Vec3fa(1,0,1)),SceneGraph::createQuadPlane(zero,dx,dy,64,64)));
+      if (filter) {
+        rtcSetGeometryIntersectFilterFunction(rtcGetGeometry(scene,0),countFilterN);
+        rtcSetGeometryOccludedFilterFunction(rtcGetGeometry(scene,0),countFilterN);
+        rtcCommitGeometry(rtcGetGeometry(scene,0));
+      }
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      /* statistics are disabled by default */
+      IntersectContext context;
+      rtcInitIntersectContext(&context.context);
+      if (context.context.stats != nullptr) return VerifyApplication::FAILED;
+
+      RTCTraversalStatistics stats;
+      memset(&stats,0,sizeof(stats));
+      context.context.stats = &stats;
+      context.numFilterCalls = 0;
+
+      const size_t N = 64;
+      RTCRayHit rays[N];
+      for (size_t i=0; i<N; i++)
+        rays[i] = makeRay(Vec3fa(0.01f+1.98f*random_float(),0.01f+0.98f*random_float(),0.0f),Vec3fa(0,0,1));
+      IntersectWithMode(imode,ivariant,scene,rays,N,&context.context);
+      AssertNoError(device);
+
+      if (stats.nodeCount == 0) return VerifyApplication::FAILED;
+      if (stats.leafCount == 0) return VerifyApplication::FAILED;
+      if (stats.primitiveCount < stats.leafCount) return VerifyApplication::FAILED;
+      if (stats.instanceCount == 0) return VerifyApplication::FAILED;
+      if (stats.filterCount != context.numFilterCalls) return VerifyApplication::FAILED;
+      if (filter && stats.filterCount == 0) return VerifyApplication::FAILED;
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct HighPrecisionInstanceTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+
+    HighPrecisionInstanceTest (std::string name, int isa, SceneFlags sflags, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      /* unit triangle that gets instanced far away from the origin */
+      RTCSceneRef object = rtcNewScene(device);
+      RTCGeometry geom = rtcNewGeometry(device,RTC_GEOMETRY_TYPE_TRIANGLE);
+      Vec3f* vertices = (Vec3f*) rtcSetNewGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,0,RTC_FORMAT_FLOAT3,sizeof(Vec3f),3);
+      vertices[0] = Vec3f(0.0f,0.0f,0.0f);
+      vertices[1] = Vec3f(1.0f,0.0f,0.0f);
+      vertices[2] = Vec3f(0.0f,1.0f,0.0f);
+      unsigned int* indices = (unsigned int*) rtcSetNewGeometryBuffer(geom,RTC_BUFFER_TYPE_INDEX,0,RTC_FORMAT_UINT3,3*sizeof(unsigned int),1);
+      indices[0] = 0; indices[1] = 1; indices[2] = 2;
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(object,geom);
+      rtcReleaseGeometry(geom);
+      rtcCommitScene(object);
+
+      /* the offset is not representable as float, rounding it would move the triangle by up to half a unit */
+      const double offset[3] = { 12345678.123, -2345678.456, 3456789.789 };
+      VerifyScene scene(device,sflags);
+      RTCGeometry inst = rtcNewGeometry(device,RTC_GEOMETRY_TYPE_INSTANCE);
+      rtcSetGeometryInstancedScene(inst,object);
+      rtcSetGeometryTransformOffset(inst,offset);
+      rtcCommitGeometry(inst);
+      rtcAttachGeometry(scene,inst);
+      rtcReleaseGeometry(inst);
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      /* all rays start one unit above the triangle, the origin is split into high and low-order part */
+      const double org[3] = { offset[0]+0.25, offset[1]+0.25, offset[2]+1.0 };
+      const Vec3fa org_hi((float)org[0],(float)org[1],(float)org[2]);
+      const float org_lo[3] = { (float)(org[0]-(double)org_hi.x), (float)(org[1]-(double)org_hi.y), (float)(org[2]-(double)org_hi.z) };
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+      if (context.orgLow != nullptr) return VerifyApplication::FAILED;
+      context.orgLow = org_lo;
+
+      const size_t N = 16;
+      RTCRayHit rays[N];
+      Vec2f uv[N];
+      for (size_t i=0; i<N; i++)
+      {
+        /* stay away from the diagonal edge of the triangle */
+        uv[i] = Vec2f(0.02f+0.96f*random_float(),0.02f+0.96f*random_float());
+        if (abs(uv[i].x+uv[i].y-1.0f) < 0.02f) uv[i].x *= 0.5f;
+        rays[i] = makeRay(org_hi,Vec3fa(uv[i].x-0.25f,uv[i].y-0.25f,-1.0f));
+      }
+      IntersectWithMode(imode,ivariant,scene,rays,N,&context);
+      AssertNoError(device);
+
+      for (size_t i=0; i<N; i++)
+      {
+        const bool expect_hit = uv[i].x+uv[i].y < 1.0f;
+        if (ivariant & VARIANT_INTERSECT)
+        {
+          if (expect_hit != (rays[i].hit.geomID != RTC_INVALID_GEOMETRY_ID)) return VerifyApplication::FAILED;
+          if (!expect_hit) continue;
+          if (abs(rays[i].ray.tfar-1.0f) > 1E-4f) return VerifyApplication::FAILED;
+          if (abs(rays[i].hit.u-uv[i].x) > 1E-4f) return VerifyApplication::FAILED;
+          if (abs(rays[i].hit.v-uv[i].y) > 1E-4f) return VerifyApplication::FAILED;
+        }
+        else if (expect_hit != (rays[i].ray.tfar < 0.0f))
+          return VerifyApplication::FAILED;
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
   struct InstancingTest : public VerifyApplication::IntersectTest
   {
     SceneFlags sflags;
@@ -2834,7 +3973,135 @@ namespace embree
       return (VerifyApplication::TestReturnValue) passed;
     }
   };
-    
+
+  struct LazyGeometryTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+    bool evict;
+
+    LazyGeometryTest (std::string name, int isa, SceneFlags sflags, bool evict, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), evict(evict) {}
+
+    struct LazyData
+    {
+      RTCDevice device;
+      float x;
+      std::atomic<size_t> numCreates;
+      std::atomic<size_t> numEvicts;
+    };
+
+    static void boundsFunc(const struct RTCBoundsFunctionArguments* args)
+    {
+      const LazyData* data = (const LazyData*) args->geometryUserPtr;
+      args->bounds_o->lower_x = data->x-1.0f;
+      args->bounds_o->lower_y = -1.0f;
+      args->bounds_o->lower_z = -0.1f;
+      args->bounds_o->upper_x = data->x+1.0f;
+      args->bounds_o->upper_y = +1.0f;
+      args->bounds_o->upper_z = +0.1f;
+    }
+
+    static void createFunc(const struct RTCLazyCreateFunctionArguments* args)
+    {
+      LazyData* data = (LazyData*) args->geometryUserPtr;
+      data->numCreates++;
+
+      RTCGeometry geom = rtcNewGeometry(data->device, RTC_GEOMETRY_TYPE_TRIANGLE);
+      Vec3f* vertices = (Vec3f*) rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, sizeof(Vec3f), 3);
+      Triangle* triangles = (Triangle*) rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT3, sizeof(Triangle), 1);
+      vertices[0] = Vec3f(data->x-1.0f, -1.0f, 0.0f);
+      vertices[1] = Vec3f(data->x+1.0f, -1.0f, 0.0f);
+      vertices[2] = Vec3f(data->x     , +1.0f, 0.0f);
+      triangles[0] = Triangle(0, 1, 2);
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(args->scene, geom);
+      rtcReleaseGeometry(geom);
+    }
+
+    static void evictFunc(const struct RTCLazyEvictFunctionArguments* args)
+    {
+      LazyData* data = (LazyData*) args->geometryUserPtr;
+      data->numEvicts++;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      if (evict) rtcSetDeviceProperty(device,RTC_DEVICE_PROPERTY_MEMORY_BUDGET,0);
+      AssertNoError(device);
+
+      static const size_t numLazy = 4;
+      std::unique_ptr<LazyData[]> data(new LazyData[numLazy]);
+      unsigned int geomIDs[numLazy];
+
+      VerifyScene scene(device, sflags);
+      for (size_t i=0; i<numLazy; i++)
+      {
+        data[i].device = device;
+        data[i].x = 4.0f*float(i);
+        data[i].numCreates = 0;
+        data[i].numEvicts = 0;
+
+        RTCGeometry geom = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_LAZY);
+        rtcSetGeometryUserData(geom,&data[i]);
+        rtcSetGeometryBoundsFunction(geom,boundsFunc,nullptr);
+        rtcSetGeometryLazyCreateFunction(geom,createFunc);
+        rtcSetGeometryLazyEvictFunction(geom,evictFunc);
+        rtcCommitGeometry(geom);
+        geomIDs[i] = rtcAttachGeometry(scene,geom);
+        rtcReleaseGeometry(geom);
+      }
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      /* nothing got created during the scene build */
+      bool passed = true;
+      for (size_t i=0; i<numLazy; i++)
+        passed &= data[i].numCreates == 0;
+
+      /* shoot the same rays twice to see whether geometries get created only once without a budget */
+      for (size_t iter=0; iter<2; iter++)
+      {
+        RTCRayHit rays[16];
+        for (unsigned int i=0; i<16; i++) {
+          rays[i] = makeRay(Vec3fa(4.0f*float(i%numLazy),-0.5f+0.05f*float(i/numLazy),-1.0f),Vec3fa(0,0,1));
+        }
+        IntersectWithMode(imode,ivariant,scene,rays,16);
+
+        for (unsigned int i=0; i<16; i++)
+        {
+          RTCRayHit& ray = rays[i];
+          if (ivariant & VARIANT_INTERSECT) {
+            passed &= ray.hit.geomID == 0;
+            passed &= ray.hit.instID[0] == geomIDs[i%numLazy];
+            passed &= abs(ray.ray.tfar-1.0f) < 1E-5f;
+          }
+          else
+            passed &= ray.ray.tfar == (float)neg_inf;
+        }
+      }
+
+      /* with a zero budget only the last created geometry stays resident */
+      size_t numResident = 0;
+      for (size_t i=0; i<numLazy; i++) {
+        if (evict) passed &= data[i].numCreates >= 1;
+        else       passed &= data[i].numCreates == 1;
+        numResident += data[i].numCreates - data[i].numEvicts;
+      }
+      if (evict) passed &= numResident == 1;
+      else       passed &= numResident == numLazy;
+      passed &= rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_MEMORY_USAGE) > 0;
+
+      AssertNoError(device);
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
   struct InactiveRaysTest : public VerifyApplication::IntersectTest
   {
     SceneFlags sflags;
@@ -4726,6 +5993,8 @@ namespace embree
       case TRIANGLE_MESH_MB: scene->addGeometry(quality,SceneGraph::createTriangleSphere(zero,one,numPhi)->set_motion_vector(random_motion_vector2(0.01f))); break;
       case QUAD_MESH:        scene->addGeometry(quality,SceneGraph::createQuadSphere(zero,one,numPhi)); break;
       case QUAD_MESH_MB:     scene->addGeometry(quality,SceneGraph::createQuadSphere(zero,one,numPhi)->set_motion_vector(random_motion_vector2(0.01f))); break;
+      case GRID_MESH:        scene->addGeometry(quality,SceneGraph::createGridSphere(zero,one,numPhi)); break;
+      case GRID_MESH_MB:     scene->addGeometry(quality,SceneGraph::createGridSphere(zero,one,numPhi)->set_motion_vector(random_motion_vector2(0.01f))); break;
       case SUBDIV_MESH:      scene->addGeometry(quality,SceneGraph::createSubdivSphere(zero,one,8,float(numPhi)/8.0f)); break;
       case SUBDIV_MESH_MB:   scene->addGeometry(quality,SceneGraph::createSubdivSphere(zero,one,8,float(numPhi)/8.0f)->set_motion_vector(random_motion_vector2(0.01f))); break;
       case SPHERE_GEOMETRY:  scene->addGeometry(quality,SceneGraph::createPointSphere(zero, one, float(one)/100.f, numPhi, SceneGraph::SPHERE)); break;
@@ -4904,6 +6173,8 @@ namespace embree
       case TRIANGLE_MESH_MB: scene->addGeometry(quality,SceneGraph::createTriangleSphere(zero,one,numPhi)->set_motion_vector(random_motion_vector2(0.01f))); break;
       case QUAD_MESH:        scene->addGeometry(quality,SceneGraph::createQuadSphere(zero,one,numPhi)); break;
       case QUAD_MESH_MB:     scene->addGeometry(quality,SceneGraph::createQuadSphere(zero,one,numPhi)->set_motion_vector(random_motion_vector2(0.01f))); break;
+      case GRID_MESH:        scene->addGeometry(quality,SceneGraph::createGridSphere(zero,one,numPhi)); break;
+      case GRID_MESH_MB:     scene->addGeometry(quality,SceneGraph::createGridSphere(zero,one,numPhi)->set_motion_vector(random_motion_vector2(0.01f))); break;
       case SUBDIV_MESH:      scene->addGeometry(quality,SceneGraph::createSubdivSphere(zero,one,8,float(numPhi)/8.0f)); break;
       case SUBDIV_MESH_MB:   scene->addGeometry(quality,SceneGraph::createSubdivSphere(zero,one,8,float(numPhi)/8.0f)->set_motion_vector(random_motion_vector2(0.01f))); break;
       case SPHERE_GEOMETRY:  scene->addGeometry(quality,SceneGraph::createPointSphere(zero, one, float(one)/100.f, numPhi, SceneGraph::SPHERE)); break;
@@ -5297,6 +6568,18 @@ namespace embree
       
       groups.top()->add(new GetUserDataTest("get_user_data",isa));
 
+      push(new TestGroup("prepare_scene_geometry",true,true));
+      for (auto sflags : sceneFlags) {
+        groups.top()->add(new PrepareSceneGeometryTest(to_string(sflags),isa,sflags,false));
+        groups.top()->add(new PrepareSceneGeometryTest("modify."+to_string(sflags),isa,sflags,true));
+      }
+      groups.pop();
+
+      push(new TestGroup("out_of_core_build",true,true));
+      for (auto sflags : sceneFlags)
+        groups.top()->add(new OutOfCoreBuildTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
       push(new TestGroup("buffer_stride",true,true));
       for (auto gtype : gtypes)
         groups.top()->add(new BufferStrideTest(to_string(gtype),isa,gtype));
@@ -5402,6 +6685,18 @@ namespace embree
       for (auto s : interpolateTests)
         groups.top()->add(new InterpolateSubdivTest(std::to_string((long long)(s)),isa,s));
       groups.pop();
+
+      push(new TestGroup("batch",true,true));
+      for (auto s : interpolateTests)
+        groups.top()->add(new InterpolateBatchTest(std::to_string((long long)(s)),isa,s));
+      groups.pop();
+
+      push(new TestGroup("subdiv_update",true,true));
+      groups.top()->add(new InterpolateSubdivUpdateTest("smooth_boundary",isa,RTC_SUBDIVISION_MODE_SMOOTH_BOUNDARY));
+      groups.top()->add(new InterpolateSubdivUpdateTest("pin_corners",isa,RTC_SUBDIVISION_MODE_PIN_CORNERS));
+      groups.top()->add(new InterpolateSubdivUpdateTest("pin_boundary",isa,RTC_SUBDIVISION_MODE_PIN_BOUNDARY));
+      groups.top()->add(new InterpolateSubdivUpdateTest("no_boundary",isa,RTC_SUBDIVISION_MODE_NO_BOUNDARY));
+      groups.pop();
         
       push(new TestGroup("hair",true,true));
       for (auto s : interpolateTests) 
@@ -5430,6 +6725,15 @@ namespace embree
                 groups.top()->add(new QuadHitTest(to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,imode,ivariant));
       groups.pop();
 
+      push(new TestGroup("non_uniform_time_steps",true,true));
+      for (auto gtype : { TRIANGLE_MESH_MB, QUAD_MESH_MB, GRID_MESH_MB })
+        for (auto sflags : sceneFlags)
+          for (auto imode : intersectModes)
+            for (auto ivariant : intersectVariants)
+              if (has_variant(imode,ivariant))
+                groups.top()->add(new NonUniformTimeStepsTest(to_string(gtype)+"."+to_string(sflags,imode,ivariant),isa,sflags,gtype,imode,ivariant));
+      groups.pop();
+
       if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_RAY_MASK_SUPPORTED)) 
       {
         push(new TestGroup("ray_masks",true,true));
@@ -5471,6 +6775,28 @@ namespace embree
       }
       groups.pop();
 
+      push(new TestGroup("multi_hit",true,true));
+        for (auto sflags : sceneFlags)
+          for (auto mode : { RTC_MULTI_HIT_MODE_CLOSEST, RTC_MULTI_HIT_MODE_ALL })
+            groups.top()->add(new MultiHitTest(std::string(mode == RTC_MULTI_HIT_MODE_CLOSEST ? "closest." : "all.")+to_string(sflags),isa,sflags,mode));
+      groups.pop();
+
+      push(new TestGroup("traversal_statistics",true,true));
+        for (auto sflags : sceneFlags)
+          for (auto imode : intersectModes)
+            for (auto ivariant : intersectVariants)
+              if (has_variant(imode,ivariant))
+                groups.top()->add(new TraversalStatisticsTest(to_string(sflags,imode,ivariant),isa,sflags,imode,ivariant));
+      groups.pop();
+
+      push(new TestGroup("high_precision_instancing",true,true));
+        for (auto sflags : sceneFlags)
+          for (auto imode : intersectModes)
+            for (auto ivariant : intersectVariants)
+              if (has_variant(imode,ivariant))
+                groups.top()->add(new HighPrecisionInstanceTest(to_string(sflags,imode,ivariant),isa,sflags,imode,ivariant));
+      groups.pop();
+
       push(new TestGroup("instancing",true,true));
         for (auto sflags : sceneFlags) 
           for (auto imode : intersectModes) 
@@ -5483,7 +6809,83 @@ namespace embree
               if (has_variant(imode,ivariant)) 
                 groups.top()->add(new InstancingTest("instancing."+to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,true,imode,ivariant));
       groups.pop();
-      
+
+      push(new TestGroup("quantized_vertices",true,true));
+        for (auto sflags : sceneFlags)
+          for (auto imode : intersectModes)
+            for (auto ivariant : intersectVariants)
+              if (has_variant(imode,ivariant))
+                groups.top()->add(new QuantizedVerticesTest(to_string(sflags,imode,ivariant),isa,sflags,imode,ivariant));
+      groups.pop();
+
+      push(new TestGroup("compressed_curves",true,true));
+        for (auto subtype : { SceneGraph::ROUND_CURVE, SceneGraph::FLAT_CURVE })
+          for (auto imode : intersectModes)
+            for (auto ivariant : intersectVariants)
+              if (has_variant(imode,ivariant))
+                groups.top()->add(new CurveConfigTest(std::string(subtype == SceneGraph::ROUND_CURVE ? "round." : "flat.")+to_string(imode,ivariant),isa,
+                                                      "hair_accel=bvh4obb.virtualcurve4v","hair_accel=bvh4obb.virtualcurve4c",subtype,imode,ivariant));
+      groups.pop();
+
+      push(new TestGroup("adaptive_curve_subdivision",true,true));
+        for (auto subtype : { SceneGraph::ROUND_CURVE, SceneGraph::FLAT_CURVE })
+          for (auto imode : intersectModes)
+            for (auto ivariant : intersectVariants)
+              if (has_variant(imode,ivariant))
+                groups.top()->add(new CurveConfigTest(std::string(subtype == SceneGraph::ROUND_CURVE ? "round." : "flat.")+to_string(imode,ivariant),isa,
+                                                      "hair_adaptive_subdivision=0","hair_adaptive_subdivision=1",subtype,imode,ivariant));
+      groups.pop();
+
+      push(new TestGroup("grid_config",true,true));
+        for (auto imode : intersectModes)
+          for (auto ivariant : intersectVariants)
+            if (has_variant(imode,ivariant)) {
+              groups.top()->add(new GridConfigTest("adaptive_subgrids."+to_string(imode,ivariant),isa,"grid_adaptive_subgrids=0","grid_adaptive_subgrids=1",1E-5f,imode,ivariant));
+              groups.top()->add(new GridConfigTest("compressed_vertices."+to_string(imode,ivariant),isa,"grid_compressed_vertices=0","grid_compressed_vertices=1",1E-3f,imode,ivariant));
+            }
+      groups.pop();
+
+      push(new TestGroup("subdiv_stencils",true,true));
+        for (auto sflags : { SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM), SceneFlags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_LOW) })
+          for (auto imode : intersectModes)
+            groups.top()->add(new SubdivStencilTest(to_string(sflags,imode),isa,sflags,imode));
+      groups.pop();
+
+      push(new TestGroup("subdiv_displacement_batch",true,true));
+        for (auto sflags : { SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM), SceneFlags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_LOW) })
+          for (auto imode : intersectModes)
+            groups.top()->add(new SubdivDisplacementBatchTest(to_string(sflags,imode),isa,sflags,imode));
+      groups.pop();
+
+      push(new TestGroup("point_accel",true,true));
+        for (auto point_accel : { "bvh4.point4v", "bvh4.point8v" })
+          for (auto subtype : { SceneGraph::SPHERE, SceneGraph::DISC, SceneGraph::ORIENTED_DISC })
+            for (auto varyingRadius : { false, true })
+              for (auto imode : intersectModes)
+                for (auto ivariant : intersectVariants)
+                  if (has_variant(imode,ivariant) && (std::string(point_accel) != "bvh4.point8v" || (isa & AVX) == AVX))
+                    groups.top()->add(new PointAccelTest(std::string(point_accel)+"."+(subtype == SceneGraph::SPHERE ? "sphere." : subtype == SceneGraph::DISC ? "disc." : "oriented_disc.")+(varyingRadius ? "varying_radius." : "shared_radius.")+to_string(imode,ivariant),
+                                                         isa,point_accel,subtype,varyingRadius,imode,ivariant));
+      groups.pop();
+
+      push(new TestGroup("packet_curves",true,true));
+        for (auto subtype : { SceneGraph::ROUND_CURVE, SceneGraph::FLAT_CURVE })
+          for (auto imode : intersectModes)
+            for (auto ivariant : intersectVariants)
+              if (imode != MODE_INTERSECT1 && has_variant(imode,ivariant))
+                groups.top()->add(new PacketCurveTest(std::string(subtype == SceneGraph::ROUND_CURVE ? "round." : "flat.")+to_string(imode,ivariant),isa,subtype,imode,ivariant));
+      groups.pop();
+
+      push(new TestGroup("lazy_geometry",true,true));
+        for (auto sflags : sceneFlags)
+          for (auto imode : intersectModes)
+            for (auto ivariant : intersectVariants)
+              if (has_variant(imode,ivariant)) {
+                groups.top()->add(new LazyGeometryTest("lazy."+to_string(sflags,imode,ivariant),isa,sflags,false,imode,ivariant));
+                groups.top()->add(new LazyGeometryTest("lazy_evict."+to_string(sflags,imode,ivariant),isa,sflags,true,imode,ivariant));
+              }
+      groups.pop();
+
       push(new TestGroup("inactive_rays",true,true));
       for (auto sflags : sceneFlags) 
         for (auto imode : intersectModes) 
@@ -5680,6 +7082,8 @@ namespace embree
         TRIANGLE_MESH_MB, 
         QUAD_MESH, 
         QUAD_MESH_MB, 
+        GRID_MESH, 
+        GRID_MESH_MB, 
         SUBDIV_MESH, 
         //SUBDIV_MESH_MB  // FIXME: not supported yet
         SPHERE_GEOMETRY,